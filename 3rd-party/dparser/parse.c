@@ -228,40 +228,55 @@ static ZNode *new_ZNode(Parser *p, PNode *pn) {
   return z;
 }
 
+/* The nodes that become unreferenced are freed using an explicit stack instead of recursively, such that
+   deep parse trees (e.g. long sequences of left associative operators) do not overflow the call stack. */
+#define unref_later(_n, _stack)                    \
+  do {                                             \
+    if (!--(_n)->refcount) stack_push(_stack, _n); \
+  } while (0)
+
 static void free_PNode(Parser *p, PNode *pn) {
   PNode *amb;
   uint i;
-  if (p->user.free_node_fn) p->user.free_node_fn(&pn->parse_node);
-  for (i = 0; i < pn->children.n; i++) unref_pn(p, pn->children.v[i]);
-  vec_free(&pn->children);
-  if ((amb = pn->ambiguities)) {
-    pn->ambiguities = NULL;
-    unref_pn(p, amb);
-  }
-  if (pn->latest != pn) unref_pn(p, pn->latest);
+  StackPNode unreferenced;
+  stack_clear(&unreferenced);
+  stack_push(&unreferenced, pn);
+  while (!is_stack_empty(&unreferenced)) {
+    pn = stack_pop(&unreferenced);
+    if (p->user.free_node_fn) p->user.free_node_fn(&pn->parse_node);
+    for (i = 0; i < pn->children.n; i++) unref_later(pn->children.v[i], &unreferenced);
+    vec_free(&pn->children);
+    if ((amb = pn->ambiguities)) {
+      pn->ambiguities = NULL;
+      unref_later(amb, &unreferenced);
+    }
+    if (pn->latest != pn) unref_later(pn->latest, &unreferenced);
 #ifdef USE_FREELISTS
-  pn->all_next = p->free_pnodes;
-  p->free_pnodes = pn;
+    pn->all_next = p->free_pnodes;
+    p->free_pnodes = pn;
 #else
-  FREE(pn);
+    FREE(pn);
 #endif
 #ifdef TRACK_PNODES
-  if (pn->xprev)
-    pn->xprev->xnext = pn->xnext;
-  else
-    p->xall = pn->xnext;
-  if (pn->xnext) pn->xnext->xprev = pn->xprev;
-  pn->xprev = NULL;
-  pn->xnext = NULL;
+    if (pn->xprev)
+      pn->xprev->xnext = pn->xnext;
+    else
+      p->xall = pn->xnext;
+    if (pn->xnext) pn->xnext->xprev = pn->xprev;
+    pn->xprev = NULL;
+    pn->xnext = NULL;
 #endif
+  }
+  stack_free(&unreferenced);
 }
 
 #ifndef USE_GC
-static void free_ZNode(Parser *p, ZNode *z, SNode *s) {
+/* Frees z and pushes the SNodes that become unreferenced on the given stack. */
+static void free_ZNode_later(Parser *p, ZNode *z, SNode *s, StackSNode *unreferenced) {
   uint i;
   unref_pn(p, z->pn);
   for (i = 0; i < z->sns.n; i++)
-    if (s != z->sns.v[i]) unref_sn(p, z->sns.v[i]);
+    if (s != z->sns.v[i]) unref_later(z->sns.v[i], unreferenced);
   vec_free(&z->sns);
 #ifdef USE_FREELISTS
   znode_next(z) = p->free_znodes;
@@ -271,18 +286,40 @@ static void free_ZNode(Parser *p, ZNode *z, SNode *s) {
 #endif
 }
 
-static void free_SNode(Parser *p, struct SNode *s) {
+/* Frees s and the chain of SNodes that become unreferenced, which is as long as the parse stack, without
+   recursion. */
+static void free_SNodes(Parser *p, StackSNode *unreferenced) {
   uint i;
-  for (i = 0; i < s->zns.n; i++)
-    if (s->zns.v[i]) free_ZNode(p, s->zns.v[i], s);
-  vec_free(&s->zns);
-  if (s->last_pn) unref_pn(p, s->last_pn);
+  SNode *s;
+  while (!is_stack_empty(unreferenced)) {
+    s = stack_pop(unreferenced);
+    for (i = 0; i < s->zns.n; i++)
+      if (s->zns.v[i]) free_ZNode_later(p, s->zns.v[i], s, unreferenced);
+    vec_free(&s->zns);
+    if (s->last_pn) unref_pn(p, s->last_pn);
 #ifdef USE_FREELISTS
-  s->all_next = p->free_snodes;
-  p->free_snodes = s;
+    s->all_next = p->free_snodes;
+    p->free_snodes = s;
 #else
-  FREE(s);
+    FREE(s);
 #endif
+  }
+}
+
+static void free_ZNode(Parser *p, ZNode *z, SNode *s) {
+  StackSNode unreferenced;
+  stack_clear(&unreferenced);
+  free_ZNode_later(p, z, s, &unreferenced);
+  free_SNodes(p, &unreferenced);
+  stack_free(&unreferenced);
+}
+
+static void free_SNode(Parser *p, struct SNode *s) {
+  StackSNode unreferenced;
+  stack_clear(&unreferenced);
+  stack_push(&unreferenced, s);
+  free_SNodes(p, &unreferenced);
+  stack_free(&unreferenced);
 }
 #else
 #define free_ZNode(_p, _z, _s)
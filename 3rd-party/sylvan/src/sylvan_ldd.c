@@ -1537,6 +1537,27 @@ TASK_IMPL_4(MDD, lddmc_relprev, MDD, set, MDD, rel, MDD, meta, MDD, uni)
     return result;
 }
 
+/**
+ * Calculate the union of lddmc_relprev(set, rels[i], metas[i], uni) for 0 <= i < count.
+ * The relations are split in halves recursively, such that the predecessor computations
+ * for different relations are executed as parallel tasks.
+ */
+TASK_IMPL_5(MDD, lddmc_relprev_union_groups, MDD, set, const MDD*, rels, const MDD*, metas, MDD, uni, size_t, count)
+{
+    if (count == 0) return lddmc_false;
+    if (count == 1) return CALL(lddmc_relprev, set, rels[0], metas[0], uni);
+
+    size_t half = count / 2;
+    lddmc_refs_spawn(SPAWN(lddmc_relprev_union_groups, set, rels, metas, uni, half));
+    MDD right = CALL(lddmc_relprev_union_groups, set, rels + half, metas + half, uni, count - half);
+    lddmc_refs_push(right);
+    MDD left = lddmc_refs_sync(SYNC(lddmc_relprev_union_groups));
+    lddmc_refs_push(left);
+    MDD result = CALL(lddmc_union, left, right);
+    lddmc_refs_pop(2);
+    return result;
+}
+
 // Same 'proj' as project. So: proj: -2 (end; quantify rest), -1 (end; keep rest), 0 (quantify), 1 (keep)
 TASK_IMPL_4(MDD, lddmc_join, MDD, a, MDD, b, MDD, a_proj, MDD, b_proj)
 {
@@ -2098,6 +2119,24 @@ VOID_TASK_IMPL_5(lddmc_sat_all_par, MDD, mdd, lddmc_enum_cb, cb, void*, context,
     SYNC(lddmc_sat_all_par);
 }
 
+/**
+ * Calls lddmc_sat_all_par(mdds[i], cb, contexts[i]) for 0 <= i < count. The sets are split
+ * in halves recursively, such that the enumerations of different sets run as parallel tasks.
+ */
+VOID_TASK_IMPL_4(lddmc_sat_all_par_groups, const MDD*, mdds, lddmc_enum_cb, cb, void**, contexts, size_t, count)
+{
+    if (count == 0) return;
+    if (count == 1) {
+        CALL(lddmc_sat_all_par, mdds[0], cb, contexts[0], NULL, 0);
+        return;
+    }
+
+    size_t half = count / 2;
+    SPAWN(lddmc_sat_all_par_groups, mdds, cb, contexts, half);
+    CALL(lddmc_sat_all_par_groups, mdds + half, cb, contexts + half, count - half);
+    SYNC(lddmc_sat_all_par_groups);
+}
+
 struct lddmc_match_sat_info
 {
     MDD mdd;
@@ -139,6 +139,13 @@ TASK_DECL_4(MDD, lddmc_relprod_union, MDD, MDD, MDD, MDD);
 TASK_DECL_4(MDD, lddmc_relprev, MDD, MDD, MDD, MDD);
 #define lddmc_relprev(a, rel, proj, uni) CALL(lddmc_relprev, a, rel, proj, uni)
 
+/**
+ * Calculate the union of lddmc_relprev(a, rels[i], projs[i], uni) for 0 <= i < count,
+ * where the predecessors for the individual relations are computed in parallel.
+ */
+TASK_DECL_5(MDD, lddmc_relprev_union_groups, MDD, const MDD*, const MDD*, MDD, size_t);
+#define lddmc_relprev_union_groups(a, rels, projs, uni, count) CALL(lddmc_relprev_union_groups, a, rels, projs, uni, count)
+
 // so: proj: -2 (end; quantify rest), -1 (end; keep rest), 0 (quantify), 1 (keep)
 TASK_DECL_2(MDD, lddmc_project, MDD, MDD);
 #define lddmc_project(mdd, proj) CALL(lddmc_project, mdd, proj)
@@ -191,6 +198,13 @@ LACE_TYPEDEF_CB(MDD, lddmc_collect_cb, uint32_t*, size_t, void*);
 VOID_TASK_DECL_5(lddmc_sat_all_par, MDD, lddmc_enum_cb, void*, uint32_t*, size_t);
 #define lddmc_sat_all_par(mdd, cb, context) CALL(lddmc_sat_all_par, mdd, cb, context, 0, 0)
 
+/**
+ * Calls lddmc_sat_all_par(mdds[i], cb, contexts[i]) for 0 <= i < count, where the
+ * enumerations of the different sets are executed as parallel tasks.
+ */
+VOID_TASK_DECL_4(lddmc_sat_all_par_groups, const MDD*, lddmc_enum_cb, void**, size_t);
+#define lddmc_sat_all_par_groups(mdds, cb, contexts, count) CALL(lddmc_sat_all_par_groups, mdds, cb, contexts, count)
+
 VOID_TASK_DECL_3(lddmc_sat_all_nopar, MDD, lddmc_enum_cb, void*);
 #define lddmc_sat_all_nopar(mdd, cb, context) CALL(lddmc_sat_all_nopar, mdd, cb, context)
 
@@ -420,6 +420,22 @@ inline ldd relprev(const ldd& A, const ldd& B, const ldd& meta, const ldd& U)
   return ldd(lddmc_relprev(A.get(), B.get(), meta.get(), U.get()));
 }
 
+// relprev_union(A,B,meta,U) = the union of relprev(A,B[i],meta[i],U) for all i, where the predecessors for the
+// individual transition relations are computed by parallel Lace tasks
+inline ldd relprev_union(const ldd& A, const std::vector<ldd>& B, const std::vector<ldd>& meta, const ldd& U)
+{
+  assert(B.size() == meta.size());
+  LACE_ME;
+  std::vector<MDD> B_(B.size());
+  std::vector<MDD> meta_(meta.size());
+  for (std::size_t i = 0; i < B.size(); i++)
+  {
+    B_[i] = B[i].get();
+    meta_[i] = meta[i].get();
+  }
+  return ldd(lddmc_relprev_union_groups(A.get(), B_.data(), meta_.data(), U.get(), B_.size()));
+}
+
 // satcount(A) = the size of the set A
 inline double satcount(const ldd& A)
 {
@@ -474,6 +490,22 @@ void sat_all_nopar(const ldd& A, lddmc_enum_cb cb, void* context = nullptr)
   lddmc_sat_all_nopar(A.get(), cb, context);
 }
 
+// sat_all(A,cb,contexts) calls sat_all(A[i],cb,contexts[i]) for all i, where the sets A[i] are enumerated by
+// parallel Lace tasks
+inline
+void sat_all(const std::vector<ldd>& A, lddmc_enum_cb cb, const std::vector<void*>& contexts)
+{
+  assert(A.size() == contexts.size());
+  LACE_ME;
+  std::vector<MDD> A_(A.size());
+  for (std::size_t i = 0; i < A.size(); i++)
+  {
+    A_[i] = A[i].get();
+  }
+  std::vector<void*> contexts_ = contexts;
+  lddmc_sat_all_par_groups(A_.data(), cb, contexts_.data(), A_.size());
+}
+
 // collect(A,cb) = sat_all_par(A,cb), but the callback cb returns some set encoded as an LDD, and all returned LDDs are combined using union
 // TODO: this is probably wrong, because there are two more undocumented parameters
 inline ldd collect(const ldd& A, lddmc_collect_cb cb, void* context = nullptr)
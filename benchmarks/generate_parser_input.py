@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+
+#~ Copyright: see the accompanying file COPYING or copy at
+#~ https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+#~ Distributed under the Boost Software License, Version 1.0.
+#~ (See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+
+# Generates large, machine-generated looking specifications to benchmark the parsers.
+# Example: generate_parser_input.py --kind lps --size 10000 large.mcrl2
+#
+# An LPS specification (input for txt2lps) contains size summands, and a PBES (input for txt2pbes) contains size
+# equations. Both contain a data specification with size / 10 mappings and equations. A size of 10000 results in
+# an input of one to three megabytes.
+
+import argparse
+import random
+
+def data_specification(size, out):
+    out.write('sort Message = struct m_0 | m_1 | m_2 | m_3 | m_4;\n')
+    out.write('     Buffer = List(Message);\n\n')
+    out.write('map  ' + '\n     '.join('f_{}: Nat # Bool # Buffer -> Nat;'.format(i) for i in range(size)) + '\n\n')
+    out.write('var  n, m: Nat;\n     b: Bool;\n     q: Buffer;\n')
+    equations = []
+    for i in range(size):
+        equations.append('b && n > {0} -> f_{1}(n, b, q) = if(#q < {0}, n + {0}, max(n, {2}) div 2);'.format(i % 97, i, i % 5))
+        equations.append('!b -> f_{0}(n, b, q) = f_{1}(n div 2, !b, m_{2} |> q);'.format(i, (i + 1) % size, i % 5))
+    out.write('eqn  ' + '\n     '.join(equations) + '\n\n')
+
+def lps_specification(size, out, generator):
+    data_specification(max(1, size // 10), out)
+    out.write('act  send, receive: Message # Nat;\n     tau_step;\n     error: Nat # Bool;\n\n')
+    out.write('proc P(state: Nat, counter: Nat, flag: Bool, buffer: Buffer) =\n       ')
+    for i in range(size):
+        if i > 0:
+            out.write('\n     + ')
+        kind = generator.randrange(4)
+        if kind == 0:
+            out.write('sum d: Message. (state == {0} && #buffer < {1}) -> send(d, counter) . '
+                      'P(state = {2}, buffer = d |> buffer, counter = counter + 1)'.format(i, 3 + i % 5, generator.randrange(size)))
+        elif kind == 1:
+            out.write('(state == {0} && buffer != []) -> receive(head(buffer), counter) . '
+                      'P(state = {1}, buffer = tail(buffer))'.format(i, generator.randrange(size)))
+        elif kind == 2:
+            out.write('(state == {0} && flag && counter mod {1} == {2}) -> tau_step . '
+                      'P(state = {3}, flag = !flag, counter = Int2Nat(counter - {2}))'.format(i, 2 + i % 7, i % 2, generator.randrange(size)))
+        else:
+            out.write('sum k: Nat. (state == {0} && k < {1} && (forall j: Nat. j < k => j <= counter)) -> error(k, flag) . '
+                      'P(state = {2}, counter = f_{3}(k, flag, buffer))'.format(i, 2 + i % 3, generator.randrange(size), i % max(1, size // 10)))
+    out.write(';\n\ninit P(0, 0, true, []);\n')
+
+def pbes_specification(size, out, generator):
+    data_specification(max(1, size // 10), out)
+    out.write('pbes ')
+    for i in range(size):
+        fixpoint = 'nu' if (i // 100) % 2 == 0 else 'mu'
+        j = generator.randrange(size)
+        k = generator.randrange(size)
+        out.write('{0} X_{1}(n: Nat, b: Bool, q: Buffer) =\n       '.format(fixpoint, i))
+        out.write('(val(n < {0} && b) => X_{1}(n + 1, !b, m_{2} |> q)) && '
+                  '(forall m: Nat. val(m < {0}) => X_{3}(f_{4}(m, b, q), b, q)) || '
+                  '(exists d: Message. val(#q > {5} && d in q) && X_{1}(Int2Nat(n - 1), b, tail(q)));\n     '
+                  .format(3 + i % 11, j, i % 5, k, i % max(1, size // 10), i % 3))
+    out.write('\ninit X_0(0, true, []);\n')
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates large specifications to benchmark the parsers.')
+    parser.add_argument('--kind', choices=['lps', 'pbes'], default='lps', help='the kind of specification')
+    parser.add_argument('--size', type=int, default=10000, help='the number of summands or equations')
+    parser.add_argument('--seed', type=int, default=0, help='seed of the random generator')
+    parser.add_argument('output', help='the file to which the specification is written')
+    args = parser.parse_args()
+
+    generator = random.Random(args.seed)
+    with open(args.output, 'w') as out:
+        if args.kind == 'lps':
+            lps_specification(args.size, out, generator)
+        else:
+            pbes_specification(args.size, out, generator)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+
+#~ Copyright: see the accompanying file COPYING or copy at
+#~ https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+#~ Distributed under the Boost Software License, Version 1.0.
+#~ (See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+
+# Runs a benchmark command and reports its running time and peak memory usage.
+# Example: measure.py --name abp --report results.csv -- mcrl22lps abp.mcrl2 abp.lps
+
+import argparse
+import os
+import resource
+import subprocess
+import sys
+import time
+
+def peak_memory_in_kib(usage):
+    # The maximum resident set size is reported in bytes on macOS and in kilobytes elsewhere.
+    if sys.platform == 'darwin':
+        return usage.ru_maxrss // 1024
+    return usage.ru_maxrss
+
+def main():
+    parser = argparse.ArgumentParser(description='Runs a command and reports its running time and peak memory usage.')
+    parser.add_argument('--name', default=None, help='name of the benchmark, defaults to the command')
+    parser.add_argument('--report', default=None, help='append the measurements to this CSV file')
+    parser.add_argument('command', nargs=argparse.REMAINDER, help='the command to measure, preceded by --')
+    args = parser.parse_args()
+
+    command = args.command[1:] if args.command and args.command[0] == '--' else args.command
+    if not command:
+        parser.error('no command given')
+    name = args.name if args.name else ' '.join(command)
+
+    start = time.perf_counter()
+    returncode = subprocess.call(command)
+    elapsed = time.perf_counter() - start
+    usage = resource.getrusage(resource.RUSAGE_CHILDREN)
+    peak = peak_memory_in_kib(usage)
+
+    print('{}: {:.3f}s elapsed, {:.3f}s user, {:.3f}s system, {:.1f} MiB peak memory{}'.format(
+          name, elapsed, usage.ru_utime, usage.ru_stime, peak / 1024.0,
+          '' if returncode == 0 else ', failed with exit code {}'.format(returncode)))
+
+    if args.report:
+        write_header = not os.path.exists(args.report)
+        with open(args.report, 'a') as report:
+            if write_header:
+                report.write('name,elapsed,user,system,peak_kib,exit_code\n')
+            report.write('{},{:.3f},{:.3f},{:.3f},{},{}\n'.format(
+                         name, elapsed, usage.ru_utime, usage.ru_stime, peak, returncode))
+
+    return returncode
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+
+#~ Copyright: see the accompanying file COPYING or copy at
+#~ https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+#~ Distributed under the Boost Software License, Version 1.0.
+#~ (See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+
+# Runs the benchmark matrix of benchmark_matrix.json a number of times, records the running time, peak memory usage
+# and counters of every benchmark in a JSON file, and optionally compares the results with a baseline.
+# Example: run_benchmarks.py --source ~/mcrl2 --bin build/stage/bin --workspace /tmp/bench --output results.json
+#          run_benchmarks.py ... --baseline baseline.json --tolerance 0.1
+
+import argparse
+import datetime
+import itertools
+import json
+import os
+import platform
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+def peak_memory_in_kib(usage):
+    # The maximum resident set size is reported in bytes on macOS and in kilobytes elsewhere.
+    if sys.platform == 'darwin':
+        return usage.ru_maxrss // 1024
+    return usage.ru_maxrss
+
+def run_once(command, timeout):
+    """Runs the command and returns its exit code, elapsed time, peak memory usage and standard error."""
+    with tempfile.TemporaryFile() as stderr:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=stderr)
+        deadline = None if timeout is None else start + timeout
+        while True:
+            pid, status, usage = os.wait4(process.pid, os.WNOHANG)
+            if pid != 0:
+                break
+            if deadline is not None and time.perf_counter() > deadline:
+                process.kill()
+                pid, status, usage = os.wait4(process.pid, 0)
+                break
+            time.sleep(0.01)
+        elapsed = time.perf_counter() - start
+        process.returncode = os.waitstatus_to_exitcode(status) if hasattr(os, 'waitstatus_to_exitcode') else status >> 8
+        stderr.seek(0)
+        output = stderr.read().decode('utf-8', errors='replace')
+    return process.returncode, elapsed, peak_memory_in_kib(usage), output
+
+# Matches the counter section of the summary printed by --trace, and the 'time: <seconds>' lines of the
+# microbenchmarks.
+COUNTER_LINE = re.compile(r'^(?P<name>\S.*?)\s+(?P<value>\d+)$')
+TIME_LINE = re.compile(r'^(?P<name>.*?)\s*time: (?P<value>[0-9.eE+-]+)$')
+
+def parse_counters(output):
+    """Returns the counters reported in the output of a tool that was run with --trace, or of a microbenchmark."""
+    counters = {}
+    in_counters = False
+    for line in output.splitlines():
+        line = line.rstrip()
+        match = TIME_LINE.match(line)
+        if match:
+            name = match.group('name').strip()
+            counters[(name + ' ' if name else '') + 'time'] = float(match.group('value'))
+            continue
+        if line.startswith('counter ') and line.endswith(' total'):
+            in_counters = True
+            continue
+        if in_counters:
+            match = COUNTER_LINE.match(line)
+            if match:
+                counters[match.group('name').strip()] = int(match.group('value'))
+            else:
+                in_counters = False
+    return counters
+
+def expand_matrix(matrix):
+    """Returns the benchmarks of the matrix, as (name, tool or executable, input, arguments) tuples."""
+    result = []
+    specifications = matrix.get('specifications', {})
+    for benchmark in matrix.get('benchmarks', []):
+        parameters = benchmark.get('matrix', {})
+        keys = sorted(parameters.keys())
+        for spec in specifications:
+            for values in itertools.product(*[parameters[key] for key in keys]):
+                substitution = dict(zip(keys, values), spec=spec)
+                result.append((benchmark['name'].format(**substitution),
+                               benchmark['tool'],
+                               (spec, benchmark['input']),
+                               [argument.format(**substitution) for argument in benchmark.get('arguments', [])]))
+    for benchmark in matrix.get('microbenchmarks', []):
+        result.append((benchmark['name'], benchmark['executable'], None, benchmark.get('arguments', [])))
+    return result
+
+def executable(bin_directory, name):
+    path = os.path.join(bin_directory, name)
+    if sys.platform == 'win32':
+        path += '.exe'
+    return path if os.path.exists(path) else None
+
+def prepare_input(args, matrix, spec, kind):
+    """Generates the LPS, LTS or PBES of the given specification in the workspace, unless it already exists."""
+    lps = os.path.join(args.workspace, spec + '.lps')
+    files = { 'lps': lps, 'lts': os.path.join(args.workspace, spec + '.lts'),
+              'pbes': os.path.join(args.workspace, spec + '.nodeadlock.pbes') }
+    commands = {
+        'lps': ['mcrl22lps', os.path.join(args.source, matrix['specifications'][spec]), lps],
+        'lts': ['lps2lts', '-rjittyc', lps, files['lts']],
+        'pbes': ['lps2pbes', '-f', os.path.join(args.source, 'examples', 'modal-formulas', 'nodeadlock.mcf'), lps, files['pbes']],
+    }
+
+    if kind != 'lps' and not prepare_input(args, matrix, spec, 'lps'):
+        return None
+    if not os.path.exists(files[kind]):
+        tool = executable(args.bin, commands[kind][0])
+        if tool is None or subprocess.call([tool] + commands[kind][1:]) != 0:
+            print('failed to generate {}'.format(files[kind]))
+            return None
+    return files[kind]
+
+def run_benchmarks(args, matrix):
+    results = {}
+    pattern = re.compile(args.filter) if args.filter else None
+    for name, program, source, arguments in expand_matrix(matrix):
+        if pattern and not pattern.search(name):
+            continue
+
+        path = executable(args.bin, program)
+        if path is None:
+            print('{}: skipped, {} was not built'.format(name, program))
+            continue
+
+        command = [path] + arguments
+        if source is not None:
+            input_file = prepare_input(args, matrix, *source)
+            if input_file is None:
+                print('{}: skipped, the input could not be generated'.format(name))
+                continue
+            command.append(input_file)
+            if args.counters:
+                command.append('--trace')
+
+        runs = []
+        counters = {}
+        for _ in range(args.repeat):
+            returncode, elapsed, peak, output = run_once(command, args.timeout)
+            runs.append({ 'wall': round(elapsed, 4), 'peak_kib': peak, 'exit_code': returncode })
+            counters = parse_counters(output)
+            if returncode != 0:
+                break
+
+        result = {
+            'command': [program] + command[1:],
+            'runs': runs,
+            'exit_code': runs[-1]['exit_code'],
+            'wall_median': round(statistics.median(run['wall'] for run in runs), 4),
+            'wall_min': min(run['wall'] for run in runs),
+            'peak_kib': max(run['peak_kib'] for run in runs),
+            'counters': counters,
+        }
+        results[name] = result
+        print('{}: {:.3f}s median wall time, {:.1f} MiB peak memory{}'.format(
+              name, result['wall_median'], result['peak_kib'] / 1024.0,
+              '' if result['exit_code'] == 0 else ', failed with exit code {}'.format(result['exit_code'])))
+    return results
+
+def compare(results, baseline, tolerance, minimum_time):
+    """Prints the differences with the baseline and returns the names of the benchmarks that regressed."""
+    regressions = []
+    print('\n{:<50} {:>12} {:>12} {:>8} {:>12} {:>12} {:>8}'.format(
+          'benchmark', 'base wall', 'wall', 'ratio', 'base MiB', 'MiB', 'ratio'))
+    for name in sorted(results):
+        if name not in baseline:
+            continue
+        old, new = baseline[name], results[name]
+        wall_ratio = new['wall_median'] / old['wall_median'] if old['wall_median'] > 0 else 1.0
+        peak_ratio = new['peak_kib'] / old['peak_kib'] if old['peak_kib'] > 0 else 1.0
+
+        # Very short runs are dominated by noise, so their running time must also differ by an absolute amount.
+        slower = wall_ratio > 1 + tolerance and new['wall_median'] - old['wall_median'] > minimum_time
+        larger = peak_ratio > 1 + tolerance
+        failed = new['exit_code'] != 0 and old['exit_code'] == 0
+        marker = ''
+        if slower or larger or failed:
+            regressions.append(name)
+            marker = '  <-- ' + ', '.join(reason for reason, flag in
+                                          (('slower', slower), ('more memory', larger), ('failed', failed)) if flag)
+        print('{:<50} {:>12.3f} {:>12.3f} {:>8.2f} {:>12.1f} {:>12.1f} {:>8.2f}{}'.format(
+              name, old['wall_median'], new['wall_median'], wall_ratio,
+              old['peak_kib'] / 1024.0, new['peak_kib'] / 1024.0, peak_ratio, marker))
+
+    missing = sorted(set(baseline) - set(results))
+    if missing:
+        print('\nNot measured, but part of the baseline: {}'.format(', '.join(missing)))
+    return regressions
+
+def main():
+    directory = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description='Runs the benchmark matrix and compares the results with a baseline.')
+    parser.add_argument('--matrix', default=os.path.join(directory, 'benchmark_matrix.json'), help='the benchmark matrix')
+    parser.add_argument('--source', default=os.path.dirname(directory), help='the root of the mCRL2 source tree')
+    parser.add_argument('--bin', required=True, help='the directory that contains the tools and benchmark executables')
+    parser.add_argument('--workspace', required=True, help='the directory in which the inputs are generated')
+    parser.add_argument('--output', default=None, help='write the results to this JSON file')
+    parser.add_argument('--repeat', type=int, default=3, help='the number of runs of every benchmark (default 3)')
+    parser.add_argument('--timeout', type=float, default=None, help='the maximum time in seconds of a single run')
+    parser.add_argument('--filter', default=None, help='only run the benchmarks of which the name matches this regular expression')
+    parser.add_argument('--counters', action='store_true', help='run the tools with --trace and record their counters')
+    parser.add_argument('--baseline', default=None, help='compare the results with this JSON file of an earlier run')
+    parser.add_argument('--tolerance', type=float, default=0.1,
+                        help='the fraction by which the median wall time or peak memory may exceed the baseline (default 0.1)')
+    parser.add_argument('--minimum-time', type=float, default=0.05,
+                        help='the minimal increase in seconds of the median wall time to count as a regression (default 0.05)')
+    args = parser.parse_args()
+
+    if args.repeat < 1:
+        parser.error('--repeat must be at least 1')
+
+    with open(args.matrix) as f:
+        matrix = json.load(f)
+    os.makedirs(args.workspace, exist_ok=True)
+
+    results = run_benchmarks(args, matrix)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({
+                'date': datetime.datetime.now().isoformat(timespec='seconds'),
+                'host': platform.node(),
+                'platform': platform.platform(),
+                'repeat': args.repeat,
+                'results': results,
+            }, f, indent=2, sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)['results']
+        regressions = compare(results, baseline, args.tolerance, args.minimum_time)
+        if regressions:
+            print('\n{} benchmark(s) regressed by more than {:.0f}%: {}'.format(
+                  len(regressions), args.tolerance * 100, ', '.join(regressions)))
+            return 1
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -48,6 +48,14 @@ if(MCRL2_ENABLE_MULTITHREADING)
   add_definitions(-DMCRL2_THREAD_SAFE)
 endif()
 
+if(MCRL2_ENABLE_OPEN_ADDRESSING)
+  add_definitions(-DMCRL2_ATERMPP_OPEN_ADDRESSING)
+endif()
+
+if(MCRL2_ENABLE_BLOCK_ALLOCATOR)
+  add_definitions(-DMCRL2_ATERMPP_BLOCK_ALLOCATOR)
+endif()
+
 # Enable C++17 for all targets.
 set(CMAKE_CXX_STANDARD 17)
 set(CMAKE_CXX_STANDARD_REQUIRED true)
@@ -15,6 +15,8 @@
 #include "mcrl2/utilities/bitstream.h"
 #include "mcrl2/utilities/indexed_set.h"
 
+#include <sstream>
+
 namespace atermpp
 {
 
@@ -30,11 +32,25 @@ namespace atermpp
 ///          The start of the stream is a zero followed by a header and a version and a term with function symbol index zero
 ///          indicates the end of the stream.
 ///
+///          When a window size is set the writer starts a new window before writing a term whenever the number of shared
+///          terms reaches this size. A window boundary is an output term with function symbol index zero, after which
+///          the terms of the previous window are no longer referenced. As such the reader only needs to keep the terms of
+///          the current window in memory.
+///
+///          When written to a std::ostream the terms are divided into chunks that can be decoded independently. Every
+///          chunk is preceded by its number of output terms and the function symbols that are used for the first time
+///          in it, such that all chunks share one function symbol table. Each chunk has its own term table and ends
+///          when this table reaches the window size or when its encoding exceeds a few megabytes. A chunk without output
+///          terms marks the end of the stream.
+///
 class binary_aterm_ostream final : public aterm_ostream
 {
 public:
-  /// \brief Provide the output stream to which the terms are written.
+  /// \brief Provide the output stream to which the terms are written in chunks.
   binary_aterm_ostream(std::ostream& os);
+
+  /// \brief Provide the bitstream to which the terms are written, without chunks such that other data can be written
+  ///        to the same bitstream in between.
   binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream);
 
   ~binary_aterm_ostream() override;
@@ -43,10 +59,24 @@ public:
   ///        written itself is not shared whenever it occurs as the argument of another term.
   void put(const aterm &term) override;
 
+  /// \brief Bounds the number of shared terms that a reader has to keep, where zero (the default) means unbounded.
+  /// \details Subterms that are written again after a window boundary are repeated in the stream. For chunked
+  ///          streams this is the number of shared terms in a chunk, which is 2^20 by default.
+  void set_window_size(std::size_t number_of_terms);
+
 private:
   /// \brief Write a function symbol to the output stream.
   std::size_t write_function_symbol(const function_symbol& symbol);
 
+  /// \brief Writes the index of a function symbol that was returned by write_function_symbol.
+  void write_function_symbol_index(std::size_t index);
+
+  /// \brief Starts a new chunk when the current one is large enough, or when the transformer has changed.
+  void start_chunk();
+
+  /// \brief Writes the current chunk, preceded by its header, to the output stream.
+  void write_chunk();
+
   /// \returns The number of bits needed to index terms.
   unsigned int term_index_width();
 
@@ -58,11 +88,21 @@ private:
   unsigned int m_term_index_width; ///< caches the result of term_index_width().
   unsigned int m_function_symbol_index_width; ///< caches the result of function_symbol_index_width().
 
+  std::size_t m_window_size = 0; ///< The number of shared terms after which a new window is started, or zero.
+
   mcrl2::utilities::indexed_set<aterm> m_terms; ///< An index of already written terms.
   mcrl2::utilities::indexed_set<function_symbol> m_function_symbols; ///< An index of already written function symbols.
+
+  bool m_chunked = false; ///< Whether the terms are written in chunks.
+  std::shared_ptr<mcrl2::utilities::obitstream> m_output; ///< The stream to which chunks are written.
+  std::ostringstream m_chunk; ///< The encoding of the current chunk, which is written by m_stream.
+  std::size_t m_chunk_outputs = 0; ///< The number of output terms in the current chunk.
+  std::vector<function_symbol> m_new_function_symbols; ///< The function symbols used for the first time in this chunk.
+  aterm_transformer* m_chunk_transformer = identity; ///< The transformer used for the current chunk.
 };
 
 /// \brief Reads terms from a stream in the steamable binary aterm format.
+/// \details Chunked streams are decoded ahead of time by multiple threads, each decoding a single chunk.
 class binary_aterm_istream final : public aterm_istream
 {
 public:
@@ -72,7 +112,24 @@ public:
 
   aterm get() override;
 
+  /// \brief Sets the number of chunks that are decoded simultaneously, by default the number of hardware threads.
+  void set_number_of_threads(std::size_t number_of_threads);
+
 private:
+  /// \brief A chunk of a chunked stream that has been read, but of which not all output terms have been returned.
+  struct chunk
+  {
+    std::string data;           ///< The encoded terms.
+    std::size_t number_of_outputs; ///< The number of output terms encoded in data.
+    std::vector<aterm> outputs; ///< The decoded output terms.
+  };
+
+  /// \brief Reads up to m_number_of_threads chunks and decodes them in parallel.
+  void read_chunks();
+
+  /// \brief Decodes the output terms of the given chunk with the current transformer.
+  void decode_chunk(chunk& current) const;
+
   /// \returns The number of bits needed to index terms.
   unsigned int term_index_width();
 
@@ -84,8 +141,15 @@ private:
   unsigned int m_term_index_width; ///< caches the result of term_index_width().
   unsigned int m_function_symbol_index_width; ///< caches the result of function_symbol_index_width().
 
-  std::deque<aterm> m_terms; ///< An index of read terms.
+  std::deque<aterm> m_terms; ///< An index of the read terms in the current window.
   std::deque<function_symbol> m_function_symbols; ///< An index of read function symbols.
+
+  bool m_chunked = false; ///< Whether the stream consists of chunks.
+  bool m_end_of_chunks = false; ///< Whether the chunk that marks the end of the stream has been read.
+  std::size_t m_number_of_threads; ///< The number of chunks that are decoded simultaneously.
+  std::deque<chunk> m_chunks; ///< The chunks that have been read ahead.
+  std::size_t m_chunk_position = 0; ///< The next output term of the first chunk.
+  aterm_transformer* m_chunk_transformer = identity; ///< The transformer with which m_chunks were decoded.
 };
 
 } // namespace atermpp
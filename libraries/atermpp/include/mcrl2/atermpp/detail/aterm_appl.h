@@ -11,6 +11,7 @@
 #define MCRL2_ATERMPP_DETAIL_ATERM_APPL_H
 
 #include "mcrl2/atermpp/aterm.h"
+#include "mcrl2/utilities/memory_accounting.h"
 #include "mcrl2/utilities/unused.h"
 
 #include <array>
@@ -184,7 +185,7 @@ public:
   constexpr bool has_free_slots() const noexcept { return false; }
 
 private:
-  std::allocator<char> m_packed_allocator;
+  mcrl2::utilities::accounting_allocator<char, mcrl2::utilities::memory_subsystem::terms> m_packed_allocator;
 };
 
 static_assert(sizeof(_term_appl) == sizeof(_aterm) + sizeof(aterm), "Sanity check: aterm_appl size");
@@ -28,7 +28,18 @@ constexpr static bool GlobalThreadSafe = false;
 constexpr static bool EnableGarbageCollection = true;
 
 /// \brief Enable the block allocator for terms.
+#ifdef MCRL2_ATERMPP_BLOCK_ALLOCATOR
+constexpr static bool EnableBlockAllocator = true;
+#else
 constexpr static bool EnableBlockAllocator = false;
+#endif
+
+/// \brief Store the terms in open addressing hash tables instead of hash tables with separate chaining.
+#ifdef MCRL2_ATERMPP_OPEN_ADDRESSING
+constexpr static bool EnableOpenAddressing = true;
+#else
+constexpr static bool EnableOpenAddressing = false;
+#endif
 
 /// \brief Enable to print garbage collection statistics.
 constexpr static bool EnableGarbageCollectionMetrics = false;
@@ -39,6 +50,9 @@ constexpr static bool EnableHashtableMetrics = false;
 /// \brief Enable to obtain the percentage of terms found compared to allocated.
 constexpr static bool EnableCreationMetrics = false;
 
+/// \brief Enable to print the memory used by the blocks of the block allocator.
+constexpr static bool EnableAllocationMetrics = false;
+
 /// \brief Keep track of the number of variables registered.
 constexpr static bool EnableVariableRegistrationMetrics = false;
 
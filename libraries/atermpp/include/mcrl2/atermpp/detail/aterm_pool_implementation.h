@@ -14,6 +14,7 @@
 #include <chrono>
 #include "aterm_pool.h"
 #include "aterm_pool_storage_implementation.h"   // For store_in_argument_array. 
+#include "mcrl2/utilities/instrumentation.h"
 
 
 namespace atermpp
@@ -21,6 +22,9 @@ namespace atermpp
 namespace detail
 {
 
+/// \brief Counts the terms that are removed by garbage collection when tracing is enabled.
+inline const mcrl2::utilities::trace_counter g_collected_terms("collected terms");
+
 aterm_pool::aterm_pool() :
   m_int_storage(*this),
   m_appl_storage(
@@ -219,6 +223,7 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
     unlock();
     return;
   }
+  mcrl2::utilities::trace_span span("garbage collection");
   auto timestamp = std::chrono::system_clock::now();
   std::size_t old_size = size();
 
@@ -279,6 +284,7 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   assert(std::get<6>(m_appl_storage).verify_sweep());
   assert(std::get<7>(m_appl_storage).verify_sweep());
   assert(m_appl_dynamic_storage.verify_sweep());
+  g_collected_terms.add(old_size - size());
 
   // Print some statistics.
   if (EnableGarbageCollectionMetrics)
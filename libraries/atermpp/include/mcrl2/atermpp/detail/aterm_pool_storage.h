@@ -12,6 +12,7 @@
 
 #include "mcrl2/atermpp/detail/aterm_hash.h"
 #include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/open_addressing_set.h"
 #include "mcrl2/utilities/unordered_set.h"
 
 #include <stack>
@@ -38,16 +39,13 @@ template<typename Element,
 class aterm_pool_storage : private mcrl2::utilities::noncopyable
 {
 public:
-  using unordered_set = mcrl2::utilities::unordered_set<
-    Element,
-    Hash,
-    Equals,
-    typename std::conditional<N == DynamicNumberOfArguments,
+  using allocator_type = typename std::conditional<N == DynamicNumberOfArguments,
       atermpp::detail::_aterm_appl_allocator<>,
-      typename std::conditional<EnableBlockAllocator, mcrl2::utilities::block_allocator<Element, 1024, GlobalThreadSafe>, std::allocator<Element>>::type
-      >::type,
-    GlobalThreadSafe,
-    false>;
+      typename std::conditional<EnableBlockAllocator, mcrl2::utilities::block_allocator<Element, 1024, GlobalThreadSafe, mcrl2::utilities::memory_subsystem::terms>, std::allocator<Element>>::type
+      >::type;
+  using unordered_set = typename std::conditional<EnableOpenAddressing,
+    mcrl2::utilities::open_addressing_set<Element, Hash, Equals, allocator_type, GlobalThreadSafe, false>,
+    mcrl2::utilities::unordered_set<Element, Hash, Equals, allocator_type, GlobalThreadSafe, false>>::type;
   using iterator = typename unordered_set::iterator;
   using const_iterator = typename unordered_set::const_iterator;
 
@@ -346,6 +346,11 @@ void ATERM_POOL_STORAGE::print_performance_stats(const char* identifier) const
   {
     mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(" << identifier << "): emplace() " << m_term_metric.message() << ".\n";
   }
+
+  if constexpr (EnableAllocationMetrics && EnableBlockAllocator && N != DynamicNumberOfArguments)
+  {
+    mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(" << identifier << "): blocks " << m_term_set.get_allocator().statistics().message() << ".\n";
+  }
 }
 
 #ifdef MCRL2_ATERMPP_REFERENCE_COUNTED
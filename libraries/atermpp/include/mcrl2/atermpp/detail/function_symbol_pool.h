@@ -71,7 +71,7 @@ private:
     _function_symbol,
     function_symbol_hasher,
     function_symbol_equals,
-    mcrl2::utilities::block_allocator<_function_symbol, 1024, GlobalThreadSafe>,
+    mcrl2::utilities::block_allocator<_function_symbol, 1024, GlobalThreadSafe, mcrl2::utilities::memory_subsystem::terms>,
     GlobalThreadSafe,
     false>;
 
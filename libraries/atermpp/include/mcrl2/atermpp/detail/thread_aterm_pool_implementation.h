@@ -59,14 +59,26 @@ void thread_aterm_pool::create_appl(aterm& term, const function_symbol& sym, con
 {
   using are_terms = mcrl2::utilities::forall<std::is_convertible<Terms, unprotected_aterm>...>;
   if constexpr (GlobalThreadSafe) lock_shared();
+  bool added;
   if constexpr (!are_terms::value)
   {
+    // The arguments are computed while the shared lock is held, and this computation can throw an exception.
     ++m_creation_depth;
+    try
+    {
+      added = m_pool.create_appl(term, sym, arguments...);
+    }
+    catch (...)
+    {
+      --m_creation_depth;
+      if constexpr (GlobalThreadSafe) unlock_shared();
+      throw;
+    }
+    --m_creation_depth;
   }
-  bool added = m_pool.create_appl(term, sym, arguments...);
-  if constexpr (!are_terms::value)
+  else
   {
-    --m_creation_depth;
+    added = m_pool.create_appl(term, sym, arguments...);
   }
   if constexpr (GlobalThreadSafe) unlock_shared();
   if (added) { m_pool.created_term(m_lock_depth == 0, this); }
@@ -121,8 +133,19 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
 {
   if constexpr (GlobalThreadSafe) lock_shared();
   ++m_creation_depth;
-  
-  bool added = m_pool.create_appl_dynamic(term, sym, begin, end);
+
+  // Dereferencing the iterators can throw an exception, after which the thread must not remain busy.
+  bool added;
+  try
+  {
+    added = m_pool.create_appl_dynamic(term, sym, begin, end);
+  }
+  catch (...)
+  {
+    --m_creation_depth;
+    if constexpr (GlobalThreadSafe) unlock_shared();
+    throw;
+  }
   --m_creation_depth;
 
   if constexpr (GlobalThreadSafe) unlock_shared();
@@ -140,7 +163,18 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   if constexpr (GlobalThreadSafe) lock_shared();
   ++m_creation_depth;
 
-  bool added = m_pool.create_appl_dynamic(term, sym, convert_to_aterm, begin, end);
+  // The conversion can throw an exception, after which the thread must not remain busy.
+  bool added;
+  try
+  {
+    added = m_pool.create_appl_dynamic(term, sym, convert_to_aterm, begin, end);
+  }
+  catch (...)
+  {
+    --m_creation_depth;
+    if constexpr (GlobalThreadSafe) unlock_shared();
+    throw;
+  }
   --m_creation_depth;
   if constexpr (GlobalThreadSafe) unlock_shared();
 
@@ -282,7 +316,9 @@ void inline lock_shared(std::atomic<bool>* busy_flag,
     if (forbidden_flag->load())
     {
       *busy_flag = false;
+      // This sets the busy flag again and increases the lock depth, which is the same variable as *lock_depth.
       atermpp::detail::g_thread_term_pool().lock_shared();
+      return;
     }
   }
 
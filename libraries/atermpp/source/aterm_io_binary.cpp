@@ -8,6 +8,10 @@
 //
 
 #include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/utilities/parallel_for.h"
+
+#include <algorithm>
+#include <thread>
 
 namespace atermpp
 {
@@ -32,7 +36,19 @@ static constexpr std::uint16_t BAF_MAGIC = 0x8baf;
 ///  2 April 2017     : version changed to 0x0304 (removed a few superfluous fields in the format)
 /// 19 July 2019      : version changed to 0x8305 (introduction of the streamable aterm format)
 /// 28 February 2020  : version changed to 0x8306 (added ability to stream aterm_int, implemented structured streaming for all objects)
-static constexpr std::uint16_t BAF_VERSION = 0x8306;
+/// 19 October 2026   : version changed to 0x8307 (added window boundaries, streams of version 0x8306 can still be read)
+/// 19 October 2026   : version 0x8308 for chunked streams, which are written to a std::ostream
+static constexpr std::uint16_t BAF_VERSION = 0x8307;
+static constexpr std::uint16_t BAF_CHUNKED_VERSION = 0x8308;
+
+/// \brief The oldest version that can still be read, as it only lacks window boundaries.
+static constexpr std::uint16_t BAF_MINIMUM_VERSION = 0x8306;
+
+/// \brief The default number of shared terms in a chunk.
+static constexpr std::size_t BAF_CHUNK_TERMS = 1 << 20;
+
+/// \brief The number of bytes after which a chunk is ended, such that streams with few shared terms are divided as well.
+static constexpr std::size_t BAF_CHUNK_BYTES = 4 * 1024 * 1024;
 
 /// \brief Each packet has a header consisting of a type.
 /// \details Either indicates a function symbol, a term (either shared or output) or an arbitrary integer.
@@ -61,16 +77,79 @@ binary_aterm_ostream::binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obi
 }
 
 binary_aterm_ostream::binary_aterm_ostream(std::ostream& stream)
-  : binary_aterm_ostream(std::make_shared<mcrl2::utilities::obitstream>(stream))
-{}
+  : m_window_size(BAF_CHUNK_TERMS),
+    m_chunked(true),
+    m_output(std::make_shared<mcrl2::utilities::obitstream>(stream))
+{
+  m_function_symbols.insert(function_symbol("end_of_stream", 0));
+  m_function_symbol_index_width = 1;
+
+  m_output->write_bits(0, 8);
+  m_output->write_bits(BAF_MAGIC, 16);
+  m_output->write_bits(BAF_CHUNKED_VERSION, 16);
+
+  // The chunks are never compressed themselves, as the output stream already is when enabled.
+  m_stream = std::make_shared<mcrl2::utilities::obitstream>(m_chunk, false);
+}
 
 binary_aterm_ostream::~binary_aterm_ostream()
 {
+  if (m_chunked)
+  {
+    // Write the last chunk followed by a chunk without output terms.
+    if (m_chunk_outputs > 0)
+    {
+      write_chunk();
+    }
+    m_output->write_integer(0);
+
+    // The bitstream of the next chunk must not outlive m_chunk.
+    m_stream.reset();
+    return;
+  }
+
   // Write the end of the stream.
   m_stream->write_bits(static_cast<std::size_t>(packet_type::aterm), packet_bits);
   m_stream->write_bits(0, function_symbol_index_width());
 }
 
+void binary_aterm_ostream::start_chunk()
+{
+  if (m_chunk_outputs > 0
+    && (m_chunk_transformer != m_transformer
+      || (m_window_size != 0 && m_terms.size() >= m_window_size)
+      || static_cast<std::size_t>(m_chunk.tellp()) >= BAF_CHUNK_BYTES))
+  {
+    write_chunk();
+  }
+
+  m_chunk_transformer = m_transformer;
+}
+
+void binary_aterm_ostream::write_chunk()
+{
+  // Destroying the bitstream flushes the last bits of this chunk.
+  m_stream.reset();
+  const std::string data = m_chunk.str();
+
+  m_output->write_integer(m_chunk_outputs);
+  m_output->write_integer(m_new_function_symbols.size());
+  for (const function_symbol& symbol : m_new_function_symbols)
+  {
+    m_output->write_string(symbol.name());
+    m_output->write_integer(symbol.arity());
+  }
+  m_output->write_integer(data.size());
+  m_output->write(reinterpret_cast<const std::uint8_t*>(data.data()), data.size());
+
+  // The next chunk has its own term table.
+  m_chunk.str(std::string());
+  m_stream = std::make_shared<mcrl2::utilities::obitstream>(m_chunk, false);
+  m_chunk_outputs = 0;
+  m_new_function_symbols.clear();
+  m_terms.clear();
+}
+
 /// \brief Keep track of whether the term can be written to the stream.
 struct write_todo
 {
@@ -82,8 +161,26 @@ struct write_todo
   {}
 };
 
+void binary_aterm_ostream::set_window_size(std::size_t number_of_terms)
+{
+  m_window_size = number_of_terms;
+}
+
 void binary_aterm_ostream::put(const aterm& term)
 {
+  if (m_chunked)
+  {
+    start_chunk();
+    ++m_chunk_outputs;
+  }
+  else if (m_window_size != 0 && m_terms.size() >= m_window_size)
+  {
+    // Start a new window, which is indicated by an output term with function symbol index zero.
+    m_stream->write_bits(static_cast<std::size_t>(packet_type::aterm_output), packet_bits);
+    m_stream->write_bits(0, function_symbol_index_width());
+    m_terms.clear();
+  }
+
   // Traverse the term bottom up and store the subterms (and function symbol) before the actual term.
   std::stack<write_todo> stack;
   stack.emplace(static_cast<const aterm_appl&>(term));
@@ -113,7 +210,7 @@ void binary_aterm_ostream::put(const aterm& term)
 
             // Write the packet identifier of an aterm_int followed by its value.
             m_stream->write_bits(static_cast<std::size_t>(packet_type::aterm), packet_bits);
-            m_stream->write_bits(symbol_index, function_symbol_index_width());
+            write_function_symbol_index(symbol_index);
             m_stream->write_integer(reinterpret_cast<const aterm_int&>(current.term).value());
           }
         }
@@ -123,7 +220,7 @@ void binary_aterm_ostream::put(const aterm& term)
 
           // Write the packet identifier, followed by the indices of its function symbol and arguments.
           m_stream->write_bits(static_cast<std::size_t>(is_output ? packet_type::aterm_output : packet_type::aterm), packet_bits);
-          m_stream->write_bits(symbol_index, function_symbol_index_width());
+          write_function_symbol_index(symbol_index);
 
           for (const aterm& argument : transformed)
           {
@@ -181,7 +278,8 @@ unsigned int binary_aterm_ostream::function_symbol_index_width()
 }
 
 binary_aterm_istream::binary_aterm_istream(std::shared_ptr<mcrl2::utilities::ibitstream> stream)
-  : m_stream(stream)
+  : m_stream(stream),
+    m_number_of_threads(std::max<unsigned int>(std::thread::hardware_concurrency(), 1))
 {
   // The term with function symbol index 0 indicates the end of the stream.
   m_function_symbols.emplace_back();
@@ -194,7 +292,11 @@ binary_aterm_istream::binary_aterm_istream(std::shared_ptr<mcrl2::utilities::ibi
   }
 
   std::size_t version = m_stream->read_bits(16);
-  if (version != BAF_VERSION)
+  if (version == BAF_CHUNKED_VERSION)
+  {
+    m_chunked = true;
+  }
+  else if (version < BAF_MINIMUM_VERSION || version > BAF_VERSION)
   {
     throw mcrl2::runtime_error("The BAF version (" + std::to_string(version) + ") of the input file is incompatible with the version (" + std::to_string(BAF_VERSION) +
                                ") of this tool. The input file must be regenerated. ");
@@ -215,6 +317,13 @@ std::size_t binary_aterm_ostream::write_function_symbol(const function_symbol& s
   }
   else
   {
+    if (m_chunked)
+    {
+      // The function symbol is written before the chunk in which it is used.
+      m_new_function_symbols.push_back(symbol);
+      return m_function_symbols.insert(symbol).first;
+    }
+
     // The function symbol has not been written yet, write it now and return its index.
     m_stream->write_bits(static_cast<std::size_t>(packet_type::function_symbol), packet_bits);
     m_stream->write_string(symbol.name());
@@ -227,8 +336,159 @@ std::size_t binary_aterm_ostream::write_function_symbol(const function_symbol& s
   }
 }
 
+void binary_aterm_ostream::write_function_symbol_index(std::size_t index)
+{
+  if (m_chunked)
+  {
+    // The size of the function symbol table when this chunk is decoded is not known yet.
+    m_stream->write_integer(index);
+  }
+  else
+  {
+    m_stream->write_bits(index, function_symbol_index_width());
+  }
+}
+
+void binary_aterm_istream::set_number_of_threads(std::size_t number_of_threads)
+{
+  m_number_of_threads = std::max<std::size_t>(number_of_threads, 1);
+}
+
+void binary_aterm_istream::read_chunks()
+{
+  // Read the chunks sequentially, which also extends the function symbol table.
+  std::size_t first = m_chunks.size();
+  while (!m_end_of_chunks && m_chunks.size() - first < m_number_of_threads)
+  {
+    std::size_t number_of_outputs = m_stream->read_integer();
+    if (number_of_outputs == 0)
+    {
+      m_end_of_chunks = true;
+      break;
+    }
+
+    std::size_t number_of_symbols = m_stream->read_integer();
+    for (std::size_t i = 0; i < number_of_symbols; ++i)
+    {
+      std::string name = m_stream->read_string();
+      std::size_t arity = m_stream->read_integer();
+      m_function_symbols.emplace_back(name, arity);
+    }
+
+    chunk& current = m_chunks.emplace_back();
+    current.number_of_outputs = number_of_outputs;
+    current.data.resize(m_stream->read_integer());
+    m_stream->read(current.data.size(), reinterpret_cast<std::uint8_t*>(current.data.data()));
+  }
+
+  // Decode the chunks that were read in parallel.
+  m_chunk_transformer = m_transformer;
+  mcrl2::utilities::parallel_for(m_chunks.size() - first, m_number_of_threads, [&](std::size_t i, std::size_t)
+    {
+      decode_chunk(m_chunks[first + i]);
+    });
+}
+
+void binary_aterm_istream::decode_chunk(chunk& current) const
+{
+  std::istringstream input(current.data);
+  mcrl2::utilities::ibitstream stream(input);
+
+  std::vector<aterm> terms;
+  std::vector<aterm> arguments;
+  current.outputs.clear();
+  current.outputs.reserve(current.number_of_outputs);
+
+  while (current.outputs.size() < current.number_of_outputs)
+  {
+    packet_type packet = static_cast<packet_type>(stream.read_bits(packet_bits));
+
+    if (packet == packet_type::aterm_int_output)
+    {
+      current.outputs.emplace_back(aterm_int(stream.read_integer()));
+    }
+    else if (packet == packet_type::aterm || packet == packet_type::aterm_output)
+    {
+      std::size_t symbol_index = stream.read_integer();
+      if (symbol_index == 0 || symbol_index >= m_function_symbols.size())
+      {
+        throw mcrl2::runtime_error("Error while reading: invalid function symbol index in a current.");
+      }
+
+      const function_symbol& symbol = m_function_symbols[symbol_index];
+      if (symbol == detail::g_as_int)
+      {
+        terms.emplace_back(aterm_int(stream.read_integer()));
+      }
+      else
+      {
+        // The term index width follows the size of the term table of this current.
+        const unsigned int width = terms.empty() ? 0 : static_cast<unsigned int>(std::log2(terms.size()) + 1);
+
+        arguments.resize(symbol.arity());
+        for (std::size_t argument = 0; argument < symbol.arity(); ++argument)
+        {
+          std::size_t index = stream.read_bits(width);
+          if (index >= terms.size())
+          {
+            throw mcrl2::runtime_error("Error while reading: invalid term index in a current.");
+          }
+          arguments[argument] = terms[index];
+        }
+
+        aterm transformed = m_transformer(aterm_appl(symbol, arguments.begin(), arguments.end()));
+        if (packet == packet_type::aterm_output)
+        {
+          current.outputs.emplace_back(transformed);
+        }
+        else
+        {
+          terms.emplace_back(transformed);
+        }
+      }
+    }
+    else
+    {
+      throw mcrl2::runtime_error("Error while reading: unexpected function symbol in a current.");
+    }
+  }
+}
+
 aterm binary_aterm_istream::get()
 {
+  if (m_chunked)
+  {
+    while (m_chunks.empty() || m_chunk_position == m_chunks.front().number_of_outputs)
+    {
+      if (!m_chunks.empty())
+      {
+        m_chunks.pop_front();
+        m_chunk_position = 0;
+      }
+
+      if (m_chunks.empty())
+      {
+        if (m_end_of_chunks)
+        {
+          return aterm();
+        }
+        read_chunks();
+      }
+    }
+
+    if (m_chunk_transformer != m_transformer)
+    {
+      // The transformer was changed after the chunks were decoded, so decode them again.
+      m_chunk_transformer = m_transformer;
+      mcrl2::utilities::parallel_for(m_chunks.size(), m_number_of_threads, [&](std::size_t i, std::size_t)
+        {
+          decode_chunk(m_chunks[i]);
+        });
+    }
+
+    return m_chunks.front().outputs[m_chunk_position++];
+  }
+
   while(true)
   {
     // Determine the type of the next packet.
@@ -256,6 +516,13 @@ aterm binary_aterm_istream::get()
 
       if (!symbol.defined())
       {
+        if (packet == packet_type::aterm_output)
+        {
+          // The output term with function symbol zero marks a window boundary, the terms read so far are no longer needed.
+          m_terms.clear();
+          continue;
+        }
+
         // The term with function symbol zero marks the end of the stream.
         return aterm();
       }
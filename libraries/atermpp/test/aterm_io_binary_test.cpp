@@ -98,3 +98,157 @@ BOOST_AUTO_TEST_CASE(transitions_test)
     BOOST_CHECK_EQUAL(input.get(), sequence[index]);
   }
 }
+
+BOOST_AUTO_TEST_CASE(compressed_stream_test)
+{
+  // Enough terms to fill several compressed blocks.
+  std::vector<aterm_appl> sequence;
+  function_symbol f("f", 2);
+  aterm_appl term = aterm_appl(function_symbol("c", 0));
+  for (std::size_t index = 0; index < 200000; ++index)
+  {
+    term = aterm_appl(f, aterm_int(index % 1000), term);
+    if (index % 100 == 0)
+    {
+      sequence.push_back(term);
+    }
+  }
+
+  std::stringstream stream;
+  mcrl2::utilities::set_bitstream_compression(true, 2);
+  {
+    binary_aterm_ostream output(stream);
+
+    for (const auto& term : sequence)
+    {
+      output << term;
+    }
+  }
+  mcrl2::utilities::set_bitstream_compression(false);
+
+  binary_aterm_istream input(stream);
+  for (std::size_t index = 0; index < sequence.size(); ++index)
+  {
+    BOOST_CHECK_EQUAL(input.get(), sequence[index]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(windowed_stream_test)
+{
+  // Terms that share subterms with terms of earlier windows, which are written again in every window.
+  std::vector<aterm_appl> sequence;
+  function_symbol f("f", 2);
+  aterm_appl shared = aterm_appl(function_symbol("shared", 1), aterm_int(42));
+  for (std::size_t index = 0; index < 1000; ++index)
+  {
+    sequence.emplace_back(f, shared, aterm_appl(f, aterm_int(index), shared));
+  }
+
+  std::stringstream windowed;
+  {
+    // Window boundaries are used when the stream is not divided into chunks.
+    binary_aterm_ostream output(std::make_shared<mcrl2::utilities::obitstream>(windowed));
+    output.set_window_size(16);
+    for (const auto& term : sequence)
+    {
+      output << term;
+    }
+  }
+
+  binary_aterm_istream input(windowed);
+  for (std::size_t index = 0; index < sequence.size(); ++index)
+  {
+    BOOST_CHECK_EQUAL(input.get(), sequence[index]);
+  }
+  BOOST_CHECK(!input.get().defined());
+}
+
+BOOST_AUTO_TEST_CASE(chunked_stream_test)
+{
+  std::vector<aterm_appl> sequence;
+  function_symbol f("f", 2);
+  aterm_appl shared = aterm_appl(function_symbol("shared", 1), aterm_int(42));
+  for (std::size_t index = 0; index < 10000; ++index)
+  {
+    // New function symbols are introduced in later chunks as well.
+    function_symbol g("g" + std::to_string(index % 500), 1);
+    sequence.emplace_back(f, aterm_appl(g, shared), aterm_appl(f, aterm_int(index), shared));
+  }
+
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream);
+    output.set_window_size(100);
+    for (const auto& term : sequence)
+    {
+      output << term;
+    }
+    output << aterm_int(1337);
+  }
+
+  for (std::size_t number_of_threads : { 1, 4 })
+  {
+    std::stringstream input_stream(stream.str());
+    binary_aterm_istream input(input_stream);
+    input.set_number_of_threads(number_of_threads);
+    for (std::size_t index = 0; index < sequence.size(); ++index)
+    {
+      BOOST_REQUIRE_EQUAL(input.get(), sequence[index]);
+    }
+    BOOST_CHECK_EQUAL(input.get(), aterm_int(1337));
+    BOOST_CHECK(!input.get().defined());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(unchunked_stream_test)
+{
+  // Streams written to a bitstream are not chunked, as in older versions of the format.
+  aterm_appl term(function_symbol("f", 2), aterm_int(1), aterm_appl(function_symbol("c", 0)));
+
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(std::make_shared<mcrl2::utilities::obitstream>(stream));
+    output << term << aterm_int(2);
+  }
+
+  binary_aterm_istream input(stream);
+  BOOST_CHECK_EQUAL(input.get(), term);
+  BOOST_CHECK_EQUAL(input.get(), aterm_int(2));
+}
+
+static aterm_appl rename_f(const aterm_appl& term)
+{
+  if (term.function() == function_symbol("f", 1))
+  {
+    return aterm_appl(function_symbol("g", 1), term[0]);
+  }
+  return term;
+}
+
+BOOST_AUTO_TEST_CASE(chunked_stream_transformer_test)
+{
+  function_symbol f("f", 1);
+  function_symbol g("g", 1);
+
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream);
+    for (std::size_t index = 0; index < 10; ++index)
+    {
+      output << aterm_appl(f, aterm_int(index));
+    }
+  }
+
+  // Changing the transformer applies it to the remaining terms, even though these have already been decoded.
+  binary_aterm_istream input(stream);
+  for (std::size_t index = 0; index < 5; ++index)
+  {
+    BOOST_CHECK_EQUAL(input.get(), aterm_appl(f, aterm_int(index)));
+  }
+
+  input >> rename_f;
+  for (std::size_t index = 5; index < 10; ++index)
+  {
+    BOOST_CHECK_EQUAL(input.get(), aterm_appl(g, aterm_int(index)));
+  }
+}
@@ -11,6 +11,13 @@
 
 ${declare longest_match}
 
+// Whitespace and comments are skipped by the scanner of the mCRL2 grammar, see mcrl2_syntax.g.
+${declare whitespace mcrl2_dparser_white_space}
+{
+#include "dparse.h"
+void mcrl2_dparser_white_space(struct D_Parser* p, d_loc_t* loc, void** globals);
+}
+
 // <parity_game> ::= [parity <identifier> ;] <node_spec>+
 // <node_spec> ::= <identifier> <priority> <owner> <successors> [name] ;
 // <identifier> ::= N
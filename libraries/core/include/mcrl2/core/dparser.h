@@ -15,6 +15,7 @@
 #include <cstddef>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // prototypes
 struct D_ParseNode;
@@ -117,9 +118,10 @@ struct parser_table
 {
   D_ParserTables& m_table;
 
-  explicit parser_table(D_ParserTables& table)
-    : m_table(table)
-  { }
+  // The names of the symbols, which are shared by all parser tables for the same D_ParserTables
+  const std::vector<std::string>& m_symbol_names;
+
+  explicit parser_table(D_ParserTables& table);
 
   // Prints a tree of
   std::string tree(const core::parse_node& node) const;
@@ -128,9 +130,9 @@ struct parser_table
   unsigned int symbol_count() const;
 
   // Returns the name of the i-th symbol
-  std::string symbol_name(unsigned int i) const;
+  const std::string& symbol_name(unsigned int i) const;
 
-  std::string symbol_name(const parse_node& node) const;
+  const std::string& symbol_name(const parse_node& node) const;
 
   // Returns the 'start symbol' of the i-th symbol
   int start_symbol(unsigned int i) const;
@@ -202,7 +202,7 @@ struct parser_actions
     return set_collector<SetContainer, Function>(table, type, container, f);
   }
 
-  std::string symbol_name(const parse_node& node) const
+  const std::string& symbol_name(const parse_node& node) const
   {
     return m_parser.symbol_table().symbol_name(node.symbol());
   }
@@ -14,10 +14,49 @@
 #include "mcrl2/utilities/logger.h"
 #include <iomanip>
 #include <locale>
+#include <map>
+#include <mutex>
+#include <vector>
 
 extern "C"
 {
   extern D_ParserTables parser_tables_mcrl2;
+
+  /// \brief Skips the whitespace and comments at loc, and updates the line and column of loc accordingly.
+  /// \details This is a hand-written equivalent of the whitespace production "([ \t\n\r]|(%[^\n\r]*))*" of the
+  ///          grammars, which is used instead of running a separate parser for that production before every token.
+  void mcrl2_dparser_white_space(struct D_Parser* ap, d_loc_t* loc, void** /* globals */)
+  {
+    const char* end = ((Parser*)ap)->end;
+    char* s = loc->s;
+    char* line_start = nullptr;
+    while (s < end)
+    {
+      if (*s == ' ' || *s == '\t' || *s == '\r')
+      {
+        ++s;
+      }
+      else if (*s == '\n')
+      {
+        ++s;
+        ++loc->line;
+        line_start = s;
+      }
+      else if (*s == '%')
+      {
+        while (s < end && *s != '\n' && *s != '\r')
+        {
+          ++s;
+        }
+      }
+      else
+      {
+        break;
+      }
+    }
+    loc->col = line_start ? static_cast<int>(s - line_start) : loc->col + static_cast<int>(s - loc->s);
+    loc->s = s;
+  }
 }
 
 namespace mcrl2 {
@@ -90,6 +129,37 @@ parse_node::~parse_node()
   }
 }
 
+namespace detail {
+
+/// \brief Returns the names of the symbols of table, which are converted to strings once per table.
+static const std::vector<std::string>& symbol_names(const D_ParserTables& table)
+{
+  static std::mutex names_mutex;
+  static std::map<const D_ParserTables*, std::vector<std::string>> names;
+
+  std::lock_guard<std::mutex> guard(names_mutex);
+  auto i = names.find(&table);
+  if (i == names.end())
+  {
+    std::vector<std::string> result;
+    result.reserve(table.nsymbols);
+    for (unsigned int j = 0; j < table.nsymbols; j++)
+    {
+      const char* name = table.symbols[j].name;
+      result.emplace_back(name ? name : "");
+    }
+    i = names.emplace(&table, std::move(result)).first;
+  }
+  return i->second;
+}
+
+} // namespace detail
+
+parser_table::parser_table(D_ParserTables& table)
+  : m_table(table),
+    m_symbol_names(detail::symbol_names(table))
+{ }
+
 // Prints a tree of
 std::string parser_table::tree(const core::parse_node& node) const
 {
@@ -112,7 +182,7 @@ unsigned int parser_table::symbol_count() const
 }
 
 // Returns the name of the i-th symbol
-std::string parser_table::symbol_name(unsigned int i) const
+const std::string& parser_table::symbol_name(unsigned int i) const
 {
   if (i >= m_table.nsymbols)
   {
@@ -121,15 +191,10 @@ std::string parser_table::symbol_name(unsigned int i) const
     out << "parser_table::symbol_name: index " << i << " out of bounds!";
     throw std::runtime_error(out.str());
   }
-  const char* name = m_table.symbols[i].name;
-  if (!name)
-  {
-    return "";
-  }
-  return std::string(name);
+  return m_symbol_names[i];
 }
 
-std::string parser_table::symbol_name(const parse_node& node) const
+const std::string& parser_table::symbol_name(const parse_node& node) const
 {
   return symbol_name(node.symbol());
 }
@@ -12,6 +12,14 @@
 ${declare tokenize}
 ${declare longest_match}
 
+// Whitespace and comments are skipped by a hand-written scanner instead of by a parser for the whitespace
+// production at the end of this file, which is kept to document the syntax. The scanner is defined in dparser.cpp.
+${declare whitespace mcrl2_dparser_white_space}
+{
+#include "dparse.h"
+void mcrl2_dparser_white_space(struct D_Parser* p, d_loc_t* loc, void** globals);
+}
+
 //--- Sort expressions and sort declarations
 
 SortExpr
@@ -0,0 +1,73 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/data/parse.h"
+#include "mcrl2/data/rewriter.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <iostream>
+#include <thread>
+
+using namespace mcrl2;
+
+int main(int argc, char* argv[])
+{
+  std::size_t number_of_threads = 1;
+  data::rewrite_strategy strategy = data::jitty;
+  std::size_t n = 24;
+
+  // Accept arguments for the number of threads, the rewrite strategy and the argument of fib.
+  if (argc > 1)
+  {
+    number_of_threads = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+  if (argc > 2)
+  {
+    strategy = data::parse_rewrite_strategy(argv[2]);
+  }
+  if (argc > 3)
+  {
+    n = static_cast<std::size_t>(std::stoul(argv[3]));
+  }
+
+  // Computes a Fibonacci number naively, which requires many rewrite steps and creates many terms.
+  data::data_specification dataspec = data::parse_data_specification(
+    "map fib: Nat -> Nat;\n"
+    "var n: Nat;\n"
+    "eqn fib(0) = 0;\n"
+    "    fib(1) = 1;\n"
+    "    n > 1 -> fib(n) = fib(Int2Nat(n - 1)) + fib(Int2Nat(n - 2));\n");
+
+  const data::data_expression expression = data::parse_data_expression("fib(" + std::to_string(n) + ")", dataspec);
+
+  data::rewriter rewr(dataspec, strategy);
+  stopwatch timer;
+
+  // Every thread rewrites the same expression using its own copy of the rewriter.
+  auto rewrite = [&]()
+    {
+      data::rewriter thread_rewr = rewr.clone();
+      thread_rewr.thread_initialise();
+      data::data_expression result = thread_rewr(expression);
+    };
+
+  std::vector<std::thread> threads;
+  for (std::size_t id = 1; id < number_of_threads; ++id)
+  {
+    threads.emplace_back(rewrite);
+  }
+  rewrite();
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::cerr << "time: " << timer.seconds() << std::endl;
+  return 0;
+}
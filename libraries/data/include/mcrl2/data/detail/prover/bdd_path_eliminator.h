@@ -53,7 +53,7 @@ class BDD_Path_Eliminator: public BDD_Simplifier
   private:
 
     /// \brief Pointer to an SMT solver used to determine whether or not a path is inconsistent.
-    SMT_Solver* f_smt_solver;
+    std::shared_ptr<SMT_Solver> f_smt_solver;
 
     /// \brief Class that provides information about the structure of BDDs.
     BDD_Info f_bdd_info;
@@ -127,7 +127,9 @@ class BDD_Path_Eliminator: public BDD_Simplifier
 
       const data_expression v_guard = f_bdd_info.get_guard(a_bdd);
       const data_expression v_negated_guard = sort_bool::not_(v_guard);
-      const data_expression_list v_true_condition = create_condition(a_path, v_guard, true);
+      // An incremental solver gets the complete path, such that consecutive conditions share the path as suffix.
+      const bool v_minimal = !f_smt_solver->is_incremental();
+      const data_expression_list v_true_condition = create_condition(a_path, v_guard, v_minimal);
       bool v_true_branch_enabled = f_smt_solver->is_satisfiable(v_true_condition);
       if (!v_true_branch_enabled)
       {
@@ -137,7 +139,7 @@ class BDD_Path_Eliminator: public BDD_Simplifier
       }
       else
       {
-        data_expression_list v_false_condition = create_condition(a_path, v_negated_guard, true);
+        data_expression_list v_false_condition = create_condition(a_path, v_negated_guard, v_minimal);
         bool v_false_branch_enabled = f_smt_solver->is_satisfiable(v_false_condition);
         if (!v_false_branch_enabled)
         {
@@ -187,7 +189,7 @@ class BDD_Path_Eliminator: public BDD_Simplifier
       {
         if (mcrl2::data::detail::prover::cvc_smt_solver::usable())
         {
-          f_smt_solver = new mcrl2::data::detail::prover::cvc_smt_solver();
+          f_smt_solver = std::make_shared<mcrl2::data::detail::prover::cvc_smt_solver>();
 
           return;
         }
@@ -196,7 +198,7 @@ class BDD_Path_Eliminator: public BDD_Simplifier
       {
         if (mcrl2::data::detail::prover::z3_smt_solver::usable())
         {
-          f_smt_solver = new mcrl2::data::detail::prover::z3_smt_solver();
+          f_smt_solver = std::make_shared<mcrl2::data::detail::prover::z3_smt_solver>();
 
           return;
         }
@@ -210,6 +212,12 @@ class BDD_Path_Eliminator: public BDD_Simplifier
 #endif // _MSC_VER
     }
 
+    /// \brief Constructor that uses the given SMT solver.
+    /// \param a_smt_solver An SMT solver, which is not shared with other path eliminators.
+    explicit BDD_Path_Eliminator(const std::shared_ptr<SMT_Solver>& a_smt_solver)
+      : f_smt_solver(a_smt_solver)
+    {}
+
     /// \brief Returns a BDD without inconsistent paths, equivalent to a_bdd.
     /// precondition: The argument passed as parameter a_bdd is a data expression in internal mCRL2 format with the
     /// following restrictions: It either represents the constant true or the constant false, or it is an if-then-else
@@ -13,6 +13,7 @@
 #define MCRL2_DATA_DETAIL_BDD_PROVER_H
 
 #include "mcrl2/data/detail/prover/bdd_path_eliminator.h"
+#include "mcrl2/data/detail/prover/bdd_prover_cache.h"
 #include "mcrl2/data/detail/prover/induction.h"
 
 namespace mcrl2
@@ -127,16 +128,18 @@ class BDD_Prover: protected rewriter
     /// \brief A flag indicating whether or not induction on lists is applied.
     bool f_apply_induction;
 
+    /// \brief A flag indicating whether or not inconsistent paths are removed using an SMT solver.
+    bool f_path_eliminator = false;
+
+    /// \brief The SMT solver that is used for path elimination.
+    smt_solver_type f_solver_type = solver_type_cvc;
+
     /// \brief A data specification.
     // const data_specification& f_data_spec;
 
-    /// \brief A hashtable that maps formulas to BDDs.
-    /// \brief If the BDD of a formula is unknown, it maps this formula to 0.
-    std::unordered_map < data_expression, data_expression > f_formula_to_bdd;
-
-    /// \brief A hashtable that maps formulas to the smallest guard occuring in those formulas.
-    /// \brief If the smallest guard of a formula is unknown, it maps this formula to 0.
-    std::unordered_map < data_expression, data_expression > f_smallest;
+    /// \brief The bounded caches that map formulas to BDDs and to the smallest guard occurring in those formulas.
+    /// \brief The caches are kept when a new formula is set, and may be shared with other provers.
+    std::shared_ptr<BDD_Prover_Cache> f_cache = std::make_shared<BDD_Prover_Cache>();
 
     /// \brief Class that simplifies a BDD.
     std::shared_ptr<BDD_Simplifier> f_bdd_simplifier;
@@ -206,10 +209,10 @@ class BDD_Prover: protected rewriter
         return abstraction(a.binding_operator(), a.variables(), bdd_down(a.body(), a_indent));
       }
 
-      const std::unordered_map < data_expression, data_expression >::const_iterator i = f_formula_to_bdd.find(formula);
-      if (i!=f_formula_to_bdd.end()) // found
+      data_expression v_bdd;
+      if (f_cache->find_bdd(formula, v_bdd))
       {
-        return i->second;
+        return v_bdd;
       }
 
       data_expression v_guard;
@@ -239,8 +242,8 @@ class BDD_Prover: protected rewriter
       v_term2 = bdd_down(v_term2, extra_indent);
       mCRL2log(log::debug1) << indent(extra_indent) << "BDD of the false-branch: " << v_term2 << std::endl;
 
-      data_expression v_bdd = Manipulator::make_reduced_if_then_else(v_guard, v_term1, v_term2);
-      f_formula_to_bdd[formula]=v_bdd;
+      v_bdd = Manipulator::make_reduced_if_then_else(v_guard, v_term1, v_term2);
+      f_cache->insert_bdd(formula, v_bdd);
 
       return v_bdd;
     }
@@ -368,10 +371,8 @@ class BDD_Prover: protected rewriter
         return false;
       }
 
-      const std::unordered_map < data_expression, data_expression >::const_iterator i = f_smallest.find(formula);
-      if (i!=f_smallest.end()) //found
+      if (f_cache->find_smallest(formula, result))
       {
-        result=i->second;
         return true;
       }
 
@@ -403,7 +404,7 @@ class BDD_Prover: protected rewriter
       }
       if (result_is_defined)
       {
-        f_smallest[formula]=result;  // Save the result in the cache
+        f_cache->insert_smallest(formula, result);  // Save the result in the cache
         return true;
       }
 
@@ -458,6 +459,8 @@ class BDD_Prover: protected rewriter
     data_expression f_bdd;
   public:
 
+    /// \brief Constructor. If a_path_eliminator is true and a_smt_solver is not nullptr, then a_smt_solver is used for
+    /// \brief path elimination instead of a solver of type a_solver_type.
     BDD_Prover(
       const data_specification& data_spec,
       const used_data_equation_selector& equations_selector,
@@ -465,12 +468,16 @@ class BDD_Prover: protected rewriter
       int a_time_limit = 0,
       bool a_path_eliminator = false,
       smt_solver_type a_solver_type = solver_type_cvc,
-      bool a_apply_induction = false)
+      bool a_apply_induction = false,
+      const std::shared_ptr<SMT_Solver>& a_smt_solver = nullptr)
     : rewriter(data_spec, equations_selector, a_rewrite_strategy),
       f_time_limit(a_time_limit),
       f_apply_induction(a_apply_induction),
-      f_bdd_simplifier(a_path_eliminator ? std::shared_ptr<BDD_Simplifier>(new BDD_Path_Eliminator(a_solver_type)) : 
-                                           std::shared_ptr<BDD_Simplifier>(new BDD_Simplifier()))
+      f_path_eliminator(a_path_eliminator),
+      f_solver_type(a_solver_type),
+      f_bdd_simplifier(!a_path_eliminator ? std::shared_ptr<BDD_Simplifier>(new BDD_Simplifier()) :
+                       a_smt_solver != nullptr ? std::shared_ptr<BDD_Simplifier>(new BDD_Path_Eliminator(a_smt_solver)) :
+                                                 std::shared_ptr<BDD_Simplifier>(new BDD_Path_Eliminator(a_solver_type)))
     {
       rewriter::thread_initialise();
       switch (a_rewrite_strategy)
@@ -511,6 +518,18 @@ class BDD_Prover: protected rewriter
       rewriter::thread_initialise();
     }
 
+    BDD_Prover(const rewriter& r, int time_limit, bool path_eliminator, smt_solver_type solver_type, bool apply_induction)
+    : rewriter(r),
+      f_time_limit(time_limit),
+      f_apply_induction(apply_induction),
+      f_path_eliminator(path_eliminator),
+      f_solver_type(solver_type),
+      f_bdd_simplifier(path_eliminator ? std::shared_ptr<BDD_Simplifier>(new BDD_Path_Eliminator(solver_type)) :
+                                         std::shared_ptr<BDD_Simplifier>(new BDD_Simplifier()))
+    {
+      rewriter::thread_initialise();
+    }
+
     /// \brief Destructor that destroys the BDD simplifier BDD_Prover::f_bdd_simplifier.
     ~BDD_Prover()
     {
@@ -628,9 +647,29 @@ class BDD_Prover: protected rewriter
       mCRL2log(log::debug) << "The formula has been set." << std::endl;
     }
 
+    /// \brief Returns the caches of this prover.
+    const std::shared_ptr<BDD_Prover_Cache>& cache() const
+    {
+      return f_cache;
+    }
+
+    /// \brief Lets this prover use the given caches, e.g. to share them with another prover for the same data
+    /// \brief specification and rewrite strategy. The caches are not thread safe, so they cannot be shared by
+    /// \brief provers that are used in different threads.
+    void set_cache(const std::shared_ptr<BDD_Prover_Cache>& cache)
+    {
+      f_cache = cache;
+    }
+
+    /// \brief Returns a prover with a clone of the rewriter and the same settings. The clone does not share
+    /// \brief any mutable state with this prover, so it can be used in another thread after calling
+    /// \brief thread_initialise() in that thread. An SMT solver passed to the constructor is not shared; the
+    /// \brief clone uses a solver of the same type instead. The clone gets empty caches of the same size.
     BDD_Prover clone()
     {
-      return BDD_Prover(rewriter::clone());
+      BDD_Prover result(rewriter::clone(), f_time_limit, f_path_eliminator, f_solver_type, f_apply_induction);
+      result.set_cache(std::make_shared<BDD_Prover_Cache>(f_cache->max_size()));
+      return result;
     }
 
     void thread_initialise()
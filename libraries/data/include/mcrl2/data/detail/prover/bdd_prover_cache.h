@@ -0,0 +1,125 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/prover/bdd_prover_cache.h
+/// \brief Bounded caches of the BDD prover that are kept across formulas.
+
+#ifndef MCRL2_DATA_DETAIL_PROVER_BDD_PROVER_CACHE_H
+#define MCRL2_DATA_DETAIL_PROVER_BDD_PROVER_CACHE_H
+
+#include "mcrl2/data/data_expression.h"
+#include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
+
+#include <sstream>
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+/// \brief The caches of the BDD prover, which map formulas to their BDDs and to their smallest guards.
+/// \details Since terms are maximally shared, a formula is found in constant time. The caches remain valid for
+///          other formulas, and can be shared by provers that use the same rewriter and substitution. Each of
+///          the caches holds at most max_size entries (or an unbounded number if max_size is zero); when a cache
+///          is full, the oldest entry is removed.
+class BDD_Prover_Cache
+{
+  public:
+    /// \brief The default maximum number of entries of each cache.
+    static constexpr std::size_t default_size = 1UL << 16;
+
+  private:
+    using cache_type = utilities::fifo_cache<data_expression, data_expression>;
+
+    std::size_t f_max_size;
+    cache_type f_formula_to_bdd;
+    cache_type f_smallest;
+    utilities::cache_metric f_formula_to_bdd_metric;
+    utilities::cache_metric f_smallest_metric;
+
+    static bool find(cache_type& cache, utilities::cache_metric& metric, const data_expression& formula, data_expression& result)
+    {
+      auto i = cache.find(formula);
+      if (i == cache.end())
+      {
+        metric.miss();
+        return false;
+      }
+      metric.hit();
+      result = i->second;
+      return true;
+    }
+
+    static void insert(cache_type& cache, const data_expression& formula, const data_expression& result)
+    {
+      auto i = cache.emplace(formula, result);
+      if (!i.second)
+      {
+        i.first->second = result;
+      }
+    }
+
+  public:
+    explicit BDD_Prover_Cache(std::size_t max_size = default_size)
+      : f_max_size(max_size),
+        f_formula_to_bdd(max_size),
+        f_smallest(max_size)
+    {}
+
+    /// \brief Returns the maximum number of entries of each cache, where zero means unbounded.
+    std::size_t max_size() const
+    {
+      return f_max_size;
+    }
+
+    /// \brief Sets result to the BDD of formula and returns true, if it is cached.
+    bool find_bdd(const data_expression& formula, data_expression& result)
+    {
+      return find(f_formula_to_bdd, f_formula_to_bdd_metric, formula, result);
+    }
+
+    void insert_bdd(const data_expression& formula, const data_expression& bdd)
+    {
+      insert(f_formula_to_bdd, formula, bdd);
+    }
+
+    /// \brief Sets result to the smallest guard of formula and returns true, if it is cached.
+    bool find_smallest(const data_expression& formula, data_expression& result)
+    {
+      return find(f_smallest, f_smallest_metric, formula, result);
+    }
+
+    void insert_smallest(const data_expression& formula, const data_expression& guard)
+    {
+      insert(f_smallest, formula, guard);
+    }
+
+    /// \brief Removes all entries, but keeps the statistics.
+    void clear()
+    {
+      f_formula_to_bdd.clear();
+      f_smallest.clear();
+    }
+
+    /// \brief Returns a description of the number of hits and misses of both caches.
+    std::string statistics() const
+    {
+      std::ostringstream out;
+      out << "BDD cache: " << f_formula_to_bdd_metric.message() << "; "
+          << "guard cache: " << f_smallest_metric.message();
+      return out.str();
+    }
+};
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_PROVER_BDD_PROVER_CACHE_H
@@ -26,6 +26,13 @@ class SMT_Solver
   public:
     virtual ~SMT_Solver() {};
     virtual bool is_satisfiable(const data_expression_list &a_formula) = 0;
+
+    /// \brief Indicates whether the solver keeps its state between calls of is_satisfiable. Such a solver benefits
+    /// \brief from consecutive formulas that share a suffix, since only the differing clauses need to be sent.
+    virtual bool is_incremental() const
+    {
+      return false;
+    }
 };
 } // namespace detail
 } // namespace data
@@ -0,0 +1,72 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/thread_rewriters.h
+/// \brief A rewriter for each of the threads of a parallel computation.
+
+#ifndef MCRL2_DATA_DETAIL_THREAD_REWRITERS_H
+#define MCRL2_DATA_DETAIL_THREAD_REWRITERS_H
+
+#include <deque>
+#include "mcrl2/data/rewriter.h"
+
+namespace mcrl2
+{
+
+namespace data
+{
+
+namespace detail
+{
+
+/// \brief A rewriter for each of the threads of a parallel transformation. Thread 0 uses the given
+///        rewriter and the other threads use clones of it, as one rewriter can only be used sequentially.
+template <typename Rewriter = data::rewriter>
+class thread_rewriters
+{
+  protected:
+    /// \brief The rewriters. A deque is used, such that references to the rewriters remain valid.
+    std::deque<Rewriter> m_rewriters;
+
+    /// \brief Indicates for each thread whether its rewriter has been initialised by that thread.
+    std::vector<char> m_initialised;
+
+  public:
+    /// \brief Constructor. The clones are made by the calling thread.
+    thread_rewriters(Rewriter& R, std::size_t number_of_threads)
+      : m_initialised(std::max(number_of_threads, std::size_t(1)), false)
+    {
+#ifndef MCRL2_THREAD_SAFE
+      number_of_threads = 1;
+#endif
+      m_rewriters.push_back(R);
+      m_initialised[0] = true;
+      for (std::size_t i = 1; i < number_of_threads; ++i)
+      {
+        m_rewriters.push_back(R.clone());
+      }
+    }
+
+    /// \brief Returns the rewriter of the thread with the given index. It may only be called by that thread.
+    Rewriter& operator[](std::size_t thread_index)
+    {
+      if (!m_initialised[thread_index])
+      {
+        m_rewriters[thread_index].thread_initialise();
+        m_initialised[thread_index] = true;
+      }
+      return m_rewriters[thread_index];
+    }
+};
+
+} // namespace detail
+
+} // namespace data
+
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_THREAD_REWRITERS_H
@@ -18,6 +18,7 @@
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/data/substitutions/enumerator_substitution.h"
+#include "mcrl2/utilities/instrumentation.h"
 #include "mcrl2/utilities/math.h"
 
 namespace mcrl2
@@ -210,6 +211,9 @@ bool is_enumerable(const data_specification& dataspec,
   }
 }
 
+/// \brief Counts the elements processed by the enumerator when tracing is enabled.
+inline const utilities::trace_counter enumerated_element_counter("enumerated elements");
+
 } // namespace detail
 
 /// \brief Enumerator exception
@@ -501,7 +505,10 @@ template <typename EnumeratorListElement>
 class enumerator_queue
 {
   protected:
-    atermpp::deque<EnumeratorListElement> P;
+    typedef atermpp::deque<EnumeratorListElement,
+      utilities::accounting_allocator<atermpp::detail::reference_aterm<EnumeratorListElement>, utilities::memory_subsystem::enumerator>> queue_type;
+
+    queue_type P;
     EnumeratorListElement m_enumerator_element_cache;  // This element is used to temporarily store
                                                        // information, which is more efficient than
                                                        // declaring such a variable on the stack
@@ -516,7 +523,7 @@ class enumerator_queue
     variable_list scratch_variable_list;
 
     typedef EnumeratorListElement value_type;
-    typedef typename atermpp::deque<EnumeratorListElement>::size_type size_type;
+    typedef typename queue_type::size_type size_type;
 
     /// \brief Default constructor
     enumerator_queue() = default;
@@ -553,7 +560,7 @@ class enumerator_queue
       P.clear();
     }
 
-    typename atermpp::deque<EnumeratorListElement>::size_type size() const
+    typename queue_type::size_type size() const
     {
       return P.size();
     }
@@ -954,6 +961,7 @@ class enumerator_algorithm
         }
         P.pop_front();
       }
+      detail::enumerated_element_counter.add(count);
       return count;
     }
 
@@ -12,6 +12,7 @@
 #ifndef MCRL2_DATA_PROVER_TOOL_H
 #define MCRL2_DATA_PROVER_TOOL_H
 
+#include "mcrl2/data/detail/prover/bdd_prover_cache.h"
 #include "mcrl2/data/detail/prover/solver_type.h"
 #include "mcrl2/utilities/command_line_interface.h"
 
@@ -34,6 +35,9 @@ class prover_tool: public Tool
     /// The data rewriter strategy
     smt_solver_type m_solver_type;
 
+    /// The maximum number of entries in each of the caches of the prover
+    std::size_t m_prover_cache_size;
+
     /// \brief Add options to an interface description. Also includes
     /// rewriter options.
     /// \param desc An interface description
@@ -47,6 +51,9 @@ class prover_tool: public Tool
                       "use SOLVER to remove inconsistent paths from the internally used "
                       "BDDs (by default, no path elimination is applied):",
                       'z');
+      desc.add_option("prover-cache-size", utilities::make_mandatory_argument("NUM"),
+                      "store at most NUM formulas in each of the caches of the prover, where 0 means "
+                      "unbounded (default " + std::to_string(data::detail::BDD_Prover_Cache::default_size) + ")");
     }
 
     /// \brief Parse non-standard options
@@ -59,6 +66,10 @@ class prover_tool: public Tool
       {
         m_solver_type = parser.option_argument_as< smt_solver_type >("smt-solver");
       }
+      if (0 < parser.options.count("prover-cache-size"))
+      {
+        m_prover_cache_size = parser.option_argument_as< std::size_t >("prover-cache-size");
+      }
     }
 
   public:
@@ -71,7 +82,8 @@ class prover_tool: public Tool
                 std::string known_issues = ""
                )
       : Tool(name, author, what_is, tool_description, known_issues),
-        m_solver_type(mcrl2::data::detail::solver_type_cvc)
+        m_solver_type(mcrl2::data::detail::solver_type_cvc),
+        m_prover_cache_size(mcrl2::data::detail::BDD_Prover_Cache::default_size)
     {}
 
     /// \brief Returns the rewrite strategy
@@ -80,6 +92,12 @@ class prover_tool: public Tool
     {
       return m_solver_type;
     }
+
+    /// \brief Returns the maximum number of entries in each of the caches of the prover
+    std::size_t prover_cache_size() const
+    {
+      return m_prover_cache_size;
+    }
 };
 
 } // namespace tools
@@ -15,6 +15,7 @@
 #include "mcrl2/atermpp/detail/aterm_configuration.h"
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/expression_traits.h"
+#include "mcrl2/utilities/instrumentation.h"
 
 namespace mcrl2
 {
@@ -71,6 +72,14 @@ class basic_rewriter
 
 };
 
+namespace detail
+{
+
+/// \brief Counts the calls of the data rewriter when tracing is enabled.
+inline const utilities::trace_counter rewrite_call_counter("rewrite calls");
+
+} // namespace detail
+
 /// \brief Rewriter that operates on data expressions.
 //
 /// \attention As long as normalisation of sorts remains necessary, the data
@@ -221,6 +230,7 @@ class rewriter: public basic_rewriter<data_expression>
 #ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
       rewrite_calls++;
 #endif
+      detail::rewrite_call_counter.add();
 #ifdef MCRL2_PRINT_REWRITE_STEPS
       mCRL2log(log::debug) << "REWRITE " << d << "\n";
 #endif
@@ -34,13 +34,25 @@ class data_type_checker: public sort_type_checker
     std::map<core::identifier_string,sort_expression_list> user_functions;     //name -> Set(sort expression)
     data_specification type_checked_data_spec;
 
+    /// \brief The candidate sorts of a function name, i.e., the system function sorts followed by the user function sorts,
+    ///        and these candidates grouped by their number of arguments.
+    struct function_overloads
+    {
+      sort_expression_list sorts;
+      std::map<std::size_t, sort_expression_list> sorts_by_arity;
+    };
+
+    /// \brief Index of the system and user functions by name, which is built once all functions are known.
+    std::unordered_map<core::identifier_string, function_overloads> function_overloads_index;
+
   public:
     /** \brief     make a data type checker.
      *             Throws a mcrl2::runtime_error exception if the data_specification is not well typed.
      *  \param[in] data_spec A data specification that does not need to have been type checked.
+     *  \param[in] number_of_threads The number of threads used to type check the equations of data_spec.
      *  \return    A data expression where all untyped identifiers have been replace by typed ones.
      **/
-    data_type_checker(const data_specification& data_spec);
+    data_type_checker(const data_specification& data_spec, std::size_t number_of_threads = 1);
 
     /** \brief     Type checks a variable.
      *             Throws an mcrl2::runtime_error exception if the variable is not well typed.
@@ -84,6 +96,8 @@ class data_type_checker: public sort_type_checker
     void add_system_constant(const data::function_symbol& f);
     void add_system_function(const data::function_symbol& f);
     void add_system_constants_and_functions(const std::vector<data::function_symbol>& v);
+    void build_function_overloads_index();
+    const function_overloads* find_function_overloads(const core::identifier_string& name) const;
     bool TypeMatchA(const sort_expression& Type_in, const sort_expression& PosType_in, sort_expression& result) const;
     bool TypeMatchL(const sort_expression_list& TypeList, const sort_expression_list& PosTypeList, sort_expression_list& result) const;
     sort_expression UnwindType(const sort_expression& Type) const;
@@ -164,7 +178,8 @@ class data_type_checker: public sort_type_checker
                     const bool strictly_ambiguous,
                     bool warn_upcasting=false,
                     const bool print_cast_error=false) const;
-    void TransformVarConsTypeData(data_specification& data_spec);
+    void TransformVarConsTypeData(data_specification& data_spec, std::size_t number_of_threads);
+    data_equation TransformVarConsTypeEquation(const data_equation& eqn);
     sort_expression_list GetNotInferredList(const atermpp::term_list<sort_expression_list>& TypeListList) const;
     sort_expression_list InsertType(const sort_expression_list& TypeList, const sort_expression& Type) const;
     std::pair<bool,sort_expression_list> AdjustNotInferredList(
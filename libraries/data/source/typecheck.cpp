@@ -8,6 +8,7 @@
 
 #include "mcrl2/data/print.h"
 #include "mcrl2/data/typecheck.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 using namespace mcrl2::log;
 using namespace mcrl2::core::detail;
@@ -2346,41 +2347,26 @@ sort_expression mcrl2::data::data_type_checker::TraverseVarConsTypeDN(
       }
     }
 
+    const function_overloads* overloads=nullptr;
     if (TypeADefined)
     {
       ParList = sort_expression_list({ UnwindType(TypeA) });
     }
     else
     {
-      const std::map <core::identifier_string,sort_expression_list>::const_iterator j_context=user_functions.find(Name);
-      const std::map <core::identifier_string,sort_expression_list>::const_iterator j_gssystem=system_functions.find(Name);
-
-      if (j_context==user_functions.end())
+      overloads=find_function_overloads(Name);
+      if (overloads==nullptr) // None are defined.
       {
-        if (j_gssystem!=system_functions.end())
+        if (nFactPars!=std::string::npos)
         {
-          ParList=j_gssystem->second; // The function only occurs in the system.
+          throw mcrl2::runtime_error("Unknown operation " + core::pp(Name) + " with " + std::to_string(nFactPars) + " parameter" + ((nFactPars != 1)?"s.":"."));
         }
-        else // None are defined.
+        else
         {
-          if (nFactPars!=std::string::npos)
-          {
-            throw mcrl2::runtime_error("Unknown operation " + core::pp(Name) + " with " + std::to_string(nFactPars) + " parameter" + ((nFactPars != 1)?"s.":"."));
-          }
-          else
-          {
-            throw mcrl2::runtime_error("Unknown operation " + core::pp(Name) + ".");
-          }
+          throw mcrl2::runtime_error("Unknown operation " + core::pp(Name) + ".");
         }
       }
-      else if (j_gssystem==system_functions.end())
-      {
-        ParList=j_context->second; // only the context sorts are defined.
-      }
-      else  // Both are defined.
-      {
-        ParList=j_gssystem->second+j_context->second;
-      }
+      ParList=overloads->sorts; // The system functions followed by the user functions.
     }
 
     sort_expression_list CandidateParList=ParList;
@@ -2390,20 +2376,28 @@ sort_expression mcrl2::data::data_type_checker::TraverseVarConsTypeDN(
       sort_expression_list NewParList;
       if (nFactPars!=std::string::npos)
       {
-        for (; !ParList.empty(); ParList=ParList.tail())
+        if (overloads!=nullptr)
         {
-          const sort_expression& Par=ParList.front();
-          if (!is_function_sort(Par))
-          {
-            continue;
-          }
-          if (down_cast<function_sort>(Par).domain().size()!=nFactPars)
+          const auto i=overloads->sorts_by_arity.find(nFactPars);
+          ParList=(i==overloads->sorts_by_arity.end()?sort_expression_list():i->second);
+        }
+        else
+        {
+          for (; !ParList.empty(); ParList=ParList.tail())
           {
-            continue;
+            const sort_expression& Par=ParList.front();
+            if (!is_function_sort(Par))
+            {
+              continue;
+            }
+            if (down_cast<function_sort>(Par).domain().size()!=nFactPars)
+            {
+              continue;
+            }
+            NewParList.push_front(Par);
           }
-          NewParList.push_front(Par);
+          ParList=reverse(NewParList);
         }
-        ParList=reverse(NewParList);
       }
 
       if (!ParList.empty())
@@ -3414,30 +3408,12 @@ sort_expression mcrl2::data::data_type_checker::TraverseVarConsTypeD(
       }
     }
 
-    const std::map <core::identifier_string,sort_expression_list>::const_iterator j_context=user_functions.find(Name);
-    const std::map <core::identifier_string,sort_expression_list>::const_iterator j_gssystem=system_functions.find(Name);
-
-    sort_expression_list ParList;
-    if (j_context==user_functions.end())
+    const function_overloads* overloads=find_function_overloads(Name);
+    if (overloads==nullptr)
     {
-      if (j_gssystem!=system_functions.end())
-      {
-        ParList=j_gssystem->second; // The function only occurs in the system.
-      }
-      else
-      {
-        throw mcrl2::runtime_error("Unknown operation " + core::pp(Name) + ".");
-      }
-    }
-    else if (j_gssystem==system_functions.end())
-    {
-      ParList=j_context->second; // only the context sorts are defined.
-    }
-    else  // Both are defined.
-    {
-      ParList=j_gssystem->second+j_context->second;
+      throw mcrl2::runtime_error("Unknown operation " + core::pp(Name) + ".");
     }
-
+    const sort_expression_list& ParList=overloads->sorts; // The system functions followed by the user functions.
 
     if (ParList.size()==1)
     {
@@ -3974,6 +3950,46 @@ void mcrl2::data::data_type_checker::add_function(const data::function_symbol& f
   }
 }
 
+void mcrl2::data::data_type_checker::build_function_overloads_index()
+{
+  function_overloads_index.clear();
+  for (const auto& f: system_functions)
+  {
+    function_overloads_index[f.first].sorts=f.second;
+  }
+  for (const auto& f: user_functions)
+  {
+    function_overloads& overloads=function_overloads_index[f.first];
+    overloads.sorts=overloads.sorts+f.second;
+  }
+
+  for (auto& f: function_overloads_index)
+  {
+    std::map<std::size_t, std::vector<sort_expression> > sorts_by_arity;
+    for (const sort_expression& s: f.second.sorts)
+    {
+      if (is_function_sort(s))
+      {
+        sorts_by_arity[down_cast<function_sort>(s).domain().size()].push_back(s);
+      }
+    }
+    for (const auto& arity_sorts: sorts_by_arity)
+    {
+      f.second.sorts_by_arity[arity_sorts.first]=sort_expression_list(arity_sorts.second.begin(),arity_sorts.second.end());
+    }
+  }
+}
+
+const mcrl2::data::data_type_checker::function_overloads* mcrl2::data::data_type_checker::find_function_overloads(const core::identifier_string& name) const
+{
+  const auto i=function_overloads_index.find(name);
+  if (i==function_overloads_index.end())
+  {
+    return nullptr;
+  }
+  return &i->second;
+}
+
 void mcrl2::data::data_type_checker::read_sort(const sort_expression& sort_expr)
 {
   if (is_basic_sort(sort_expr))
@@ -4202,7 +4218,7 @@ sort_expression_list mcrl2::data::data_type_checker::GetNotInferredList(const te
   return Result;
 }
 
-mcrl2::data::data_type_checker::data_type_checker(const data_specification& data_spec)
+mcrl2::data::data_type_checker::data_type_checker(const data_specification& data_spec, std::size_t number_of_threads)
       : sort_type_checker(data_spec),
         was_warning_upcasting(false)
 {
@@ -4215,6 +4231,7 @@ mcrl2::data::data_type_checker::data_type_checker(const data_specification& data
       read_sort(a.reference());
     }
     read_constructors_and_mappings(data_spec.user_defined_constructors(),data_spec.user_defined_mappings(),data_spec.constructors());
+    build_function_overloads_index();
   }
   catch (mcrl2::runtime_error& e)
   {
@@ -4226,7 +4243,7 @@ mcrl2::data::data_type_checker::data_type_checker(const data_specification& data
   // Type check equations and add them to the specification.
   try
   {
-    TransformVarConsTypeData(type_checked_data_spec);
+    TransformVarConsTypeData(type_checked_data_spec, number_of_threads);
   }
   catch (mcrl2::runtime_error& e)
   {
@@ -4333,133 +4350,148 @@ void mcrl2::data::data_type_checker::operator()(const variable_list& l,
 // ------------------------------  Here ends the new class based data expression checker -----------------------
 // ------------------------------  Here starts the new class based data specification checker -----------------------
 
-// Type check and replace user defined equations.
-void mcrl2::data::data_type_checker::TransformVarConsTypeData(data_specification& data_spec)
+// Type check a user defined equation.
+data_equation mcrl2::data::data_type_checker::TransformVarConsTypeEquation(const data_equation& eqn)
 {
-
-  //Create a new specification; admittedly, this is somewhat clumsy.
-  data_specification new_specification;
-  for(const basic_sort& s: data_spec.user_defined_sorts())
+  const variable_list& vars=eqn.variables();
+  try
   {
-    new_specification.add_sort(s);
+    // Typecheck the variables in an equation.
+    (*this)(vars,detail::variable_context());
   }
-  for(const alias& a: data_spec.user_defined_aliases())
+  catch (mcrl2::runtime_error& e)
   {
-    new_specification.add_alias(a);
+    throw mcrl2::runtime_error(std::string(e.what()) + "\nThis error occurred while typechecking equation " + data::pp(eqn) + ".");
   }
-  for(const function_symbol& f: data_spec.user_defined_constructors())
+
+  detail::variable_context DeclaredVars;
+  DeclaredVars.add_context_variables(vars);
+
+  data_expression left=eqn.lhs();
+
+  sort_expression leftType;
+  try
   {
-    new_specification.add_constructor(f);
+    leftType=TraverseVarConsTypeD(DeclaredVars,left,data::untyped_sort(),true,true);
   }
-  for(const function_symbol& f: data_spec.user_defined_mappings())
+  catch (mcrl2::runtime_error& e)
   {
-    new_specification.add_mapping(f);
+    throw mcrl2::runtime_error(std::string(e.what()) + "\nError occurred while typechecking " + data::pp(left) + " as left hand side of equation " + data::pp(eqn) + ".");
   }
 
-  for (const data_equation& eqn: data_spec.user_defined_equations())
+  if (was_warning_upcasting)
   {
-    const variable_list& vars=eqn.variables();
-    try
-    {
-      // Typecheck the variables in an equation.
-      (*this)(vars,detail::variable_context());
-    }
-    catch (mcrl2::runtime_error& e)
-    {
-      throw mcrl2::runtime_error(std::string(e.what()) + "\nThis error occurred while typechecking equation " + data::pp(eqn) + ".");
-    }
+    was_warning_upcasting=false;
+    mCRL2log(warning) << "Warning occurred while typechecking " << left << " as left hand side of equation " << eqn << "." << std::endl;
+  }
 
-    detail::variable_context DeclaredVars;
-    DeclaredVars.add_context_variables(vars);
+  data_expression cond=eqn.condition();
+  TraverseVarConsTypeD(DeclaredVars,cond,sort_bool::bool_());
 
-    data_expression left=eqn.lhs();
+  data_expression right=eqn.rhs();
+  sort_expression rightType;
+  try
+  {
+    rightType=TraverseVarConsTypeD(DeclaredVars,right,leftType,false);
+  }
+  catch (mcrl2::runtime_error& e)
+  {
+    throw mcrl2::runtime_error(std::string(e.what()) + "\nError occurred while typechecking " + data::pp(right) + " as right hand side of equation " + data::pp(eqn) + ".");
+  }
 
-    sort_expression leftType;
+  //If the types are not uniquely the same now: do once more:
+  if (!EqTypesA(leftType,rightType))
+  {
+    sort_expression Type;
+    if (!TypeMatchA(leftType,rightType,Type))
+    {
+      throw mcrl2::runtime_error("Types of the left- (" + data::pp(leftType) + ") and right- (" + data::pp(rightType) + ") hand-sides of the equation " + data::pp(eqn) + " do not match.");
+    }
+    left=eqn.lhs();
     try
     {
-      leftType=TraverseVarConsTypeD(DeclaredVars,left,data::untyped_sort(),true,true);
+      leftType=TraverseVarConsTypeD(DeclaredVars,left,Type,true);
     }
     catch (mcrl2::runtime_error& e)
     {
-      throw mcrl2::runtime_error(std::string(e.what()) + "\nError occurred while typechecking " + data::pp(left) + " as left hand side of equation " + data::pp(eqn) + ".");
+      throw mcrl2::runtime_error(std::string(e.what()) + "\nTypes of the left- and right-hand-sides of the equation " + data::pp(eqn) + " do not match.");
     }
-
     if (was_warning_upcasting)
     {
       was_warning_upcasting=false;
       mCRL2log(warning) << "Warning occurred while typechecking " << left << " as left hand side of equation " << eqn << "." << std::endl;
     }
-
-    data_expression cond=eqn.condition();
-    TraverseVarConsTypeD(DeclaredVars,cond,sort_bool::bool_());
-
-    data_expression right=eqn.rhs();
-    sort_expression rightType;
+    right=eqn.rhs();
     try
     {
-      rightType=TraverseVarConsTypeD(DeclaredVars,right,leftType,false);
+      rightType=TraverseVarConsTypeD(DeclaredVars,right,leftType);
     }
     catch (mcrl2::runtime_error& e)
     {
-      throw mcrl2::runtime_error(std::string(e.what()) + "\nError occurred while typechecking " + data::pp(right) + " as right hand side of equation " + data::pp(eqn) + ".");
+      throw mcrl2::runtime_error(std::string(e.what()) + "\nTypes of the left- and right-hand-sides of the equation " + data::pp(eqn) + " do not match.");
     }
-
-    //If the types are not uniquely the same now: do once more:
-    if (!EqTypesA(leftType,rightType))
+    if (!TypeMatchA(leftType,rightType,Type))
     {
-      sort_expression Type;
-      if (!TypeMatchA(leftType,rightType,Type))
-      {
-        throw mcrl2::runtime_error("Types of the left- (" + data::pp(leftType) + ") and right- (" + data::pp(rightType) + ") hand-sides of the equation " + data::pp(eqn) + " do not match.");
-      }
-      left=eqn.lhs();
-      try
-      {
-        leftType=TraverseVarConsTypeD(DeclaredVars,left,Type,true);
-      }
-      catch (mcrl2::runtime_error& e)
-      {
-        throw mcrl2::runtime_error(std::string(e.what()) + "\nTypes of the left- and right-hand-sides of the equation " + data::pp(eqn) + " do not match.");
-      }
-      if (was_warning_upcasting)
-      {
-        was_warning_upcasting=false;
-        mCRL2log(warning) << "Warning occurred while typechecking " << left << " as left hand side of equation " << eqn << "." << std::endl;
-      }
-      right=eqn.rhs();
-      try
-      {
-        rightType=TraverseVarConsTypeD(DeclaredVars,right,leftType);
-      }
-      catch (mcrl2::runtime_error& e)
-      {
-        throw mcrl2::runtime_error(std::string(e.what()) + "\nTypes of the left- and right-hand-sides of the equation " + data::pp(eqn) + " do not match.");
-      }
-      if (!TypeMatchA(leftType,rightType,Type))
-      {
-        throw mcrl2::runtime_error("Types of the left- (" + data::pp(leftType) + ") and right- (" + data::pp(rightType) + ") hand-sides of the equation " + data::pp(eqn) + " do not match.");
-      }
-      if (detail::HasUnknown(Type))
-      {
-        throw mcrl2::runtime_error("Types of the left- (" + data::pp(leftType) + ") and right- (" + data::pp(rightType) + ") hand-sides of the equation " + data::pp(eqn) + " cannot be uniquely determined.");
-      }
-      // Check that the variable in the condition and the right hand side are a subset of those in the left hand side of the equation.
-      const std::set<variable> vars_in_lhs=find_free_variables(left);
-      const std::set<variable> vars_in_rhs=find_free_variables(right);
+      throw mcrl2::runtime_error("Types of the left- (" + data::pp(leftType) + ") and right- (" + data::pp(rightType) + ") hand-sides of the equation " + data::pp(eqn) + " do not match.");
+    }
+    if (detail::HasUnknown(Type))
+    {
+      throw mcrl2::runtime_error("Types of the left- (" + data::pp(leftType) + ") and right- (" + data::pp(rightType) + ") hand-sides of the equation " + data::pp(eqn) + " cannot be uniquely determined.");
+    }
+    // Check that the variable in the condition and the right hand side are a subset of those in the left hand side of the equation.
+    const std::set<variable> vars_in_lhs=find_free_variables(left);
+    const std::set<variable> vars_in_rhs=find_free_variables(right);
 
-      variable culprit;
-      if (!detail::includes(vars_in_rhs,vars_in_lhs,culprit))
-      {
-        throw mcrl2::runtime_error("The variable " + data::pp(culprit) + " in the right hand side is not included in the left hand side of the equation " + data::pp(eqn) + ".");
-      }
+    variable culprit;
+    if (!detail::includes(vars_in_rhs,vars_in_lhs,culprit))
+    {
+      throw mcrl2::runtime_error("The variable " + data::pp(culprit) + " in the right hand side is not included in the left hand side of the equation " + data::pp(eqn) + ".");
+    }
 
-      const std::set<variable> vars_in_condition=find_free_variables(cond);
-      if (!detail::includes(vars_in_condition,vars_in_lhs,culprit))
-      {
-        throw mcrl2::runtime_error("The variable " + data::pp(culprit) + " in the condition is not included in the left hand side of the equation " + data::pp(eqn) + ".");
-      }
+    const std::set<variable> vars_in_condition=find_free_variables(cond);
+    if (!detail::includes(vars_in_condition,vars_in_lhs,culprit))
+    {
+      throw mcrl2::runtime_error("The variable " + data::pp(culprit) + " in the condition is not included in the left hand side of the equation " + data::pp(eqn) + ".");
     }
-    new_specification.add_equation(data_equation(vars,cond,left,right));
+  }
+  return data_equation(vars,cond,left,right);
+}
+
+// Type check and replace user defined equations.
+void mcrl2::data::data_type_checker::TransformVarConsTypeData(data_specification& data_spec, std::size_t number_of_threads)
+{
+
+  //Create a new specification; admittedly, this is somewhat clumsy.
+  data_specification new_specification;
+  for(const basic_sort& s: data_spec.user_defined_sorts())
+  {
+    new_specification.add_sort(s);
+  }
+  for(const alias& a: data_spec.user_defined_aliases())
+  {
+    new_specification.add_alias(a);
+  }
+  for(const function_symbol& f: data_spec.user_defined_constructors())
+  {
+    new_specification.add_constructor(f);
+  }
+  for(const function_symbol& f: data_spec.user_defined_mappings())
+  {
+    new_specification.add_mapping(f);
+  }
+
+  // The equations are type checked independently, each thread with its own copy of this type checker.
+  const data_equation_vector& equations=data_spec.user_defined_equations();
+  data_equation_vector typed_equations(equations.size());
+  std::vector<data_type_checker> checkers(number_of_threads>1?number_of_threads-1:0, *this);
+  utilities::parallel_for(equations.size(), number_of_threads, [&](std::size_t i, std::size_t thread_index)
+  {
+    data_type_checker& checker=(thread_index==0?*this:checkers[thread_index-1]);
+    typed_equations[i]=checker.TransformVarConsTypeEquation(equations[i]);
+  });
+  for (const data_equation& eqn: typed_equations)
+  {
+    new_specification.add_equation(eqn);
   }
   std::map<std::pair<data_expression, data_expression>, data_equation> lhs_map;
   for (const data_equation& eqn: new_specification.user_defined_equations())
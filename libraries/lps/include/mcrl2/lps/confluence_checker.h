@@ -17,7 +17,10 @@
 
 #include "mcrl2/lps/disjointness_checker.h"
 #include "mcrl2/lps/invariant_checker.h"
+#include <atomic>
 #include <iomanip>
+#include <optional>
+#include <thread>
 
 
 /** \brief A class that takes a linear process specification and checks all tau-summands of that LPS for confluence.
@@ -120,6 +123,13 @@
     was set to true, the confluent tau-summands will not be marked, only the results of the confluence checking will be
     displayed.
 
+    If the parameter a_number_of_threads is larger than one, the confluence conditions of a tau-summand and the other
+    summands are proven in parallel, where each thread uses its own clone of the prover. The results are processed in
+    the order of the summands afterwards, such that the output and the resulting LPS are the same as in a sequential run.
+
+    If a_prover_cache is not nullptr, the prover and the invariant checker store the BDDs of the formulas they encounter in
+    these caches. The clones of the prover for the threads use their own caches of the same size.
+
     If there already is an action named ctau present in the LPS passed as parameter a_lps, an error will be reported. */
 
 
@@ -162,6 +172,24 @@ class Confluence_Checker
   typedef std::vector<action_summand_type> action_summand_vector_type;
 
   private:
+    /// \brief The result of proving the confluence condition of a pair of summands.
+    struct summand_pair_result
+    {
+      data::detail::Answer answer = data::detail::answer_undefined;
+
+      /// \brief The BDD of the confluence condition, only set if it is not a tautology and the BDD is needed.
+      data::data_expression bdd;
+
+      /// \brief The counter example, only set if it is not a tautology and counter examples are printed.
+      data::data_expression counter_example;
+
+      /// \brief An exception thrown by the prover, which is rethrown when the result is used.
+      std::exception_ptr error;
+
+      /// \brief An exception thrown while computing the counter example.
+      std::exception_ptr counter_example_error;
+    };
+
     /// \brief Class that can check if two summands are disjoint.
     Disjointness_Checker f_disjointness_checker;
 
@@ -209,20 +237,45 @@ class Confluence_Checker
     /// \brief Identifier generator to allow variables to be uniquely renamed.
     data::set_identifier_generator f_set_identifier_generator;
 
+    /// \brief The number of threads that is used to prove confluence conditions.
+    std::size_t f_number_of_threads;
+
+    /// \brief Clones of Confluence_Checker::f_bdd_prover, one for each thread.
+    std::vector<std::unique_ptr<data::detail::BDD_Prover>> f_thread_provers;
+
     /// \brief Writes a dot file of the BDD created when checking the confluence of summands a_summand_number_1 and a_summand_number_2.
-    void save_dot_file(std::size_t a_summand_number_1, std::size_t a_summand_number_2);
+    void save_dot_file(std::size_t a_summand_number_1, std::size_t a_summand_number_2, const data::data_expression& a_bdd);
 
     /// \brief Outputs a path in the BDD corresponding to the condition at hand that leads to a node labelled false.
-    void print_counter_example();
+    void print_counter_example(const summand_pair_result& a_result);
+
+    /// \brief Proves the confluence condition of a_summand_1 and a_summand_2 using a_prover.
+    summand_pair_result prove_summand_pair(
+      data::detail::BDD_Prover& a_prover,
+      const data::data_expression& a_invariant,
+      const action_summand_type& a_summand_1,
+      const action_summand_type& a_summand_2,
+      const char a_condition_type);
 
-    /// \brief Checks the confluence of summand a_summand_1 and a_summand_2
+    /// \brief Proves the confluence conditions of a_summand and all summands for which check_summands would
+    /// \brief invoke the prover, using Confluence_Checker::f_number_of_threads threads.
+    /// \return A vector with at position i the result for summand i, or nothing if it was not proven.
+    std::vector<std::optional<summand_pair_result>> prove_summand_pairs_in_parallel(
+      const action_summand_type& a_summand,
+      const std::size_t a_summand_number,
+      const data::data_expression& a_invariant,
+      const char a_condition_type);
+
+    /// \brief Checks the confluence of summand a_summand_1 and a_summand_2. If a_result is not nullptr, it contains
+    /// \brief the previously computed result of the prover.
     bool check_summands(
       const data::data_expression& a_invariant,
       const action_summand_type a_summand_1,
       const std::size_t a_summand_number_1,
       const action_summand_type a_summand_2,
       const std::size_t a_summand_number_2,
-      const char a_condition_type);
+      const char a_condition_type,
+      const summand_pair_result* a_result = nullptr);
 
     /// \brief Checks and updates the confluence of summand a_summand concerning all other tau-summands.
     void check_confluence_and_mark_summand(
@@ -255,7 +308,9 @@ class Confluence_Checker
       std::string a_conditions = "c",
       bool a_counter_example = false,
       bool a_generate_invariants = false,
-      std::string const& a_dot_file_name = std::string()
+      std::string const& a_dot_file_name = std::string(),
+      std::size_t a_number_of_threads = 1,
+      const std::shared_ptr<data::detail::BDD_Prover_Cache>& a_prover_cache = nullptr
     );
 
     /// \brief Check the confluence of the LPS Confluence_Checker::f_lps.
@@ -571,28 +626,75 @@ bool has_ctau_action(const Specification& a_lps)
 // Class Confluence_Checker - Functions declared private ----------------------------------------
 
 template <typename Specification>
-void Confluence_Checker<Specification>::save_dot_file(std::size_t a_summand_number_1, std::size_t a_summand_number_2)
+void Confluence_Checker<Specification>::save_dot_file(std::size_t a_summand_number_1, std::size_t a_summand_number_2, const data::data_expression& a_bdd)
 {
   if (!f_dot_file_name.empty())
   {
-    f_bdd2dot.output_bdd(f_bdd_prover.get_bdd(), f_dot_file_name + "-" + std::to_string(a_summand_number_1) + "-" + std::to_string(a_summand_number_2) + ".dot");
+    f_bdd2dot.output_bdd(a_bdd, f_dot_file_name + "-" + std::to_string(a_summand_number_1) + "-" + std::to_string(a_summand_number_2) + ".dot");
   }
 }
 
 // --------------------------------------------------------------------------------------------
 
 template <typename Specification>
-void Confluence_Checker<Specification>::print_counter_example()
+void Confluence_Checker<Specification>::print_counter_example(const summand_pair_result& a_result)
 {
   if (f_counter_example)
   {
-    const data::data_expression v_counter_example(f_bdd_prover.get_counter_example());
-    mCRL2log(log::info) << "  Counter example: " << v_counter_example << "\n";
+    if (a_result.counter_example_error)
+    {
+      std::rethrow_exception(a_result.counter_example_error);
+    }
+    mCRL2log(log::info) << "  Counter example: " << a_result.counter_example << "\n";
   }
 }
 
 // --------------------------------------------------------------------------------------------
 
+template <typename Specification>
+typename Confluence_Checker<Specification>::summand_pair_result Confluence_Checker<Specification>::prove_summand_pair(
+  data::detail::BDD_Prover& a_prover,
+  const data::data_expression& a_invariant,
+  const action_summand_type& a_summand_1,
+  const action_summand_type& a_summand_2,
+  const char a_condition_type)
+{
+  summand_pair_result result;
+  try
+  {
+    const data::data_expression v_condition = get_confluence_condition(a_invariant, a_summand_1, a_summand_2, f_lps.process().process_parameters(), a_condition_type);
+    a_prover.set_formula(v_condition);
+    result.answer = a_prover.is_tautology();
+    if (result.answer != data::detail::answer_yes)
+    {
+      if (f_generate_invariants || !f_dot_file_name.empty())
+      {
+        result.bdd = a_prover.get_bdd();
+      }
+      if (f_counter_example)
+      {
+        // The counter example is only printed if the condition turns out not to be an invariant, so an exception
+        // is only reported at that point.
+        try
+        {
+          result.counter_example = a_prover.get_counter_example();
+        }
+        catch (...)
+        {
+          result.counter_example_error = std::current_exception();
+        }
+      }
+    }
+  }
+  catch (...)
+  {
+    result.error = std::current_exception();
+  }
+  return result;
+}
+
+// --------------------------------------------------------------------------------------------
+
 template <typename Specification>
 void Confluence_Checker<Specification>::uniquely_rename_summutation_variables(
   action_summand_type& summand)
@@ -669,11 +771,11 @@ bool Confluence_Checker<Specification>::check_summands(
   const std::size_t a_summand_number_1,
   const action_summand_type a_summand_2,
   const std::size_t a_summand_number_2,
-  const char a_condition_type)
+  const char a_condition_type,
+  const summand_pair_result* a_result)
 {
   assert(a_summand_1.is_tau());
 
-  const data::variable_list v_variables = f_lps.process().process_parameters();
   bool v_is_confluent = true;
 
   if ((a_condition_type == 'c' || a_condition_type == 'd') && f_disjointness_checker.disjoint(a_summand_number_1, a_summand_number_2))
@@ -689,9 +791,15 @@ bool Confluence_Checker<Specification>::check_summands(
       uniquely_rename_summutation_variables(tagged);
     }
 
-    const data::data_expression v_condition = get_confluence_condition(a_invariant, a_summand_1, tagged, v_variables, a_condition_type);
-    f_bdd_prover.set_formula(v_condition);
-    if (f_bdd_prover.is_tautology() == data::detail::answer_yes)
+    // The summation variables are also renamed if the result is already known, such that the same fresh names are
+    // generated as in a sequential run.
+    const summand_pair_result v_result = a_result == nullptr ? prove_summand_pair(f_bdd_prover, a_invariant, a_summand_1, tagged, a_condition_type) : *a_result;
+    if (v_result.error)
+    {
+      std::rethrow_exception(v_result.error);
+    }
+
+    if (v_result.answer == data::detail::answer_yes)
     {
       mCRL2log(log::info) << "+";
     }
@@ -699,7 +807,7 @@ bool Confluence_Checker<Specification>::check_summands(
     {
       if (f_generate_invariants)
       {
-        const data::data_expression v_new_invariant(f_bdd_prover.get_bdd());
+        const data::data_expression& v_new_invariant = v_result.bdd;
         mCRL2log(log::verbose) << "\nChecking invariant: " << data::pp(v_new_invariant) << "\n";
         if (f_invariant_checker.check_invariant(v_new_invariant))
         {
@@ -718,8 +826,8 @@ bool Confluence_Checker<Specification>::check_summands(
           {
             mCRL2log(log::info) << "Not confluent with summand " << a_summand_number_2 << ".";
           }
-          print_counter_example();
-          save_dot_file(a_summand_number_1, a_summand_number_2);
+          print_counter_example(v_result);
+          save_dot_file(a_summand_number_1, a_summand_number_2, v_result.bdd);
         }
       }
       else
@@ -733,8 +841,8 @@ bool Confluence_Checker<Specification>::check_summands(
         {
           mCRL2log(log::info) << "Not confluent with summand " << a_summand_number_2 << ".";
         }
-        print_counter_example();
-        save_dot_file(a_summand_number_1, a_summand_number_2);
+        print_counter_example(v_result);
+        save_dot_file(a_summand_number_1, a_summand_number_2, v_result.bdd);
       }
     }
   }
@@ -743,6 +851,91 @@ bool Confluence_Checker<Specification>::check_summands(
 
 // --------------------------------------------------------------------------------------------
 
+template <typename Specification>
+std::vector<std::optional<typename Confluence_Checker<Specification>::summand_pair_result>>
+Confluence_Checker<Specification>::prove_summand_pairs_in_parallel(
+  const action_summand_type& a_summand,
+  const std::size_t a_summand_number,
+  const data::data_expression& a_invariant,
+  const char a_condition_type)
+{
+  const std::vector<action_summand_type>& v_summands = f_lps.process().action_summands();
+
+  // Determine the summands for which check_summands invokes the prover, in the order in which this happens. The
+  // identifier generator is restored afterwards, such that check_summands generates the same names again.
+  std::vector<std::size_t> v_numbers;
+  std::vector<action_summand_type> v_tagged;
+  const data::set_identifier_generator v_generator = f_set_identifier_generator;
+  for (std::size_t v_summand_number = 1; v_summand_number <= v_summands.size(); ++v_summand_number)
+  {
+    if (v_summand_number < a_summand_number && f_intermediate[v_summand_number] >= a_summand_number)
+    {
+      if (f_intermediate[v_summand_number] == a_summand_number && !f_check_all)
+      {
+        // Not confluent by symmetry, so the remaining summands are not checked.
+        break;
+      }
+      continue;
+    }
+    if ((a_condition_type == 'c' || a_condition_type == 'd') && f_disjointness_checker.disjoint(a_summand_number, v_summand_number))
+    {
+      continue;
+    }
+
+    action_summand_type tagged = v_summands[v_summand_number - 1];
+    if (!f_no_sums)
+    {
+      uniquely_rename_summutation_variables(tagged);
+    }
+    v_numbers.push_back(v_summand_number);
+    v_tagged.push_back(tagged);
+  }
+  f_set_identifier_generator = v_generator;
+
+  // The pairs are taken from a shared work queue in increasing order. If the checking stops at the first summand
+  // that is not confluent, then pairs after the first failure that has been found are skipped; these results are
+  // never used.
+  const bool v_stop_at_failure = !f_check_all && !f_generate_invariants;
+  std::vector<std::optional<summand_pair_result>> v_results(v_tagged.size());
+  std::atomic<std::size_t> v_next(0);
+  std::atomic<std::size_t> v_first_failure(v_tagged.size());
+
+  auto prove_pairs = [&](data::detail::BDD_Prover& prover)
+  {
+    prover.thread_initialise();
+    for (std::size_t i = v_next++; i < v_tagged.size() && i <= v_first_failure.load(); i = v_next++)
+    {
+      v_results[i] = prove_summand_pair(prover, a_invariant, a_summand, v_tagged[i], a_condition_type);
+      if (v_stop_at_failure && (v_results[i]->error || v_results[i]->answer != data::detail::answer_yes))
+      {
+        std::size_t v_failure = v_first_failure.load();
+        while (i < v_failure && !v_first_failure.compare_exchange_weak(v_failure, i))
+        {
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> v_threads;
+  for (std::size_t i = 0; i < f_number_of_threads; ++i)
+  {
+    v_threads.emplace_back(prove_pairs, std::ref(*f_thread_provers[i]));
+  }
+  for (std::thread& t: v_threads)
+  {
+    t.join();
+  }
+
+  std::vector<std::optional<summand_pair_result>> result(v_summands.size() + 1);
+  for (std::size_t i = 0; i < v_numbers.size(); ++i)
+  {
+    result[v_numbers[i]] = std::move(v_results[i]);
+  }
+  return result;
+}
+
+// --------------------------------------------------------------------------------------------
+
 template <typename Specification>
 void Confluence_Checker<Specification>::check_confluence_and_mark_summand(
   action_summand_type& a_summand,
@@ -772,9 +965,16 @@ void Confluence_Checker<Specification>::check_confluence_and_mark_summand(
     }
   }
 
+  std::vector<std::optional<summand_pair_result>> v_results;
+  if (f_number_of_threads > 1 && (v_is_confluent || f_check_all))
+  {
+    v_results = prove_summand_pairs_in_parallel(a_summand, a_summand_number, a_invariant, a_condition_type);
+  }
+
   for (typename std::vector<action_summand_type>::const_iterator i=v_summands.begin(); i!=v_summands.end() && (v_is_confluent || f_check_all); ++i)
   {
     const action_summand_type v_summand = *i;
+    const summand_pair_result* v_result = v_summand_number < v_results.size() && v_results[v_summand_number] ? &*v_results[v_summand_number] : nullptr;
 
     if (v_summand_number < a_summand_number)
     {
@@ -799,13 +999,13 @@ void Confluence_Checker<Specification>::check_confluence_and_mark_summand(
         }
         else
         {
-          v_is_confluent &= check_summands(a_invariant, a_summand, a_summand_number, v_summand, v_summand_number, a_condition_type);
+          v_is_confluent &= check_summands(a_invariant, a_summand, a_summand_number, v_summand, v_summand_number, a_condition_type, v_result);
         }
       }
     }
     else
     {
-      v_is_confluent &= check_summands(a_invariant, a_summand, a_summand_number, v_summand, v_summand_number, a_condition_type);
+      v_is_confluent &= check_summands(a_invariant, a_summand, a_summand_number, v_summand, v_summand_number, a_condition_type, v_result);
     }
     if (v_is_confluent || f_check_all)
     {
@@ -842,19 +1042,38 @@ Confluence_Checker<Specification>::Confluence_Checker(
   std::string a_conditions,
   bool a_counter_example,
   bool a_generate_invariants,
-  std::string const& a_dot_file_name):
+  std::string const& a_dot_file_name,
+  std::size_t a_number_of_threads,
+  const std::shared_ptr<data::detail::BDD_Prover_Cache>& a_prover_cache):
   f_disjointness_checker(a_lps.process()),
-  f_invariant_checker(a_lps, a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, false, false, 0),
+  f_invariant_checker(a_lps, a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, false, false, 0, std::string(), a_prover_cache),
   f_bdd_prover(a_lps.data(), data::used_data_equation_selector(a_lps.data()), a_rewrite_strategy,
-                     a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction),
+                     a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction,
+                     a_path_eliminator ? smt::make_incremental_smt_solver(a_lps.data(), a_solver_type) : nullptr),
   f_lps(a_lps),
   f_check_all(a_check_all),
   f_no_sums(a_no_sums),
   f_conditions(a_conditions),
   f_counter_example(a_counter_example),
   f_dot_file_name(a_dot_file_name),
-  f_generate_invariants(a_generate_invariants)
+  f_generate_invariants(a_generate_invariants),
+  f_number_of_threads(a_number_of_threads)
 {
+  if (a_prover_cache != nullptr)
+  {
+    f_bdd_prover.set_cache(a_prover_cache);
+  }
+
+  if (f_number_of_threads > 1)
+  {
+    for (std::size_t i = 0; i < f_number_of_threads; ++i)
+    {
+      f_thread_provers.emplace_back(new data::detail::BDD_Prover(f_bdd_prover.clone()));
+    }
+    // Cloning initialises the clone for the current thread, so the original prover is initialised again.
+    f_bdd_prover.thread_initialise();
+  }
+
   if (has_ctau_action(a_lps))
   {
     throw mcrl2::runtime_error("An action named \'ctau\' already exists.\n");
@@ -949,6 +1168,12 @@ void Confluence_Checker<Specification>::check_confluence_and_mark(const data::da
   mCRL2log(log::info) << v_marked_summands.size() << " of " << (v_marked_summands.size() + v_unmarked_summands.size()) <<
                          " tau summands were found to be confluent" << std::endl;
 
+  mCRL2log(log::verbose) << f_bdd_prover.cache()->statistics() << std::endl;
+  for (std::size_t i = 0; i < f_thread_provers.size(); ++i)
+  {
+    mCRL2log(log::verbose) << "Thread " << i << ": " << f_thread_provers[i]->cache()->statistics() << std::endl;
+  }
+
   f_intermediate = std::vector<std::size_t>();
 }
 
@@ -12,9 +12,10 @@
 #ifndef MCRL2_LPS_DETAIL_LPS_ALGORITHM_H
 #define MCRL2_LPS_DETAIL_LPS_ALGORITHM_H
 
-#include "mcrl2/data/rewriter.h"
+#include "mcrl2/data/detail/thread_rewriters.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/lps/rewrite.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 namespace mcrl2
 {
@@ -126,6 +127,132 @@ class lps_algorithm
       lps::remove_trivial_summands(m_spec);
     }
 
+    /// \brief Applies f(s, thread_index) to each action and deadlock summand s of the specification, using
+    ///        number_of_threads threads. The calls for different summands must be independent, and thread_index
+    ///        identifies the thread that handles s, such that f can use a rewriter etc. for each thread.
+    template <typename Function>
+    void for_each_summand(Function f, std::size_t number_of_threads = 1)
+    {
+      auto& action_summands = m_spec.process().action_summands();
+      auto& deadlock_summands = m_spec.process().deadlock_summands();
+      const std::size_t n = action_summands.size();
+      utilities::parallel_for(n + deadlock_summands.size(), number_of_threads, [&](std::size_t i, std::size_t thread_index)
+      {
+        if (i < n)
+        {
+          f(action_summands[i], thread_index);
+        }
+        else
+        {
+          f(deadlock_summands[i - n], thread_index);
+        }
+      });
+    }
+
+    /// \brief Replaces each action and deadlock summand s of the specification by the summands that
+    ///        f(s, action_summands, deadlock_summands, thread_index) appends to the given vectors, using
+    ///        number_of_threads threads. The order of the resulting summands does not depend on the number of threads.
+    /// \details Terms that are created by a thread are only protected as long as that thread exists. Therefore the
+    ///          summands that are created by the other threads are passed to the calling thread as terms.
+    template <typename Function>
+    void transform_summands(Function f, std::size_t number_of_threads = 1)
+    {
+      typedef typename Specification::process_type::action_summand_type action_summand_type;
+
+      auto& action_summands = m_spec.process().action_summands();
+      auto& deadlock_summands = m_spec.process().deadlock_summands();
+      const std::size_t n = action_summands.size();
+      std::vector<action_summand_type> new_action_summands;
+      deadlock_summand_vector new_deadlock_summands;
+
+#ifndef MCRL2_THREAD_SAFE
+      number_of_threads = 1;
+#endif
+      if (number_of_threads <= 1)
+      {
+        for (const action_summand_type& s: action_summands)
+        {
+          f(s, new_action_summands, new_deadlock_summands, 0);
+        }
+        for (const deadlock_summand& s: deadlock_summands)
+        {
+          f(s, new_action_summands, new_deadlock_summands, 0);
+        }
+      }
+      else
+      {
+        std::vector<atermpp::aterm_list> results(n + deadlock_summands.size());
+        utilities::parallel_for(results.size(), number_of_threads, [&](std::size_t i, std::size_t thread_index)
+        {
+          std::vector<action_summand_type> result_action_summands;
+          deadlock_summand_vector result_deadlock_summands;
+          if (i < n)
+          {
+            f(action_summands[i], result_action_summands, result_deadlock_summands, thread_index);
+          }
+          else
+          {
+            f(deadlock_summands[i - n], result_action_summands, result_deadlock_summands, thread_index);
+          }
+          std::vector<atermpp::aterm_appl> result;
+          for (const action_summand_type& s: result_action_summands)
+          {
+            result.push_back(action_summand_to_aterm(s));
+          }
+          for (const deadlock_summand& s: result_deadlock_summands)
+          {
+            result.push_back(deadlock_summand_to_aterm(s));
+          }
+          results[i] = atermpp::aterm_list(result.begin(), result.end());
+        });
+
+        for (const atermpp::aterm_list& result: results)
+        {
+          for (const atermpp::aterm& x: result)
+          {
+            const auto& t = atermpp::down_cast<atermpp::aterm_appl>(x);
+            const auto& summation_variables = atermpp::down_cast<data::variable_list>(t[0]);
+            const auto& condition = atermpp::down_cast<data::data_expression>(t[1]);
+            const auto& time = atermpp::down_cast<data::data_expression>(t[3]);
+            if (atermpp::down_cast<atermpp::aterm_appl>(t[2]).function() == core::detail::function_symbols::Delta)
+            {
+              new_deadlock_summands.push_back(deadlock_summand(summation_variables, condition, deadlock(time)));
+            }
+            else
+            {
+              const auto& actions = atermpp::down_cast<process::action_list>(atermpp::down_cast<atermpp::aterm_appl>(t[2])[0]);
+              new_action_summands.push_back(make_action_summand<action_summand_type>(summation_variables, condition,
+                                            multi_action(actions, time), atermpp::down_cast<data::assignment_list>(t[4]),
+                                            atermpp::down_cast<stochastic_distribution>(t[5])));
+            }
+          }
+        }
+      }
+      action_summands.swap(new_action_summands);
+      deadlock_summands.swap(new_deadlock_summands);
+    }
+
+    /// \brief Rewrites the specification with R. The summands are rewritten by number_of_threads threads, each
+    ///        with its own clone of R.
+    void rewrite(data::rewriter& R, std::size_t number_of_threads = 1)
+    {
+      data::detail::thread_rewriters<> rewriters(R, number_of_threads);
+      for_each_summand([&](auto& summand, std::size_t thread_index)
+                       {
+                         lps::rewrite(summand, rewriters[thread_index]);
+                       },
+                       number_of_threads);
+
+      // Rewrite the remainder of the specification, such as the initial state, without the summands.
+      std::vector<typename Specification::process_type::action_summand_type> action_summands;
+      deadlock_summand_vector deadlock_summands;
+      action_summands.swap(m_spec.process().action_summands());
+      deadlock_summands.swap(m_spec.process().deadlock_summands());
+      lps::rewrite(m_spec, R);
+      action_summands.swap(m_spec.process().action_summands());
+      deadlock_summands.swap(m_spec.process().deadlock_summands());
+    }
+
     /// \brief Removes unused summand variables.
     void remove_unused_summand_variables()
     {
@@ -16,6 +16,8 @@
 #include <thread>
 #include <type_traits>
 #include "mcrl2/utilities/detail/io.h"
+#include "mcrl2/utilities/instrumentation.h"
+#include "mcrl2/utilities/memory_accounting.h"
 #include "mcrl2/utilities/skip.h"
 #include "mcrl2/atermpp/standard_containers/deque.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
@@ -34,6 +36,14 @@
 
 namespace mcrl2::lps {
 
+namespace detail
+{
+
+/// \brief Counts the transitions generated by the explorer when tracing is enabled.
+inline const utilities::trace_counter explored_transition_counter("explored transitions");
+
+} // namespace detail
+
 enum class caching { none, local, global };
 
 inline
@@ -55,10 +65,19 @@ std::vector<data::data_expression> make_data_expression_vector(const data::data_
   return std::vector<data::data_expression>(v.begin(), v.end());
 }
 
+/// \brief An allocator that accounts the memory of the data structures of the explorer.
+template <typename T>
+using explorer_allocator = utilities::accounting_allocator<T, utilities::memory_subsystem::explorer>;
+
+/// \brief The set of discovered states, which assigns a unique number to every state.
+typedef atermpp::indexed_set<state, atermpp::detail::GlobalThreadSafe, std::hash<state>, std::equal_to<state>,
+                             explorer_allocator<state>,
+                             atermpp::deque<state, explorer_allocator<atermpp::detail::reference_aterm<state>>>> indexed_set_for_states_type;
+
 class todo_set
 {
   protected:
-    atermpp::deque<state> todo;
+    atermpp::deque<state, explorer_allocator<atermpp::detail::reference_aterm<state>>> todo;
 
   public:
     explicit todo_set(const state& init)
@@ -339,8 +358,6 @@ class explorer: public abortable
     static constexpr bool is_stochastic = Stochastic;
     static constexpr bool is_timed = Timed;
 
-    typedef atermpp::indexed_set<state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
-
   protected:
     using enumerator_element = data::enumerator_list_element_with_substitution<>;
 
@@ -950,6 +967,7 @@ class explorer: public abortable
     {
       thread_rewr.thread_initialise();
       mCRL2log(log::debug) << "Start thread " << thread_index << ".\n";
+      utilities::trace_span thread_span("explorer thread");
       data::enumerator_identifier_generator thread_id_generator("t_");;
       data::data_specification thread_data_specification = m_global_lpsspec.data(); /// XXXX Nodig??
       data::enumerator_algorithm<> thread_enumerator(thread_rewr, thread_data_specification, thread_rewr, thread_id_generator, false);
@@ -961,11 +979,12 @@ class explorer: public abortable
       while (number_of_active_processes>0)
       {
         if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
-        while (!todo->empty() && !m_must_abort)
+        while (!todo->empty() && !m_must_abort && !utilities::memory_budget_exceeded())
         { 
           todo->choose_element(current_state);
           std::size_t s_index = discovered.index(current_state,thread_index);
           if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
+          utilities::trace_span state_span("explore state");
           start_state(thread_index, current_state, s_index);
           data::add_assignments(thread_sigma, m_process_parameters, current_state);
           for (const explorer_summand& summand: regular_summands)
@@ -982,6 +1001,7 @@ class explorer: public abortable
               thread_id_generator,
               [&](const lps::multi_action& a, const state_type& s1)
               {   
+                detail::explored_transition_counter.add();
                 if constexpr (Timed)
                 { 
                   const data::data_expression& t = current_state[m_n];
@@ -1178,6 +1198,7 @@ class explorer: public abortable
       }
 
       m_must_abort = false;
+      utilities::check_memory_budget();
     }
 
     /// \brief Generates the state space, and reports all discovered states and transitions by means of callback
@@ -1464,7 +1485,7 @@ std::cerr << "DFS EXPLORATION NOT THREAD SAFE\n";
       discovered.insert(s0);
       discover_state(s0);
 
-      while (!todo.empty() && !m_must_abort)
+      while (!todo.empty() && !m_must_abort && !utilities::memory_budget_exceeded())
       {
         const state* s = &todo.back().first;
         std::list<transition>* E = &todo.back().second;
@@ -1514,6 +1535,7 @@ std::cerr << "DFS EXPLORATION NOT THREAD SAFE\n";
         finish_state(0, *s);  // TODO: Make thread safe
       }
       m_must_abort = false;
+      utilities::check_memory_budget();
     }
 
     template <
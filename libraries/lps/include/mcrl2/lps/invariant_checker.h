@@ -17,6 +17,7 @@
 #include "mcrl2/data/detail/prover/bdd_prover.h"
 #include "mcrl2/data/detail/prover/bdd2dot.h"
 #include "mcrl2/lps/stochastic_specification.h"
+#include "mcrl2/smt/incremental_solver.h"
 
 /// The class Invariant_Checker is initialized with an LPS using the constructor Invariant_Checker::Invariant_Checker.
 /// After initialization, the function Invariant_Checker::check_invariant can be called any number of times to check
@@ -47,6 +48,9 @@
 /// proven does not hold. If the parameter a_all_violations is set to true, the invariant checker will not stop as soon as
 /// a violation of the invariant is found, but will report all violations instead.
 ///
+/// If a_prover_cache is not nullptr, the prover stores the BDDs of the formulas it encounters in these caches, which
+/// can be shared with other provers for the same data specification and rewrite strategy.
+///
 /// Given an LPS,
 ///
 ///    P(d: D) = ...
@@ -103,7 +107,8 @@ class Invariant_Checker
       bool a_apply_induction = false,
       bool a_counter_example = false,
       bool a_all_violations = false,
-      const std::string& a_dot_file_name = std::string()
+      const std::string& a_dot_file_name = std::string(),
+      const std::shared_ptr<data::detail::BDD_Prover_Cache>& a_prover_cache = nullptr
     );
 
     /// precondition: the argument passed as parameter a_invariant is a valid expression in internal mCRL2 format
@@ -238,11 +243,17 @@ template <typename Specification>
 Invariant_Checker<Specification>::Invariant_Checker(
   const Specification& a_lps,
   data::rewriter::strategy a_rewrite_strategy, int a_time_limit, bool a_path_eliminator, data::detail::smt_solver_type a_solver_type,
-  bool a_apply_induction, bool a_counter_example, bool a_all_violations, std::string const& a_dot_file_name
+  bool a_apply_induction, bool a_counter_example, bool a_all_violations, std::string const& a_dot_file_name,
+  const std::shared_ptr<data::detail::BDD_Prover_Cache>& a_prover_cache
 ):
   f_spec(a_lps),
-  f_bdd_prover(a_lps.data(), data::used_data_equation_selector(a_lps.data()), a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction)
+  f_bdd_prover(a_lps.data(), data::used_data_equation_selector(a_lps.data()), a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction,
+               a_path_eliminator ? smt::make_incremental_smt_solver(a_lps.data(), a_solver_type) : nullptr)
 {
+  if (a_prover_cache != nullptr)
+  {
+    f_bdd_prover.set_cache(a_prover_cache);
+  }
   f_init = a_lps.initial_process();
   f_summands = a_lps.process().action_summands();
   f_counter_example = a_counter_example;
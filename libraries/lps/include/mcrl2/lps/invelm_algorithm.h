@@ -123,12 +123,19 @@ class invelm_algorithm: public detail::lps_algorithm<Specification>
       const bool a_path_eliminator = false,
       const data::detail::smt_solver_type a_solver_type = data::detail::solver_type_cvc,
       const bool a_apply_induction = false,
-      const bool a_simplify_all = false
+      const bool a_simplify_all = false,
+      const std::shared_ptr<data::detail::BDD_Prover_Cache>& a_prover_cache = nullptr
     )
       : detail::lps_algorithm<Specification>(a_lps),
-        f_bdd_prover(a_lps.data(), data::used_data_equation_selector(a_lps.data()),a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction),
+        f_bdd_prover(a_lps.data(), data::used_data_equation_selector(a_lps.data()),a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction,
+                     a_path_eliminator ? smt::make_incremental_smt_solver(a_lps.data(), a_solver_type) : nullptr),
         f_simplify_all(a_simplify_all)
-    {}
+    {
+      if (a_prover_cache != nullptr)
+      {
+        f_bdd_prover.set_cache(a_prover_cache);
+      }
+    }
 
     void run(const data::data_expression& invariant, bool apply_prover)
     {
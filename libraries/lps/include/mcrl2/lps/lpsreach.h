@@ -22,9 +22,11 @@
 #include "mcrl2/lps/replace_constants_by_variables.h"
 #include "mcrl2/lps/resolve_name_clashes.h"
 #include "mcrl2/lps/symbolic_lts.h"
+#include "mcrl2/symbolic/exploration_checkpoint.h"
 #include "mcrl2/symbolic/ordering.h"
 #include "mcrl2/symbolic/print.h"
 #include "mcrl2/symbolic/symbolic_reachability.h"
+#include "mcrl2/utilities/instrumentation.h"
 #include "mcrl2/utilities/parse_numbers.h"
 #include "mcrl2/utilities/stack_array.h"
 #include "mcrl2/utilities/stopwatch.h"
@@ -45,6 +47,12 @@ class lpsreach_algorithm
     template <typename Context, bool ActionLabel>
     friend void symbolic::learn_successors_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
 
+    template <typename Context, bool ActionLabel>
+    friend void symbolic::learn_successors_parallel_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
+
+    template <typename Context, bool ActionLabel>
+    friend void symbolic::add_learned_successors(Context& context);
+
   protected:
     const symbolic::symbolic_reachability_options& m_options;
     data::rewriter m_rewr;
@@ -55,6 +63,13 @@ class lpsreach_algorithm
     std::vector<boost::dynamic_bitset<>> m_group_patterns;
     std::vector<std::size_t> m_variable_order;
     symbolic_lts m_lts;
+    std::vector<std::unique_ptr<symbolic::learn_worker>> m_learn_workers; // used for learning transitions in parallel
+
+    // The state of the exploration, which is kept such that it can be saved and resumed.
+    ldd m_visited;
+    ldd m_todo;
+    ldd m_deadlocks;
+    std::size_t m_iteration_count = 0;
     
     /// \brief Rewrites all arguments of the given action.
     template<typename Rewriter, typename Substitution>
@@ -78,13 +93,37 @@ class lpsreach_algorithm
     }
 
     // R.L := R.L U {(x,y) in R | x in X}
-    void learn_successors(std::size_t i, symbolic::summand_group& R, const ldd& X)
+    void learn_successors(std::size_t i, lps_summand_group& R, const ldd& X)
     {
+      utilities::trace_span span("learn transitions");
       mCRL2log(log::debug1) << "learn successors of summand group " << i << " for X = " << print_states(m_lts.data_index, X, R.read) << std::endl;
 
       using namespace sylvan::ldds;
-      std::pair<lpsreach_algorithm&, symbolic::summand_group&> context{*this, R};
-      sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>, &context);
+      if (symbolic::parallel_learning_enabled())
+      {
+        symbolic::learn_successors_parallel<lps::multi_action, true>(*this, std::vector<lps_summand_group*>{ &R }, std::vector<ldd>{ X }, m_learn_workers, m_rewr, m_lts.data_spec);
+      }
+      else
+      {
+        std::pair<lpsreach_algorithm&, lps_summand_group&> context{*this, R};
+        sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>, &context);
+      }
+    }
+
+    // R[i].L := R[i].L U {(x,y) in R[i] | x in X} for all summand groups R[i], where the groups are learned concurrently
+    void learn_successors_all_groups(const ldd& X)
+    {
+      utilities::trace_span span("learn transitions");
+      using namespace sylvan::ldds;
+      std::vector<lps_summand_group*> groups;
+      std::vector<ldd> projections;
+      for (lps_summand_group& R: m_lts.summand_groups)
+      {
+        ldd proj = project(X, R.Ip);
+        groups.push_back(&R);
+        projections.push_back(m_options.cached ? minus(proj, R.Ldomain) : proj);
+      }
+      symbolic::learn_successors_parallel<lps::multi_action, true>(*this, groups, projections, m_learn_workers, m_rewr, m_lts.data_spec);
     }
 
     template <typename Specification>
@@ -120,6 +159,7 @@ class lpsreach_algorithm
       using utilities::detail::as_vector;
 
       lps::specification lpsspec_ = preprocess(lpsspec);
+      m_lts.data_spec = lpsspec_.data();
       m_lts.process_parameters = lpsspec_.process().process_parameters();
 
       // Rewrite the initial expressions to normal form,
@@ -134,7 +174,7 @@ class lpsreach_algorithm
       m_summand_patterns = compute_read_write_patterns(lpsspec_);
       symbolic::adjust_read_write_patterns(m_summand_patterns, m_options);
 
-      m_variable_order = symbolic::compute_variable_order(m_options.variable_order, m_lts.process_parameters.size());
+      m_variable_order = symbolic::compute_variable_order(m_options.variable_order, m_lts.process_parameters.size(), m_summand_patterns);
       mCRL2log(log::debug) << "variable order = " << core::detail::print_list(m_variable_order) << std::endl;
       m_summand_patterns = symbolic::reorder_read_write_patterns(m_summand_patterns, m_variable_order);
       mCRL2log(log::debug) << symbolic::print_read_write_patterns(m_summand_patterns);
@@ -163,6 +203,10 @@ class lpsreach_algorithm
       {
         mCRL2log(log::debug) << "=== summand group " << i << " ===\n" << m_lts.summand_groups[i] << std::endl;
       }
+
+      m_visited = sylvan::ldds::empty_set();
+      m_todo = m_lts.initial_state;
+      m_deadlocks = sylvan::ldds::empty_set();
     }
 
     /// \brief Computes relprod(U, group).
@@ -186,6 +230,7 @@ class lpsreach_algorithm
     /// \returns The tuple <visited, todo, deadlocks>
     std::tuple<ldd, ldd, ldd> step(const ldd& visited, const ldd& todo, bool learn_transitions = true, bool detect_deadlocks = false)
     {
+      utilities::trace_span span("reachability step");
       using namespace sylvan::ldds;
       auto& R = m_lts.summand_groups;
 
@@ -197,12 +242,22 @@ class lpsreach_algorithm
         // regular and chaining.
         todo1 = m_options.chaining ? todo : empty_set();
 
+        // Without chaining all summand groups learn from todo, so they can be learned concurrently.
+        bool learn_all_groups = learn_transitions && !m_options.chaining && symbolic::parallel_learning_enabled();
+        if (learn_all_groups)
+        {
+          learn_successors_all_groups(todo);
+        }
+
         for (std::size_t i = 0; i < R.size(); i++)
         {
           if (learn_transitions)
           {
-            ldd proj = project(m_options.chaining ? todo1 : todo, R[i].Ip);
-            learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
+            if (!learn_all_groups)
+            {
+              ldd proj = project(m_options.chaining ? todo1 : todo, R[i].Ip);
+              learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
+            }
 
             mCRL2log(log::debug1) << "L =\n" << print_relation(m_lts.data_index, R[i].L, R[i].read, R[i].write) << std::endl;
           }
@@ -264,20 +319,19 @@ class lpsreach_algorithm
       return std::make_tuple(union_(visited, todo), minus(todo1, visited), potential_deadlocks);
     }
 
-    ldd run()
+    ldd run(bool report_states = true)
     {
       using namespace sylvan::ldds;
       auto& R = m_lts.summand_groups;
-      std::size_t iteration_count = 0;
+      std::size_t& iteration_count = m_iteration_count;
 
       mCRL2log(log::debug1) << "initial state = " << core::detail::print_list(m_lts.initial_state) << std::endl;
 
       auto start = std::chrono::steady_clock::now();
-      ldd x = m_lts.initial_state;
       std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
-      ldd visited = empty_set();
-      ldd todo = x;
-      ldd deadlocks = empty_set();
+      ldd& visited = m_visited;
+      ldd& todo = m_todo;
+      ldd& deadlocks = m_deadlocks;
 
       while (todo != empty_set() && (m_options.max_iterations == 0 || iteration_count < m_options.max_iterations))
       {
@@ -297,10 +351,27 @@ class lpsreach_algorithm
         }
 
         sylvan::sylvan_stats_report(stderr);
+
+        if (!m_options.checkpoint_file.empty() && m_options.checkpoint_interval > 0 && iteration_count % m_options.checkpoint_interval == 0)
+        {
+          save_checkpoint(m_options.checkpoint_file);
+        }
+      }
+
+      if (!m_options.checkpoint_file.empty())
+      {
+        save_checkpoint(m_options.checkpoint_file);
       }
 
       elapsed_seconds = std::chrono::steady_clock::now() - start;
-      std::cout << "number of states = " << print_size(visited) << " (time = " << std::setprecision(2) << std::fixed << elapsed_seconds.count() << "s)" << std::endl;
+      if (report_states)
+      {
+        std::cout << "number of states = " << print_size(visited) << " (time = " << std::setprecision(2) << std::fixed << elapsed_seconds.count() << "s)" << std::endl;
+      }
+      else
+      {
+        mCRL2log(log::verbose) << "number of states = " << print_size(visited) << " (time = " << std::setprecision(2) << std::fixed << elapsed_seconds.count() << "s)" << std::endl;
+      }
       mCRL2log(log::verbose) << "used variable order = " << core::detail::print_list(m_variable_order) << std::endl;
 
       double total_time = 0.0;
@@ -358,6 +429,59 @@ class lpsreach_algorithm
       return m_lts.action_index;
     }
 
+    /// \brief Returns the state of the exploration, which can be used to resume it later on.
+    symbolic::exploration_checkpoint make_checkpoint() const
+    {
+      symbolic::exploration_checkpoint result;
+      result.process_parameters = m_lts.process_parameters;
+      result.data_index = m_lts.data_index;
+      result.action_labels.assign(m_lts.action_index.begin(), m_lts.action_index.end());
+      result.initial_state = m_lts.initial_state;
+      result.visited = m_visited;
+      result.todo = m_todo;
+      result.deadlocks = m_deadlocks;
+      for (const lps_summand_group& group: m_lts.summand_groups)
+      {
+        result.summand_groups.push_back(symbolic::make_summand_group_checkpoint(group));
+      }
+      result.iteration_count = m_iteration_count;
+      return result;
+    }
+
+    void save_checkpoint(const std::string& filename) const
+    {
+      mCRL2log(log::verbose) << "saving checkpoint to " << filename << " after " << m_iteration_count << " iterations" << std::endl;
+      symbolic::save_exploration_checkpoint(filename, make_checkpoint());
+    }
+
+    /// \brief Continues the exploration from the checkpoint. The learned transition relations and the data indices
+    ///        are reused, hence the checkpoint must have been created for the same LPS and options.
+    void load_checkpoint(const symbolic::exploration_checkpoint& checkpoint)
+    {
+      symbolic::check_exploration_checkpoint(checkpoint, m_lts.process_parameters, m_lts.data_index, m_lts.initial_state, m_lts.summand_groups.size());
+      for (std::size_t i = 0; i < m_lts.summand_groups.size(); i++)
+      {
+        symbolic::restore_summand_group(m_lts.summand_groups[i], checkpoint.summand_groups[i], i);
+      }
+      m_lts.data_index = checkpoint.data_index;
+      m_lts.action_index.clear();
+      for (const atermpp::aterm& label: checkpoint.action_labels)
+      {
+        m_lts.action_index.insert(lps::multi_action(label));
+      }
+      m_lts.initial_state = checkpoint.initial_state;
+      m_visited = checkpoint.visited;
+      m_todo = checkpoint.todo;
+      m_deadlocks = checkpoint.deadlocks;
+      m_iteration_count = checkpoint.iteration_count;
+      mCRL2log(log::verbose) << "resuming from a checkpoint after " << m_iteration_count << " iterations" << std::endl;
+    }
+
+    const std::vector<lps_summand_group>& summand_groups() const
+    {
+      return m_lts.summand_groups;
+    }
+
     const symbolic_lts& get_symbolic_lts()
     {
       return m_lts;
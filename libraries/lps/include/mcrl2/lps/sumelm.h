@@ -18,6 +18,7 @@
 #ifndef MCRL2_LPS_SUMELM_H
 #define MCRL2_LPS_SUMELM_H
 
+#include <numeric>
 #include "mcrl2/lps/decluster.h"
 
 namespace mcrl2
@@ -39,6 +40,9 @@ class sumelm_algorithm: public detail::lps_algorithm<Specification>
     /// Whether to decluster disjunctive conditions first.
     bool m_decluster;
 
+    /// The number of threads that process the summands.
+    std::size_t m_number_of_threads;
+
     /// Adds replacement lhs := rhs to the specified map of replacements.
     /// All replacements that have lhs as a right hand side will be changed to
     /// have rhs as a right hand side.
@@ -159,16 +163,52 @@ class sumelm_algorithm: public detail::lps_algorithm<Specification>
       return data::join_and(new_conjuncts.begin(), new_conjuncts.end());
     }
 
+    /// \brief Applies the sum elimination lemma to summand s.
+    /// \return The number of summation variables that has been removed.
+    std::size_t apply_sumelm(action_summand& s)
+    {
+      data::mutable_map_substitution<> substitutions;
+      s.condition() = compute_substitutions(s, substitutions);
+
+      // temporarily remove the summation variables, otherwise the capture avoiding substitution will touch them
+      const data::variable_list summmation_variables = s.summation_variables();
+      s.summation_variables() = data::variable_list();
+
+      lps::replace_variables_capture_avoiding(s, substitutions);
+
+      // restore the summation variables
+      s.summation_variables() = summmation_variables;
+
+      const std::size_t var_count = s.summation_variables().size();
+      super::summand_remove_unused_summand_variables(s);
+      return var_count - s.summation_variables().size();
+    }
+
+    /// \brief Applies the sum elimination lemma to summand s.
+    /// \return The number of summation variables that has been removed.
+    std::size_t apply_sumelm(deadlock_summand& s)
+    {
+      data::mutable_map_substitution<> substitutions;
+      s.condition() = compute_substitutions(s, substitutions);
+      lps::replace_variables_capture_avoiding(s, substitutions);
+
+      const std::size_t var_count = s.summation_variables().size();
+      super::summand_remove_unused_summand_variables(s);
+      return var_count - s.summation_variables().size();
+    }
+
   public:
     /// \brief Constructor.
     /// \param spec The specification to which sum elimination should be
     ///             applied.
     /// \param decluster Control whether disjunctive conditions need to be split
     ///        into multiple summands.
-    sumelm_algorithm(Specification& spec, bool decluster = false)
+    /// \param number_of_threads The number of threads that process the summands.
+    sumelm_algorithm(Specification& spec, bool decluster = false, std::size_t number_of_threads = 1)
       : lps::detail::lps_algorithm<Specification>(spec),
         m_removed(0),
-        m_decluster(decluster)
+        m_decluster(decluster),
+        m_number_of_threads(number_of_threads)
     {}
 
     /// \brief Apply the sum elimination lemma to all summands in the
@@ -181,17 +221,14 @@ class sumelm_algorithm: public detail::lps_algorithm<Specification>
         decluster_algorithm<Specification>(m_spec).run();
       }
 
-      m_removed = 0; // Re-initialise number of removed variables for a fresh run.
-
-      for (action_summand& s: m_spec.process().action_summands())
-      {
-        (*this)(s);
-      }
-
-      for (deadlock_summand& s: m_spec.process().deadlock_summands())
-      {
-        (*this)(s);
-      }
+      // The summands are independent, so each thread counts the variables it removes.
+      std::vector<std::size_t> removed(std::max(m_number_of_threads, std::size_t(1)), 0);
+      super::for_each_summand([&](auto& s, std::size_t thread_index)
+                              {
+                                removed[thread_index] += apply_sumelm(s);
+                              },
+                              m_number_of_threads);
+      m_removed = std::accumulate(removed.begin(), removed.end(), std::size_t(0));
 
       mCRL2log(log::verbose) << "Removed " << m_removed << " summation variables" << std::endl;
     }
@@ -200,34 +237,14 @@ class sumelm_algorithm: public detail::lps_algorithm<Specification>
     /// \param s an action_summand.
     void operator()(action_summand& s)
     {
-      data::mutable_map_substitution<> substitutions;
-      s.condition() = compute_substitutions(s, substitutions);
-
-      // temporarily remove the summation variables, otherwise the capture avoiding substitution will touch them
-      const data::variable_list summmation_variables = s.summation_variables();
-      s.summation_variables() = data::variable_list();
-
-      lps::replace_variables_capture_avoiding(s, substitutions);
-
-      // restore the summation variables
-      s.summation_variables() = summmation_variables;
-
-      const std::size_t var_count = s.summation_variables().size();
-      super::summand_remove_unused_summand_variables(s);
-      m_removed += var_count - s.summation_variables().size();
+      m_removed += apply_sumelm(s);
     }
 
     /// \brief Apply the sum elimination lemma to summand s.
     /// \param s a deadlock_summand.
     void operator()(deadlock_summand& s)
     {
-      data::mutable_map_substitution<> substitutions;
-      s.condition() = compute_substitutions(s, substitutions);
-      lps::replace_variables_capture_avoiding(s, substitutions);
-
-      const std::size_t var_count = s.summation_variables().size();
-      super::summand_remove_unused_summand_variables(s);
-      m_removed += var_count - s.summation_variables().size();
+      m_removed += apply_sumelm(s);
     }
 
     /// \brief Returns the amount of removed summation variables.
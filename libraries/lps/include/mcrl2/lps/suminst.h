@@ -12,6 +12,8 @@
 #ifndef MCRL2_LPS_SUMINST_H
 #define MCRL2_LPS_SUMINST_H
 
+#include <atomic>
+#include <memory>
 #include "mcrl2/atermpp/set_operations.h"
 
 #include "mcrl2/data/enumerator.h"
@@ -54,6 +56,9 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
     /// Sorts to be instantiated
     std::set<data::sort_expression> m_sorts;
 
+    /// The sorts in m_sorts that are certainly finite
+    std::set<data::sort_expression> m_finite_sorts;
+
     /// Only instantiate tau summands
     bool m_tau_summands_only;
 
@@ -67,8 +72,20 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
     std::size_t m_deleted;
     std::size_t m_added;
 
+    /// The number of threads that instantiate the summands
+    std::size_t m_number_of_threads;
+
     template <typename SummandType, typename Container>
     std::size_t instantiate_summand(const SummandType& s, Container& result)
+    {
+      return instantiate_summand(s, result, m_rewriter, m_enumerator);
+    }
+
+    template <typename SummandType, typename Container>
+    std::size_t instantiate_summand(const SummandType& s,
+                                    Container& result,
+                                    const DataRewriter& rewriter,
+                                    data::enumerator_algorithm<>& enumerator)
     {
       using namespace data;
       std::size_t nr_summands = 0; // Counter for the number of new summands, used for verbose output
@@ -79,7 +96,7 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
       {
         if(m_sorts.find(v.sort()) != m_sorts.end())
         {
-          if (m_spec.data().is_certainly_finite(v.sort()))
+          if (m_finite_sorts.find(v.sort()) != m_finite_sorts.end())
           {
             variables.push_front(v);
           }
@@ -107,21 +124,21 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
         {
           mCRL2log(log::debug, "suminst") << "enumerating variables " << vl << " in condition: " << data::pp(s.condition()) << std::endl;
           data::mutable_indexed_substitution<> local_sigma;
-          m_enumerator.enumerate(enumerator_element(vl, s.condition()),
-                                 local_sigma,
-                                 [&](const enumerator_element& p)
-                                 {
-                                   mutable_indexed_substitution<> sigma;
-                                   p.add_assignments(vl, sigma, m_rewriter);
-                                   mCRL2log(log::debug, "suminst") << "substitutions: " << sigma << std::endl;
-                                   SummandType t(s);
-                                   t.summation_variables() = new_summation_variables;
-                                   lps::rewrite(t, m_rewriter, sigma);
-                                   result.push_back(t);
-                                   ++nr_summands;
-                                   return false;
-                                 },
-                                 sort_bool::is_false_function_symbol
+          enumerator.enumerate(enumerator_element(vl, s.condition()),
+                               local_sigma,
+                               [&](const enumerator_element& p)
+                               {
+                                 mutable_indexed_substitution<> sigma;
+                                 p.add_assignments(vl, sigma, rewriter);
+                                 mCRL2log(log::debug, "suminst") << "substitutions: " << sigma << std::endl;
+                                 SummandType t(s);
+                                 t.summation_variables() = new_summation_variables;
+                                 lps::rewrite(t, rewriter, sigma);
+                                 result.push_back(t);
+                                 ++nr_summands;
+                                 return false;
+                               },
+                               sort_bool::is_false_function_symbol
           );
         }
         catch (mcrl2::runtime_error const& e)
@@ -177,11 +194,82 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
       }
     }
 
+    /// \brief Instantiates the summands using m_number_of_threads threads, each with its own rewriter and enumerator.
+    void run_parallel()
+    {
+      // Each thread other than the calling thread gets a copy of the data specification, as the enumerator
+      // updates the caches of the data specification.
+      const std::size_t number_of_threads = m_number_of_threads;
+      data::detail::thread_rewriters<DataRewriter> rewriters(m_rewriter, number_of_threads);
+      std::deque<data::data_specification> data_specifications(number_of_threads - 1, m_spec.data());
+      std::deque<data::enumerator_identifier_generator> id_generators(number_of_threads - 1);
+      std::vector<std::unique_ptr<data::enumerator_algorithm<>>> enumerators(number_of_threads);
+      std::atomic<std::size_t> processed(0);
+      std::atomic<std::size_t> added(0);
+      std::atomic<std::size_t> deleted(0);
+
+      super::transform_summands([&](const auto& s, auto& action_summands, auto& deadlock_summands, std::size_t thread_index)
+      {
+        auto& result = select_result(s, action_summands, deadlock_summands);
+        if (must_instantiate(s))
+        {
+          std::size_t newsummands;
+          if (thread_index == 0)
+          {
+            newsummands = instantiate_summand(s, result);
+          }
+          else
+          {
+            DataRewriter& rewriter = rewriters[thread_index];
+            if (!enumerators[thread_index])
+            {
+              enumerators[thread_index] = std::make_unique<data::enumerator_algorithm<>>(rewriter,
+                                                    data_specifications[thread_index - 1], rewriter, id_generators[thread_index - 1], false);
+            }
+            newsummands = instantiate_summand(s, result, rewriter, *enumerators[thread_index]);
+          }
+          if (newsummands > 0)
+          {
+            added += newsummands - 1;
+          }
+          else
+          {
+            ++deleted;
+          }
+        }
+        else
+        {
+          result.push_back(s);
+        }
+        ++processed;
+        if (thread_index == 0)
+        {
+          mCRL2log(log::status) << "Replaced " << processed.load() << " summands by " << (processed + added - deleted)
+                                << " summands (" << deleted.load() << " were deleted)" << std::endl;
+        }
+      }, number_of_threads);
+
+      m_processed = processed;
+      m_added = added;
+      m_deleted = deleted;
+    }
+
+    action_summand_vector_type& select_result(const action_summand_type&, action_summand_vector_type& action_summands, deadlock_summand_vector&)
+    {
+      return action_summands;
+    }
+
+    deadlock_summand_vector& select_result(const deadlock_summand&, action_summand_vector_type&, deadlock_summand_vector& deadlock_summands)
+    {
+      return deadlock_summands;
+    }
+
   public:
     suminst_algorithm(Specification& spec,
                       DataRewriter& r,
                       std::set<data::sort_expression> sorts = std::set<data::sort_expression>(),
-                      bool tau_summands_only = false)
+                      bool tau_summands_only = false,
+                      std::size_t number_of_threads = 1)
       : detail::lps_algorithm<Specification>(spec),
         m_sorts(sorts),
         m_tau_summands_only(tau_summands_only),
@@ -189,13 +277,24 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
         m_enumerator(r, spec.data(), r, m_id_generator, false),
         m_processed(0),
         m_deleted(0),
-        m_added(0)
+        m_added(0),
+        m_number_of_threads(number_of_threads)
     {
       if(sorts.empty())
       {
         mCRL2log(log::info, "suminst") << "an empty set of sorts to be unfolded was provided; defaulting to all finite sorts" << std::endl;
         m_sorts = finite_sorts(spec.data());
       }
+      for (const data::sort_expression& sort: m_sorts)
+      {
+        if (spec.data().is_certainly_finite(sort))
+        {
+          m_finite_sorts.insert(sort);
+        }
+      }
+#ifndef MCRL2_THREAD_SAFE
+      m_number_of_threads = 1;
+#endif
     }
 
     void run()
@@ -205,10 +304,17 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
       m_added = 0;
       m_deleted = 0;
       m_processed = 0;
-      run(m_spec.process().action_summands(), action_summands);
-      run(m_spec.process().deadlock_summands(), deadlock_summands);
-      m_spec.process().action_summands().swap(action_summands);
-      m_spec.process().deadlock_summands().swap(deadlock_summands);
+      if (m_number_of_threads > 1)
+      {
+        run_parallel();
+      }
+      else
+      {
+        run(m_spec.process().action_summands(), action_summands);
+        run(m_spec.process().deadlock_summands(), deadlock_summands);
+        m_spec.process().action_summands().swap(action_summands);
+        m_spec.process().deadlock_summands().swap(deadlock_summands);
+      }
       mCRL2log(log::status) << std::endl;
     }
 
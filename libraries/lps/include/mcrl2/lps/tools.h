@@ -13,6 +13,7 @@
 #define MCRL2_LPS_TOOLS_H
 
 #include "mcrl2/core/print.h"
+#include "mcrl2/data/detail/prover/bdd_prover_cache.h"
 #include "mcrl2/data/detail/prover/solver_type.h"
 #include "mcrl2/lps/lps_rewriter_type.h"
 #include "mcrl2/data/rewriter.h"
@@ -51,7 +52,8 @@ bool lpsinvelm(const std::string& input_filename,
                const bool counter_example,
                const bool path_eliminator,
                const bool apply_induction,
-               const int time_limit
+               const int time_limit,
+               const std::size_t prover_cache_size = data::detail::BDD_Prover_Cache::default_size
               );
 
 void lpsparelm(const std::string& input_filename,
@@ -67,19 +69,22 @@ void lpspp(const std::string& input_filename,
 void lpsrewr(const std::string& input_filename,
              const std::string& output_filename,
              const data::rewriter::strategy rewrite_strategy,
-             const lps::lps_rewriter_type rewriter_type
+             const lps::lps_rewriter_type rewriter_type,
+             const std::size_t number_of_threads = 1
             );
 
 void lpssumelm(const std::string& input_filename,
                const std::string& output_filename,
-               const bool decluster);
+               const bool decluster,
+               const std::size_t number_of_threads = 1);
 
 void lpssuminst(const std::string& input_filename,
                 const std::string& output_filename,
                 const data::rewriter::strategy rewrite_strategy,
                 const std::string& sorts_string,
                 const bool finite_sorts_only,
-                const bool tau_summands_only);
+                const bool tau_summands_only,
+                const std::size_t number_of_threads = 1);
 
 void lpsuntime(const std::string& input_filename,
                const std::string& output_filename,
@@ -67,6 +67,47 @@ typedef enum { unknown,
                error
              } processstatustype;
 
+/* The substitutions of the lineariser are stored in hash tables. */
+
+typedef std::unordered_map<variable, data_expression> substitution_map;
+
+/* A set of variables that are bound by the sum and stochastic operators around a subterm.
+   Extending the set with the variables of an operator does not copy the enclosing set, but
+   refers to it. The enclosing set must therefore outlive the extended set, which is the case
+   when the sets are passed down a recursion. */
+
+class bound_variable_set
+{
+  protected:
+    const bound_variable_set* m_enclosing;
+    variable_list m_variables;
+
+  public:
+    bound_variable_set()
+      : m_enclosing(nullptr)
+    {}
+
+    bound_variable_set(const bound_variable_set& enclosing, const variable_list& variables)
+      : m_enclosing(&enclosing),
+        m_variables(variables)
+    {}
+
+    bound_variable_set(const bound_variable_set& other) = delete;
+    bound_variable_set& operator=(const bound_variable_set& other) = delete;
+
+    std::size_t count(const variable& v) const
+    {
+      for(const bound_variable_set* s=this; s!=nullptr; s=s->m_enclosing)
+      {
+        if (std::find(s->m_variables.begin(),s->m_variables.end(),v)!=s->m_variables.end())
+        {
+          return 1;
+        }
+      }
+      return 0;
+    }
+};
+
 
 
 /**************** Definitions of object class  ***********************/
@@ -188,9 +229,12 @@ class specification_basic_type
     bool timeIsBeingUsed;
     bool stochastic_operator_is_being_used;
     bool fresh_equation_added;
-    std::map < aterm, objectdatatype > objectdata; // It is important to guarantee that the objects will not
-                                                   // be moved to another place when the object data structure grows. This
-                                                   // is because objects in this datatype  are passed around by reference.
+    std::unordered_map < aterm, objectdatatype > objectdata; // It is important to guarantee that the objects will not
+                                                             // be moved to another place when the object data structure grows. This
+                                                             // is because objects in this datatype  are passed around by reference.
+    std::unordered_map < variable_list, std::vector < process_identifier > > processes_by_parameters;
+                                                   // The declared processes, indexed by their parameters, in the order of
+                                                   // declaration. Used to find an existing process with the same definition.
 
     set_identifier_generator fresh_identifier_generator;
     std::vector < enumeratedtype > enumeratedtypes;
@@ -737,6 +781,7 @@ class specification_basic_type
       object.parameters=parameters;
       insertvariables(parameters,false);
       objectdata[procId]=object;
+      processes_by_parameters[parameters].push_back(procId);
       return objectdata.find(procId)->second;
     }
 
@@ -760,16 +805,21 @@ class specification_basic_type
       const bool containstime,
       process_identifier& p)
     {
-      for(const std::pair<const aterm,objectdatatype>& d: objectdata)
+      const auto i=processes_by_parameters.find(parameters);
+      if (i==processes_by_parameters.end())
       {
-        if (d.second.object==proc &&
-            d.second.parameters==parameters &&
-            d.second.processbody==body &&
-            d.second.canterminate==canterminate &&
-            d.second.containstime==containstime &&
-            d.second.processstatus==s)
+        return false;
+      }
+      for(const process_identifier& procId: i->second)
+      {
+        const objectdatatype& d=objectIndex(procId);
+        if (d.parameters==parameters &&
+            d.processbody==body &&
+            d.canterminate==canterminate &&
+            d.containstime==containstime &&
+            d.processstatus==s)
         {
-          p=process_identifier(d.second.objectname,d.second.parameters);
+          p=process_identifier(d.objectname,d.parameters);
           return true;
         }
       }
@@ -1874,7 +1924,7 @@ class specification_basic_type
     // Sort the assignments, such that they have the same order as the parameters
     assignment_list sort_assignments(const assignment_list& ass, const variable_list& parameters)
     {
-      std::map<variable,data_expression>assignment_map;
+      substitution_map assignment_map;
       for(const assignment& a: ass)
       {
         assignment_map[a.lhs()]=a.rhs();
@@ -1883,7 +1933,7 @@ class specification_basic_type
       assignment_vector result;
       for(const variable& v: parameters)
       {
-        const std::map<variable,data_expression>::const_iterator j=assignment_map.find(v);
+        const substitution_map::const_iterator j=assignment_map.find(v);
         if (j!=assignment_map.end()) // found
         {
           result.push_back(assignment(j->first,j->second));
@@ -1993,16 +2043,18 @@ class specification_basic_type
       if (is_sum(p))
       {
         variable_list sumargs=sum(p).variables();
-        variable_list vars;
-        data_expression_list terms;
+        variable_vector vars_vector;
+        data_expression_vector terms_vector;
 
-        for( std::map < variable, data_expression >::const_iterator i=sigma.begin(); i!=sigma.end(); ++i)
+        for( substitution_map::const_iterator i=sigma.begin(); i!=sigma.end(); ++i)
         {
-          vars=push_back(vars,i->first);
-          terms=push_back(terms,i->second);
+          vars_vector.push_back(i->first);
+          terms_vector.push_back(i->second);
         }
+        const variable_list vars(vars_vector.begin(),vars_vector.end());
+        const data_expression_list terms(terms_vector.begin(),terms_vector.end());
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma=sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma=sigma;
         alphaconvert(sumargs,local_sigma,vars,terms);
 
         return sum(sumargs,
@@ -2013,16 +2065,18 @@ class specification_basic_type
       {
         const stochastic_operator& sto=down_cast<const stochastic_operator>(p);
         variable_list sumargs=sto.variables();
-        variable_list vars;
-        data_expression_list terms;
+        variable_vector vars_vector;
+        data_expression_vector terms_vector;
 
-        for( std::map < variable, data_expression >::const_iterator i=sigma.begin(); i!=sigma.end(); ++i)
+        for( substitution_map::const_iterator i=sigma.begin(); i!=sigma.end(); ++i)
         {
-          vars=push_back(vars,i->first);
-          terms=push_back(terms,i->second);
+          vars_vector.push_back(i->first);
+          terms_vector.push_back(i->second);
         }
+        const variable_list vars(vars_vector.begin(),vars_vector.end());
+        const data_expression_list terms(terms_vector.begin(),terms_vector.end());
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma=sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma=sigma;
         alphaconvert(sumargs,local_sigma,vars,terms);
 
         return stochastic_operator(
@@ -2080,7 +2134,7 @@ class specification_basic_type
 
     process_instance_assignment transform_process_instance_to_process_instance_assignment(
               const process_instance& procId,
-              const std::set<variable>& bound_variables=std::set<variable>())
+              const bound_variable_set& bound_variables=bound_variable_set())
     {
       objectdatatype& object=objectIndex(procId.identifier());
       const variable_list process_parameters=object.parameters;
@@ -2211,10 +2265,10 @@ class specification_basic_type
         variable_list sumvars=sum(body).variables();
         process_expression body1=sum(body).operand();
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,freevars,data_expression_list());
         body1=substitute_pCRLproc(body1, sigma);
-        maintain_variables_in_rhs< mutable_map_substitution<> >  sigma_aux(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> >  sigma_aux(sigma);
         const data_expression time1=/*data::*/replace_variables_capture_avoiding_alt(time, sigma_aux);
         body1=wraptime(body1,time1,sumvars+freevars);
         return sum(sumvars,body1);
@@ -2226,11 +2280,11 @@ class specification_basic_type
         variable_list sumvars=sto.variables();
         process_expression body1=sto.operand();
 
-        maintain_variables_in_rhs<mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs<mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,freevars,data_expression_list());
         body1=substitute_pCRLproc(body1, sigma);
         const data_expression new_distribution=replace_variables_capture_avoiding_alt(sto.distribution(), sigma);
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma_aux(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma_aux(sigma);
         const data_expression time1=replace_variables_capture_avoiding_alt(time, sigma_aux);
         body1=wraptime(body1,time1,sumvars+freevars);
         return stochastic_operator(sumvars,new_distribution,body1);
@@ -2332,7 +2386,7 @@ class specification_basic_type
       const data_expression& condition,
       const process_expression& restterm,
       const variable_list& freevars,
-      const std::set<variable>& variables_bound_in_sum)
+      const bound_variable_set& variables_bound_in_sum)
     {
       if (is_if_then(restterm))
       {
@@ -2394,7 +2448,7 @@ class specification_basic_type
     }
 
 
-   assignment_list parameters_to_assignment_list(const variable_list& parameters, const std::set<variable>& variables_bound_in_sum)
+   assignment_list parameters_to_assignment_list(const variable_list& parameters, const bound_variable_set& variables_bound_in_sum)
    {
      assignment_vector result;
      for(const variable& v: parameters)
@@ -2413,7 +2467,7 @@ class specification_basic_type
       const state s,
       const variable_list& freevars, 
       const variableposition v,
-      const std::set<variable>& variables_bound_in_sum)
+      const bound_variable_set& variables_bound_in_sum)
     {
       /* it is assumed that we only receive processes with
          operators alt, seq, sum_state, cond, name, delta, tau, sync, at and stochastic operator in it */
@@ -2449,11 +2503,10 @@ class specification_basic_type
           variable_list sumvars=sum(body).variables();
           process_expression body1=sum(body).operand();
 
-          maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
           alphaconvert(sumvars,sigma,freevars,data_expression_list());
           body1=substitute_pCRLproc(body1,sigma);
-          std::set<variable> variables_bound_in_sum1=variables_bound_in_sum;
-          variables_bound_in_sum1.insert(sumvars.begin(),sumvars.end());
+          const bound_variable_set variables_bound_in_sum1(variables_bound_in_sum,sumvars);
           body1=bodytovarheadGNF(body1,sum_state,sumvars+freevars,first,variables_bound_in_sum1);
           /* Due to the optimisation below, suggested by Yaroslav Usenko, bodytovarheadGNF(...,sum_state,...)
              can deliver a process of the form c -> x + !c -> y. In this case, the
@@ -2482,12 +2535,11 @@ class specification_basic_type
           data_expression distribution=sto.distribution();
           process_expression body1=sto.operand();
 
-          maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
           alphaconvert(sumvars,sigma,freevars,data_expression_list());
           distribution=/* data::*/replace_variables_capture_avoiding_alt(distribution,sigma);
           body1=substitute_pCRLproc(body1,sigma);
-          std::set<variable> variables_bound_in_sum1=variables_bound_in_sum;
-          variables_bound_in_sum1.insert(sumvars.begin(),sumvars.end());
+          const bound_variable_set variables_bound_in_sum1(variables_bound_in_sum,sumvars);
           body1=bodytovarheadGNF(body1,name_state,sumvars+freevars,v,variables_bound_in_sum1);
           /* Due to the optimisation below, suggested by Yaroslav Usenko, bodytovarheadGNF(...,sum_state,...)
              can deliver a process of the form c -> x + !c -> y. In this case, the
@@ -2762,7 +2814,7 @@ class specification_basic_type
         // because objectdata can be reallocated as a side
         // effect of bodytovarheadGNF.
 
-        std::set<variable> variables_bound_in_sum;
+        const bound_variable_set variables_bound_in_sum;
         const process_expression result=
           bodytovarheadGNF(
             object.processbody,
@@ -2803,7 +2855,7 @@ class specification_basic_type
             inadvertently bound */
         variable_list sumvars=sum(body1).variables();
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvertprocess(sumvars,sigma,body2);
         return sum(sumvars,
                    putbehind(substitute_pCRLproc(sum(body1).operand(), sigma),
@@ -2816,7 +2868,7 @@ class specification_basic_type
         variable_list stochvars=sto.variables();
 
         // See explanation at sum operator above.
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvertprocess(stochvars,sigma,body2);
         return stochastic_operator(
                  stochvars,
@@ -2891,7 +2943,7 @@ class specification_basic_type
         /* we must take care that no variables in condition are
             inadvertently bound */
         variable_list sumvars=sum(body1).variables();
-        maintain_variables_in_rhs< mutable_map_substitution<> >  sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> >  sigma;
         alphaconvert(sumvars,sigma,variable_list(), data_expression_list({ condition }));
         return sum(
                  sumvars,
@@ -2906,7 +2958,7 @@ class specification_basic_type
             inadvertently bound */
         const stochastic_operator& sto=atermpp::down_cast<stochastic_operator>(body1);
         variable_list stochvars=sto.variables();
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(stochvars,sigma,variable_list(), data_expression_list({ condition }));
         return stochastic_operator(
                  stochvars,
@@ -2988,7 +3040,7 @@ class specification_basic_type
       bool result_defined=false;
       for(const data_expression_vector& d: data_vector)
       {
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         variable_list vl = stochvars;
         alphaconvert(vl,sigma,stochvars,data_expression_list());
         data_expression_vector::const_iterator i=d.begin();
@@ -3048,7 +3100,7 @@ class specification_basic_type
       if (is_stochastic_operator(body))
       {
         const stochastic_operator& sto=atermpp::down_cast<stochastic_operator>(body);
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         variable_list inner_stoch_vars=sto.variables();
         alphaconvert(inner_stoch_vars,sigma,sumvars,data_expression_list());
         const process_expression new_body=substitute_pCRLproc(sto.operand(), sigma);
@@ -3087,7 +3139,7 @@ class specification_basic_type
 
       if (is_sum(body1))
       {
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         variable_list inner_sumvars=sum(body1).variables();
         alphaconvert(inner_sumvars,sigma,sumvars,data_expression_list());
         const process_expression new_body1=substitute_pCRLproc(sum(body1).operand(), sigma);
@@ -3097,7 +3149,7 @@ class specification_basic_type
       if (is_stochastic_operator(body1))
       {
         const stochastic_operator& sto=atermpp::down_cast<stochastic_operator>(body1);
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         variable_list inner_stoch_vars=sto.variables();
         alphaconvert(inner_stoch_vars,sigma,sumvars,data_expression_list());
         const process_expression new_body1=substitute_pCRLproc(sto.operand(), sigma);
@@ -3262,7 +3314,7 @@ class specification_basic_type
     assignment_list argscollect_regular(
                          const process_expression& t,
                          const variable_list& vl,
-                         const std::set<variable>& variables_bound_in_sum)
+                         const bound_variable_set& variables_bound_in_sum)
     {
       assignment_vector result;
       for(const variable& v: vl) 
@@ -3286,7 +3338,7 @@ class specification_basic_type
         const variable_list pars=object.parameters; // These are the old parameters of the process.
         assert(pars.size()<=vl.size());
 
-        std::map<variable,data_expression>sigma;
+        substitution_map sigma;
         for(const assignment& a: p.assignments())
         {
           sigma[a.lhs()]=a.rhs();
@@ -3350,7 +3402,7 @@ class specification_basic_type
       process_expression sequence,
       std::vector <process_identifier>& todo,
       const variable_list& freevars,
-      const std::set<variable>& variables_bound_in_sum)
+      const bound_variable_set& variables_bound_in_sum)
     {
       process_identifier new_process;
 
@@ -3361,8 +3413,7 @@ class specification_basic_type
       {
         /* Leave the stochastic operators in place */
         const stochastic_operator& sto=atermpp::down_cast<const stochastic_operator>(sequence);
-        std::set<variable> variables_bound_in_sum_new=variables_bound_in_sum;
-        variables_bound_in_sum_new.insert(sto.variables().begin(),sto.variables().end());
+        const bound_variable_set variables_bound_in_sum_new(variables_bound_in_sum,sto.variables());
         return stochastic_operator(sto.variables(),
                                    sto.distribution(), 
                                    create_regular_invocation(sto.operand(),todo,freevars+sto.variables(),variables_bound_in_sum_new));
@@ -3435,7 +3486,7 @@ class specification_basic_type
       const process_expression& t,
       std::vector <process_identifier>& todo,
       const variable_list& freevars,
-      const std::set<variable>& variables_bound_in_sum)
+      const bound_variable_set& variables_bound_in_sum)
     /* t has the form of the sum, and condition over actions
        each followed by a sequence of variables. We replace
        this variable by a single one, putting the new variable
@@ -3466,12 +3517,11 @@ class specification_basic_type
       {
         variable_list sumvars=sum(t).variables();
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,freevars,data_expression_list());
         const process_expression body=substitute_pCRLproc(sum(t).operand(), sigma);
 
-        std::set<variable> variables_bound_in_sum1=variables_bound_in_sum;
-        variables_bound_in_sum1.insert(sumvars.begin(),sumvars.end());
+        const bound_variable_set variables_bound_in_sum1(variables_bound_in_sum,sumvars);
         return sum(sumvars,
                    to_regular_form(
                      body,
@@ -3485,15 +3535,14 @@ class specification_basic_type
         const stochastic_operator& sto=down_cast<const stochastic_operator>(t);
         variable_list sumvars=sto.variables();
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,freevars,data_expression_list());
         const data_expression distribution=replace_variables_capture_avoiding_alt(
                                                sto.distribution(),
                                                sigma);
         const process_expression body=substitute_pCRLproc(sto.operand(),sigma);
 
-        std::set<variable> variables_bound_in_sum1=variables_bound_in_sum;
-        variables_bound_in_sum1.insert(sumvars.begin(),sumvars.end());
+        const bound_variable_set variables_bound_in_sum1(variables_bound_in_sum,sumvars);
         return stochastic_operator(
                    sumvars,
                    distribution,
@@ -3530,10 +3579,10 @@ class specification_basic_type
       {
         variable_list sumvars=sum(body).variables();
         process_expression body1=sum(body).operand();
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,freevars,data_expression_list());
         body1=substitute_pCRLproc(body1, sigma);
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma_aux(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma_aux(sigma);
         const data_expression time1=replace_variables_capture_avoiding_alt(time,sigma_aux);
         body1=distributeTime(body1,time1,sumvars+freevars,timecondition);
         return sum(sumvars,body1);
@@ -3543,11 +3592,11 @@ class specification_basic_type
       {
         const stochastic_operator& sto=down_cast<const stochastic_operator>(body);
         variable_list sumvars=sto.variables();
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,freevars,data_expression_list());
         process_expression new_body=substitute_pCRLproc(sto.operand(), sigma);
         data_expression new_distribution=/*data::*/replace_variables_capture_avoiding_alt(sto.distribution(), sigma);
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma_aux(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma_aux(sigma);
         const data_expression time1=/*data::*/replace_variables_capture_avoiding_alt(time,sigma_aux);
         new_body=distributeTime(new_body,time1,sumvars+freevars,timecondition);
         return stochastic_operator(sumvars,new_distribution,new_body);
@@ -3600,7 +3649,7 @@ class specification_basic_type
       const bool regular,
       processstatustype mode,
       const variable_list& freevars,
-      const std::set <variable>& variables_bound_in_sum)
+      const bound_variable_set& variables_bound_in_sum)
     /* This process delivers the transformation of body
        to GNF with actions as a head symbol, or it
        delivers NULL if body is not a pCRL process.
@@ -3662,8 +3711,7 @@ class specification_basic_type
       if (is_sum(body))
       {
         const variable_list sumvars=sum(body).variables();
-        std::set<variable> variables_bound_in_sum1=variables_bound_in_sum;
-        variables_bound_in_sum1.insert(sumvars.begin(),sumvars.end());
+        const bound_variable_set variables_bound_in_sum1(variables_bound_in_sum,sumvars);
         return distribute_sum(sumvars,
                               procstorealGNFbody(sum(body).operand(),first,
                                   todo,regular,mode,sumvars+freevars,variables_bound_in_sum1));
@@ -3673,8 +3721,7 @@ class specification_basic_type
       {
         const stochastic_operator& sto=down_cast<const stochastic_operator>(body);
         const variable_list& sumvars=sto.variables();
-        std::set<variable> variables_bound_in_sum1=variables_bound_in_sum;
-        variables_bound_in_sum1.insert(sumvars.begin(),sumvars.end());
+        const bound_variable_set variables_bound_in_sum1(variables_bound_in_sum,sumvars);
         return stochastic_operator(
                               sumvars,
                               sto.distribution(),
@@ -3721,7 +3768,7 @@ class specification_basic_type
            we must now substitute */
         procstorealGNFrec(t,first,todo,regular);
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         for(const assignment& a: process_instance_assignment(body).assignments())
         {
           sigma[a.lhs()]=a.rhs();
@@ -3808,7 +3855,7 @@ class specification_basic_type
       if (object.processstatus==pCRL)
       {
         object.processstatus=GNFbusy;
-        std::set<variable> variables_bound_in_sum;
+        const bound_variable_set variables_bound_in_sum;
         const process_expression t=procstorealGNFbody(object.processbody,first,
                                    todo,regular,pCRL,object.parameters,variables_bound_in_sum);
         if (object.processstatus!=GNFbusy)
@@ -3824,7 +3871,7 @@ class specification_basic_type
       if (object.processstatus==mCRL)
       {
         object.processstatus=mCRLbusy;
-        std::set<variable> variables_bound_in_sum;
+        const bound_variable_set variables_bound_in_sum;
         const process_expression t=procstorealGNFbody(object.processbody,first,todo,
                                    regular,mCRL,object.parameters,variables_bound_in_sum);
         /* if the last result is not equal to NULL,
@@ -4175,7 +4222,7 @@ class specification_basic_type
           const stochastic_operator& proc=down_cast<const stochastic_operator>(proc_);
           assert(!is_process_instance_assignment(proc.operand()));
           objectdatatype& object=objectIndex(p);
-          maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
           variable_list vars=proc.variables();
           alphaconvert(vars,local_sigma, vars + object.parameters, data_expression_list());
 
@@ -4872,7 +4919,7 @@ class specification_basic_type
       const std::set<variable>& free_variables_in_body,
       const variable_list& stochastic_variables)
     {
-      std::map<variable,data_expression> assignment_map;
+      substitution_map assignment_map;
       for(const assignment& a: args)
       {
         assignment_map[a.lhs()]=a.rhs();
@@ -4896,7 +4943,7 @@ class specification_basic_type
         }
         else
         {
-          const std::map<variable,data_expression>::iterator k=assignment_map.find(v);
+          const substitution_map::iterator k=assignment_map.find(v);
           if (k!=assignment_map.end())  // There is assignment for v. Use it.
           {
             result.push_back(assignment(k->first,k->second));
@@ -5325,7 +5372,7 @@ class specification_basic_type
 
       // Check whether the variables in sumvars clash with the parameter list,
       // and rename the summandterm accordingly.
-      maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+      maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
       alphaconvert(sumvars,local_sigma,process_parameters,data_expression_list());
       summandterm=substitute_pCRLproc(summandterm, local_sigma);
 
@@ -6218,7 +6265,7 @@ class specification_basic_type
         ++auxrename_list_pars;
         const data_expression_list auxargs= *auxrename_list_args;
         ++auxrename_list_args;
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         data_expression_list::const_iterator j=auxargs.begin();
         for (variable_list::const_iterator i=auxpars.begin();
              i!=auxpars.end(); ++i, ++j)
@@ -6229,7 +6276,7 @@ class specification_basic_type
             sigma[*i]=*j;
           }
         }
-        maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
 
         const data_expression auxresult1=replace_variables_capture_avoiding_alt(condition,mutable_sigma);
         if (equalterm==data_expression()||is_global_variable(equalterm))
@@ -6344,7 +6391,7 @@ class specification_basic_type
             data_expression_list::const_iterator d1=(a1->arguments()).begin();
             for (std::size_t i=1; i<fcnt; ++i, ++d1) {};
             f= *d1;
-            maintain_variables_in_rhs< mutable_map_substitution<> > sigma; 
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma; 
             data_expression_list::const_iterator j=auxargs.begin();
             for (variable_list::const_iterator i=auxpars.begin();
                  i!=auxpars.end(); ++i, ++j)
@@ -6356,7 +6403,7 @@ class specification_basic_type
               }
             }
 
-            maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
             const data_expression auxresult1=replace_variables_capture_avoiding_alt(f,mutable_sigma);
 
             if (equalterm==data_expression()||is_global_variable(equalterm))
@@ -6448,7 +6495,7 @@ class specification_basic_type
             const data_expression_list auxargs= *auxrename_list_args;
             ++auxrename_list_args;
 
-            maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
             data_expression_list::const_iterator j=auxargs.begin();
             for (variable_list::const_iterator i=auxpars.begin();
                  i!=auxpars.end(); ++i, ++j)
@@ -6460,7 +6507,7 @@ class specification_basic_type
               }
             }
 
-            maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
             const data_expression auxresult1=replace_variables_capture_avoiding_alt(actiontime, mutable_sigma);
             if (equalterm==data_expression()||is_global_variable(equalterm))
             {
@@ -6546,7 +6593,7 @@ class specification_basic_type
           ++stochastic_auxrename_list_pars;
           const data_expression_list stochastic_auxargs= *stochastic_auxrename_list_args;
           ++stochastic_auxrename_list_args;
-          maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
           data_expression_list::const_iterator j=stochastic_auxargs.begin();
           for (variable_list::const_iterator i=stochastic_auxpars.begin();
                i!=stochastic_auxpars.end(); ++i, ++j)
@@ -6567,7 +6614,7 @@ class specification_basic_type
               sigma[*i]=*j;
             }
           }
-          maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
 
           const data_expression auxresult1=replace_variables_capture_avoiding_alt(dist,mutable_sigma);
           if (equalterm==data_expression()||is_global_variable(equalterm))
@@ -6692,7 +6739,7 @@ class specification_basic_type
           data_expression nextstateparameter;
           nextstateparameter=getRHSassignment(var,nextstate);
 
-          maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
           data_expression_list::const_iterator j=stochastic_auxargs.begin();
           for (variable_list::const_iterator i=stochastic_auxpars.begin();
                  i!=stochastic_auxpars.end(); ++i, ++j)
@@ -6714,7 +6761,7 @@ class specification_basic_type
             }
           }
 
-          maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
           data_expression auxresult1=replace_variables_capture_avoiding_alt(nextstateparameter, mutable_sigma);
           if (equalterm==data_expression()) // ||is_global_variable(equalterm)) Adding this last part leads to smaller case functions,
                                             // but bigger and less structured state spaces, as parameters are less often put to default
@@ -6840,7 +6887,7 @@ class specification_basic_type
         ++auxrename_list_pars;
         const data_expression_list auxargs= *auxrename_list_args;
         ++auxrename_list_args;
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         data_expression_list::const_iterator j=auxargs.begin();
         for (variable_list::const_iterator i=auxpars.begin();
              i!=auxpars.end(); ++i, ++j)
@@ -6852,7 +6899,7 @@ class specification_basic_type
           }
         }
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
         const data_expression auxresult1=replace_variables_capture_avoiding_alt(condition, mutable_sigma);
         if (equalterm==data_expression()||is_global_variable(equalterm))
         {
@@ -6972,7 +7019,7 @@ class specification_basic_type
             const data_expression_list auxargs= *auxrename_list_args;
             ++auxrename_list_args;
 
-            maintain_variables_in_rhs< mutable_map_substitution<> > sigma; 
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma; 
             data_expression_list::const_iterator j=auxargs.begin();
             for (variable_list::const_iterator i=auxpars.begin();
                  i!=auxpars.end(); ++i, ++j)
@@ -6984,7 +7031,7 @@ class specification_basic_type
               }
             }
 
-            maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
             const data_expression auxresult1=replace_variables_capture_avoiding_alt(actiontime, mutable_sigma);
             if (equalterm==data_expression()||is_global_variable(equalterm))
             {
@@ -7470,6 +7517,48 @@ class specification_basic_type
       return false;
     }
 
+    /// \brief Returns the names of the actions in multiaction, in the order in which they occur.
+    static identifier_string_list action_names(const action_list& multiaction)
+    {
+      return identifier_string_list(multiaction.begin(), multiaction.end(), [](const action& a){ return a.label().name(); });
+    }
+
+    /// \brief Determines whether the merge of two multi actions with the sorted action names names1 and names2
+    //         is allowed by the sorted allowlist. This is equal to allow_ on the merged multi action, provided that
+    //         it is not the action Terminate.
+    static bool allow_names(const action_name_multiset_list& allowlist,
+                            const identifier_string_list& names1,
+                            const identifier_string_list& names2)
+    {
+      if (names1.empty() && names2.empty())
+      {
+        return true;
+      }
+      std::vector<identifier_string> names;
+      std::merge(names1.begin(), names1.end(), names2.begin(), names2.end(), std::back_inserter(names),
+                 [](const identifier_string& a1, const identifier_string& a2){ return std::string(a1)<std::string(a2); });
+      for (const action_name_multiset& allowaction: allowlist)
+      {
+        if (std::equal(names.begin(), names.end(), allowaction.names().begin(), allowaction.names().end()))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// \brief Determines whether the merge of two multi actions with the action names names1 and names2 is
+    //         blocked by encaplist. This is equal to encap on the merged multi action.
+    static bool encap_names(const action_name_multiset_list& encaplist,
+                            const identifier_string_list& names1,
+                            const identifier_string_list& names2)
+    {
+      assert(encaplist.size()==1);
+      const identifier_string_list& blocked=encaplist.front().names();
+      auto is_blocked=[&](const identifier_string& a){ return std::find(blocked.begin(), blocked.end(), a)!=blocked.end(); };
+      return std::any_of(names1.begin(), names1.end(), is_blocked) || std::any_of(names2.begin(), names2.end(), is_blocked);
+    }
+
     bool encap(const action_name_multiset_list& encaplist, const action_list& multiaction)
     {
       for (const action& a: multiaction)
@@ -8205,6 +8294,9 @@ class specification_basic_type
       }
       action_name_multiset_list allowlist((is_allow)?sort_multi_action_labels(allowlist1):allowlist1);
 
+      // The possible communications only depend on the multiaction, which is often shared by many summands.
+      std::unordered_map<action_list, tuple_list> multiactionconditionlists;
+
       for (const stochastic_action_summand& smmnd: action_summands)
       {
         const variable_list& sumvars=smmnd.summation_variables();
@@ -8251,10 +8343,12 @@ class specification_basic_type
            the original multiaction is delivered, with condition
            true. */
 
-        const tuple_list multiactionconditionlist=
-          makeMultiActionConditionList(
-            multiaction,
-            communications1);
+        auto cached=multiactionconditionlists.find(multiaction);
+        if (cached==multiactionconditionlists.end())
+        {
+          cached=multiactionconditionlists.emplace(multiaction,makeMultiActionConditionList(multiaction,communications1)).first;
+        }
+        const tuple_list& multiactionconditionlist=cached->second;
 
         assert(multiactionconditionlist.actions.size()==
                multiactionconditionlist.conditions.size());
@@ -8515,7 +8609,7 @@ class specification_basic_type
         const variable_list& auxpars=*renamings_par;
         const data_expression_list& auxargs=*renamings_arg;
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma; 
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma; 
         data_expression_list::const_iterator j1=auxargs.begin();
         for (variable_list::const_iterator i1=auxpars.begin();
              i1!=auxpars.end(); ++i1, ++j1)
@@ -8528,7 +8622,7 @@ class specification_basic_type
           }
         }
 
-        maintain_variables_in_rhs< mutable_map_substitution<> > mutable_sigma(sigma);
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > mutable_sigma(sigma);
         result=lazy::or_(result,replace_variables_capture_avoiding_alt(lazy::and_(*i,*j), mutable_sigma));
       }
       return lps::detail::ultimate_delay(time_variable, existentially_quantified_variables, RewriteTerm(result));
@@ -8537,14 +8631,14 @@ class specification_basic_type
 
     /******** make_unique_variables **********************/
 
-    data::maintain_variables_in_rhs< data::mutable_map_substitution<> >  make_unique_variables(
+    data::maintain_variables_in_rhs< data::mutable_map_substitution<substitution_map> >  make_unique_variables(
       const variable_list& var_list,
       const std::string& hint)
     {
       /* This function generates a list of variables with the same sorts
          as in variable_list, where all names are unique */
 
-      data::maintain_variables_in_rhs< data::mutable_map_substitution<> >  sigma;
+      data::maintain_variables_in_rhs< data::mutable_map_substitution<substitution_map> >  sigma;
 
       for(const variable& var: var_list)
       {
@@ -8566,13 +8660,13 @@ class specification_basic_type
     {
       stochastic_action_summand_vector result_action_summands;
 
-      data::maintain_variables_in_rhs<data::mutable_map_substitution<> > sigma=make_unique_variables(pars, hint);
+      data::maintain_variables_in_rhs<data::mutable_map_substitution<substitution_map> > sigma=make_unique_variables(pars, hint);
       const variable_list unique_pars=data::replace_variables(pars, sigma);
 
       if (!options.ignore_time)
       {
         // Remove variables locally bound in the ultimate_delay_condition
-        maintain_variables_in_rhs< data::mutable_map_substitution<> > local_sigma=sigma;
+        maintain_variables_in_rhs< data::mutable_map_substitution<substitution_map> > local_sigma=sigma;
         for(const variable& v: ultimate_delay_condition.variables())
         {
           local_sigma[v]=v;
@@ -8584,12 +8678,12 @@ class specification_basic_type
       for (const stochastic_action_summand& smmnd: action_summands)
       {
         const variable_list& sumvars=smmnd.summation_variables();
-        data::maintain_variables_in_rhs<data::mutable_map_substitution<> > sigma_sumvars=make_unique_variables(sumvars,hint);
+        data::maintain_variables_in_rhs<data::mutable_map_substitution<substitution_map> > sigma_sumvars=make_unique_variables(sumvars,hint);
         const variable_list unique_sumvars=data::replace_variables(sumvars, sigma_sumvars);
 
         stochastic_distribution distribution=smmnd.distribution();
         const variable_list stochastic_vars=distribution.variables();
-        data::maintain_variables_in_rhs<data::mutable_map_substitution<> > sigma_stochastic_vars=
+        data::maintain_variables_in_rhs<data::mutable_map_substitution<substitution_map> > sigma_stochastic_vars=
                                           make_unique_variables(stochastic_vars,hint);
         const variable_list unique_stochastic_vars=data::replace_variables(stochastic_vars, sigma_stochastic_vars);
 
@@ -8637,7 +8731,7 @@ class specification_basic_type
       for (const deadlock_summand& smmnd: deadlock_summands)
       {
         const variable_list& sumvars=smmnd.summation_variables();
-        maintain_variables_in_rhs<data::mutable_map_substitution<> > sigma_sumvars=make_unique_variables(sumvars,hint);
+        maintain_variables_in_rhs<data::mutable_map_substitution<substitution_map> > sigma_sumvars=make_unique_variables(sumvars,hint);
         const variable_list unique_sumvars=data::replace_variables(sumvars, sigma_sumvars);
 
         assert(unique_sumvars.size()==sumvars.size());
@@ -8674,7 +8768,7 @@ class specification_basic_type
     {
       // Make the bound variables of the second ultimate delay different from those in the first.
       variable_list renameable_variables=delay2.variables();
-      maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+      maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
       alphaconvert(renameable_variables, sigma, delay1.variables(), data_expression_list());
       // Additionally map the time variable of the second ultimate delay to that of the first.
       sigma[delay2.time_var()]=delay1.time_var();
@@ -8700,7 +8794,7 @@ class specification_basic_type
       for (const stochastic_action_summand& summand1: action_summands1)
       {
         variable_list sumvars=ultimate_delay_condition.variables();
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(sumvars,sigma,summand1.summation_variables(),data_expression_list());
 
         variable_list sumvars1=summand1.summation_variables() + sumvars;
@@ -8777,7 +8871,7 @@ class specification_basic_type
         for (const deadlock_summand& summand1: deadlock_summands1)
         {
           variable_list sumvars=ultimate_delay_condition.variables();
-          maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
           alphaconvert(sumvars,sigma,summand1.summation_variables(),data_expression_list());
 
           variable_list sumvars1=summand1.summation_variables() + sumvars;
@@ -8849,6 +8943,34 @@ class specification_basic_type
           const bool is_block,
           stochastic_action_summand_vector& action_summands)
     {
+      const action_list termination_multiaction({ terminationAction });
+
+      // Index the summands in action_summands2 on the names of their actions. Whether a combined multi action
+      // passes the allow or block operator only depends on these names, so it is determined once for every pair
+      // of groups of summands, and summands that would be removed are never constructed.
+      std::vector<std::size_t> terminating_summands2;
+      std::unordered_map<identifier_string_list, std::vector<std::size_t> > summand_groups2;
+      for (std::size_t i=0; i<action_summands2.size(); ++i)
+      {
+        const action_list& multiaction2=action_summands2[i].multi_action().actions();
+        if (multiaction2==termination_multiaction)
+        {
+          terminating_summands2.push_back(i);
+        }
+        else
+        {
+          summand_groups2[action_names(multiaction2)].push_back(i);
+        }
+      }
+      if (is_block && encap(allowlist,termination_multiaction))
+      {
+        terminating_summands2.clear();
+      }
+
+      // Maps the action names of a summand in action_summands1 to the indices of the summands in action_summands2
+      // with which it can be combined, in increasing order.
+      std::unordered_map<identifier_string_list, std::vector<std::size_t> > partners;
+
       // First combine the action summands.
       for (const stochastic_action_summand& summand1: action_summands1)
       {
@@ -8859,8 +8981,31 @@ class specification_basic_type
         const assignment_list& nextstate1=summand1.assignments();
         const stochastic_distribution& distribution1=summand1.distribution();
 
-        for (const stochastic_action_summand& summand2: action_summands2)
+        const bool is_termination1=(multiaction1==termination_multiaction);
+        const std::vector<std::size_t>* partners1=&terminating_summands2;
+        if (!is_termination1)
         {
+          const identifier_string_list names1=action_names(multiaction1);
+          auto i=partners.find(names1);
+          if (i==partners.end())
+          {
+            std::vector<std::size_t> indices;
+            for (const auto& [names2, group2]: summand_groups2)
+            {
+              if ((!is_allow || allow_names(allowlist,names1,names2)) && (!is_block || !encap_names(allowlist,names1,names2)))
+              {
+                indices.insert(indices.end(), group2.begin(), group2.end());
+              }
+            }
+            std::sort(indices.begin(), indices.end());
+            i=partners.emplace(names1, std::move(indices)).first;
+          }
+          partners1=&i->second;
+        }
+
+        for (const std::size_t index2: *partners1)
+        {
+          const stochastic_action_summand& summand2=action_summands2[index2];
           const variable_list& sumvars2=summand2.summation_variables();
           const action_list multiaction2=summand2.multi_action().actions();
           const data_expression actiontime2=summand2.multi_action().time();
@@ -8868,72 +9013,62 @@ class specification_basic_type
           const assignment_list& nextstate2=summand2.assignments();
           const stochastic_distribution& distribution2=summand2.distribution();
 
-          if ((multiaction1 == action_list({ terminationAction })) == (multiaction2 == action_list({ terminationAction })))
+          action_list multiaction3;
+          if (is_termination1)
           {
-            action_list multiaction3;
-            if ((multiaction1 == action_list({ terminationAction })) && (multiaction2 == action_list({ terminationAction })))
-            {
-              multiaction3.push_front(terminationAction);
-            }
-            else
-            {
-              multiaction3=linMergeMultiActionList(multiaction1,multiaction2);
-            }
+            multiaction3.push_front(terminationAction);
+          }
+          else
+          {
+            multiaction3=linMergeMultiActionList(multiaction1,multiaction2);
+          }
+          assert(!is_allow || allow_(allowlist,multiaction3));
+          assert(!is_block || !encap(allowlist,multiaction3));
 
-            if (is_allow && !allow_(allowlist,multiaction3))
-            {
-              continue;
-            }
-            if (is_block && encap(allowlist,multiaction3))
+          const variable_list allsums=sumvars1+sumvars2;
+          data_expression condition3= lazy::and_(condition1,condition2);
+          data_expression action_time3;
+          bool has_time3=summand1.has_time()||summand2.has_time();
+
+          if (!summand1.has_time())
+          {
+            if (summand2.has_time())
             {
-              continue;
+              /* summand 2 has time*/
+              action_time3=actiontime2;
             }
-
-            const variable_list allsums=sumvars1+sumvars2;
-            data_expression condition3= lazy::and_(condition1,condition2);
-            data_expression action_time3;
-            bool has_time3=summand1.has_time()||summand2.has_time();
-
-            if (!summand1.has_time())
+          }
+          else
+          {
+            /* summand 1 has time */
+            if (!summand2.has_time())
             {
-              if (summand2.has_time())
-              {
-                /* summand 2 has time*/
-                action_time3=actiontime2;
-              }
+              action_time3=actiontime1;
             }
             else
             {
-              /* summand 1 has time */
-              if (!summand2.has_time())
-              {
-                action_time3=actiontime1;
-              }
-              else
-              {
-                /* both summand 1 and 2 have time */
-                action_time3=actiontime1;
-                condition3=lazy::and_(
-                             condition3,
-                             equal_to(actiontime1,actiontime2));
-              }
+              /* both summand 1 and 2 have time */
+              action_time3=actiontime1;
+              condition3=lazy::and_(
+                           condition3,
+                           equal_to(actiontime1,actiontime2));
             }
+          }
 
-            const assignment_list nextstate3=nextstate1+nextstate2;
-            const stochastic_distribution distribution3(
-                                              distribution1.variables()+distribution2.variables(),
-                                              real_times_optimized(distribution1.distribution(),distribution2.distribution()));
+          const assignment_list nextstate3=nextstate1+nextstate2;
+          const stochastic_distribution distribution3(
+                                            distribution1.variables()+distribution2.variables(),
+                                            real_times_optimized(distribution1.distribution(),distribution2.distribution()));
 
-            condition3=RewriteTerm(condition3);
-            if (condition3!=sort_bool::false_())
-            {
-              action_summands.push_back(stochastic_action_summand(
-                                           allsums,
-                                           condition3,
-                                           has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
-                                           nextstate3,
-                                           distribution3));
-            }
+          condition3=RewriteTerm(condition3);
+          if (condition3!=sort_bool::false_())
+          {
+            action_summands.push_back(stochastic_action_summand(
+                                         allsums,
+                                         condition3,
+                                         has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
+                                         nextstate3,
+                                         distribution3));
           }
         }
       }
@@ -9212,7 +9347,7 @@ class specification_basic_type
 
         objectdatatype& object=objectIndex(process_instance_assignment(t).identifier());
 
-        maintain_variables_in_rhs<mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs<mutable_map_substitution<substitution_map> > sigma;
         for (const assignment& a: process_instance_assignment(t).assignments())
         {
           sigma[a.lhs()]=a.rhs();
@@ -9413,7 +9548,7 @@ class specification_basic_type
         generateLPEmCRLterm(action_summands,deadlock_summands,sto.operand(),
                               regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
         variable_list stochvars=sto.variables();
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconvert(stochvars,sigma,pars + initial_stochastic_distribution.variables(), data_expression_list());
         initial_stochastic_distribution=stochastic_distribution(
                                           stochvars+initial_stochastic_distribution.variables(),
@@ -9512,7 +9647,7 @@ class specification_basic_type
     process_expression alphaconversionterm(
       const process_expression& t,
       const variable_list& parameters,
-      maintain_variables_in_rhs<mutable_map_substitution<> > sigma)
+      maintain_variables_in_rhs<mutable_map_substitution<substitution_map> > sigma)
     {
       if (is_choice(t))
       {
@@ -9572,7 +9707,7 @@ class specification_basic_type
       if (is_sum(t))
       {
         variable_list sumvars=sum(t).variables();
-        maintain_variables_in_rhs<mutable_map_substitution<> > local_sigma=sigma;
+        maintain_variables_in_rhs<mutable_map_substitution<substitution_map> > local_sigma=sigma;
 
         alphaconvert(sumvars,local_sigma,variable_list(),variable_list_to_data_expression_list(parameters));
         return sum(sumvars,alphaconversionterm(sum(t).operand(), sumvars+parameters, local_sigma));
@@ -9582,7 +9717,7 @@ class specification_basic_type
       {
         const stochastic_operator& sto=down_cast<const stochastic_operator>(t);
         variable_list sumvars=sto.variables();
-        maintain_variables_in_rhs<mutable_map_substitution<> > local_sigma=sigma;
+        maintain_variables_in_rhs<mutable_map_substitution<substitution_map> > local_sigma=sigma;
 
         alphaconvert(sumvars,local_sigma,variable_list(),variable_list_to_data_expression_list(parameters));
         return stochastic_operator(
@@ -9656,13 +9791,13 @@ class specification_basic_type
         object.processstatus=GNFalpha;
         // tempvar below is needed as objectdata may be reallocated
         // during a call to alphaconversionterm.
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         const process_expression tempvar=alphaconversionterm(object.processbody,parameters,sigma);
         object.processbody=tempvar;
       }
       else if (object.processstatus==mCRLdone)
       {
-        maintain_variables_in_rhs< mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > sigma;
         alphaconversionterm(object.processbody,parameters,sigma);
 
       }
@@ -9876,23 +10011,25 @@ class specification_basic_type
           objectdatatype& object=objectIndex(new_identifier);
           const variable_list new_parameters=object.parameters;
           const stochastic_operator& sto=down_cast<stochastic_operator>(new_process);
-          assignment_list new_assignments;
+          assignment_vector new_assignment_vector;
           
           const variable_list relevant_stochastic_variables=parameters_that_occur_in_body(sto.variables(),object.processbody);
           assert(relevant_stochastic_variables.size()<=new_parameters.size());
           variable_list::const_iterator i=new_parameters.begin();
           for(const variable& v: relevant_stochastic_variables)
           {
-            new_assignments=push_back(new_assignments,assignment(*i,v));
+            new_assignment_vector.push_back(assignment(*i,v));
             i++;
           }
           // Some of the variables may occur only in the distribution, which is now moved out.
           // Therefore, the assignments must be filtered.
-          new_assignments=filter_assignments(new_assignments + u.assignments(),object.parameters);
+          const assignment_list new_assignments=filter_assignments(
+                     assignment_list(new_assignment_vector.begin(),new_assignment_vector.end()) + u.assignments(),
+                     object.parameters);
 
           // Furthermore, the old assignment must be applied to the distribution, when it is moved
           // outside of the process body.
-          maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+          maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
           for(const assignment& a:u.assignments())
           {
             local_sigma[a.lhs()]=a.rhs();
@@ -9920,7 +10057,7 @@ class specification_basic_type
             const process_expression& new_body1=r1.operand();
             process_expression new_body2=r2.operand();
             variable_list stochvars=r2.variables();
-            maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
             alphaconvert(stochvars,local_sigma, r1.variables(),data_expression_list());
             new_body2=substitute_pCRLproc(new_body2, local_sigma);
             const data_expression new_distribution=
@@ -9985,7 +10122,7 @@ class specification_basic_type
             const process_expression& new_body1=r1.operand();
             process_expression new_body2=r2.operand();
             variable_list stochvars=r2.variables();
-            maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
             alphaconvert(stochvars,local_sigma, r1.variables(),data_expression_list());
             new_body2=substitute_pCRLproc(new_body2, local_sigma);
             const data_expression new_distribution=
@@ -10116,7 +10253,7 @@ class specification_basic_type
             const process_expression& new_body1=r1.operand();
             process_expression new_body2=r2.operand();
             variable_list stochvars=r2.variables();
-            maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
             alphaconvert(stochvars,local_sigma, r1.variables(),data_expression_list());
             new_body2=substitute_pCRLproc(new_body2, local_sigma);
             const data_expression new_distribution=
@@ -10179,7 +10316,7 @@ class specification_basic_type
             const process_expression& new_body1=r1.operand();
             process_expression new_body2=r2.operand();
             variable_list stochvars=r2.variables();
-            maintain_variables_in_rhs< mutable_map_substitution<> > local_sigma;
+            maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > local_sigma;
             alphaconvert(stochvars,local_sigma, r1.variables(),data_expression_list());
             new_body2=substitute_pCRLproc(new_body2, local_sigma);
             const data_expression new_distribution=
@@ -10535,7 +10672,7 @@ class specification_basic_type
                                                  down_cast<process_instance_assignment>(object.processbody),
                                                  visited_processes);
 
-        maintain_variables_in_rhs<mutable_map_substitution<> > sigma;
+        maintain_variables_in_rhs<mutable_map_substitution<substitution_map> > sigma;
         for (const assignment& a: process_instance_assignment(t).assignments())
         {
           sigma[a.lhs()]=a.rhs();
@@ -10577,7 +10714,7 @@ class specification_basic_type
       {
         visited_processes.insert(procId);
         objectdatatype& object=objectIndex(procId);
-        const std::set<variable> bound_variables;
+        const bound_variable_set bound_variables;
         object.processbody=transform_process_arguments_body(
                                          object.processbody,
                                          bound_variables,
@@ -10595,7 +10732,7 @@ class specification_basic_type
     /* This function replaces all process instances by a process instance assignment */
     process_expression transform_process_arguments_body(
       const process_expression& t, 
-      const std::set<variable>& bound_variables,
+      const bound_variable_set& bound_variables,
       std::set<process_identifier>& visited_processes)
     {
       if (is_process_instance(t))
@@ -10674,9 +10811,8 @@ class specification_basic_type
       }
       if (is_sum(t))
       {
-        std::set<variable> bound_variables1=bound_variables;
         const variable_list sum_vars=sum(t).variables();
-        bound_variables1.insert(sum_vars.begin(),sum_vars.end());
+        const bound_variable_set bound_variables1(bound_variables,sum_vars);
         return sum(
                  sum_vars,
                  transform_process_arguments_body(sum(t).operand(),bound_variables1,visited_processes));
@@ -10728,7 +10864,7 @@ class specification_basic_type
             const process_identifier& procId,
             std::set<process_identifier>& visited_processes,
             std::set<identifier_string>& used_variable_names,
-            maintain_variables_in_rhs<mutable_map_substitution<> >& parameter_mapping,
+            maintain_variables_in_rhs<mutable_map_substitution<substitution_map> >& parameter_mapping,
             std::set<variable>& variables_in_lhs_of_parameter_mapping)
     {
       if (visited_processes.count(procId)==0)
@@ -10759,6 +10895,10 @@ class specification_basic_type
         }
         object.old_parameters=object.parameters;
         object.parameters=data::replace_variables(parameters,parameter_mapping);
+        if (object.parameters!=parameters)
+        {
+          processes_by_parameters[object.parameters].push_back(procId);
+        }
         object.processbody=guarantee_that_parameters_have_unique_type_body(
                                          object.processbody,
                                          visited_processes,
@@ -10772,7 +10912,7 @@ class specification_basic_type
     {
       std::set<process_identifier> visited_processes;
       std::set<identifier_string> used_variable_names;
-      maintain_variables_in_rhs< mutable_map_substitution<> > parameter_mapping;
+      maintain_variables_in_rhs< mutable_map_substitution<substitution_map> > parameter_mapping;
       std::set<variable> variables_in_lhs_of_parameter_mapping;
       guarantee_that_parameters_have_unique_type(procId,
                                                  visited_processes,
@@ -10785,7 +10925,7 @@ class specification_basic_type
       const process_expression& t, 
       std::set<process_identifier>& visited_processes,
       std::set<identifier_string>& used_variable_names,
-      maintain_variables_in_rhs<mutable_map_substitution<> >& parameter_mapping,
+      maintain_variables_in_rhs<mutable_map_substitution<substitution_map> >& parameter_mapping,
       std::set<variable>& variables_in_lhs_of_parameter_mapping)
     {
       if (is_process_instance_assignment(t))
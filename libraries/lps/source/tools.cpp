@@ -95,7 +95,8 @@ bool lpsinvelm(const std::string& input_filename,
                const bool counter_example,
                const bool path_eliminator,
                const bool apply_induction,
-               const int time_limit)
+               const int time_limit,
+               const std::size_t prover_cache_size)
 {
   stochastic_specification spec;
   data::data_expression invariant;
@@ -123,6 +124,10 @@ bool lpsinvelm(const std::string& input_filename,
     throw mcrl2::runtime_error("A file containing an invariant must be specified using the option --invariant=INVFILE.");
   }
 
+  // The invariant checker and the elimination use the same data specification and rewrite strategy, so they can
+  // share the caches of their provers.
+  std::shared_ptr<data::detail::BDD_Prover_Cache> prover_cache = std::make_shared<data::detail::BDD_Prover_Cache>(prover_cache_size);
+
   if (no_check)
   {
     mCRL2log(log::warning) << "The invariant is not checked; it may not hold for this LPS." << std::endl;
@@ -137,10 +142,12 @@ bool lpsinvelm(const std::string& input_filename,
                                           apply_induction,
                                           counter_example,
                                           all_violations,
-                                          dot_file_name);
+                                          dot_file_name,
+                                          prover_cache);
 
     if (!v_invariant_checker.check_invariant(invariant))
     {
+      mCRL2log(log::verbose) << prover_cache->statistics() << std::endl;
       return false; // The invariant was checked and found invalid.
     }
   }
@@ -151,8 +158,10 @@ bool lpsinvelm(const std::string& input_filename,
                                path_eliminator,
                                solver_type,
                                apply_induction,
-                               simplify_all);
+                               simplify_all,
+                               prover_cache);
   algorithm.run(invariant, !no_elimination);
+  mCRL2log(log::verbose) << prover_cache->statistics() << std::endl;
   save_lps(spec, output_filename);
   return true;
 }
@@ -212,7 +221,8 @@ void lpspp(const std::string& input_filename,
 void lpsrewr(const std::string& input_filename,
              const std::string& output_filename,
              const data::rewriter::strategy rewrite_strategy,
-             const lps_rewriter_type rewriter_type
+             const lps_rewriter_type rewriter_type,
+             const std::size_t number_of_threads
             )
 {
   stochastic_specification spec;
@@ -222,7 +232,7 @@ void lpsrewr(const std::string& input_filename,
     case simplify:
     {
       mcrl2::data::rewriter R(spec.data(), rewrite_strategy);
-      lps::rewrite(spec, R);
+      lps::detail::lps_algorithm<stochastic_specification>(spec).rewrite(R, number_of_threads);
       break;
     }
     case quantifier_one_point:
@@ -238,12 +248,13 @@ void lpsrewr(const std::string& input_filename,
 
 void lpssumelm(const std::string& input_filename,
                const std::string& output_filename,
-               const bool decluster)
+               const bool decluster,
+               const std::size_t number_of_threads)
 {
   stochastic_specification spec;
   load_lps(spec, input_filename);
 
-  sumelm_algorithm<stochastic_specification>(spec, decluster).run();
+  sumelm_algorithm<stochastic_specification>(spec, decluster, number_of_threads).run();
 
   mCRL2log(log::debug) << "Sum elimination completed, saving to " <<  output_filename << std::endl;
   save_lps(spec, output_filename);
@@ -254,7 +265,8 @@ void lpssuminst(const std::string& input_filename,
                 const data::rewriter::strategy rewrite_strategy,
                 const std::string& sorts_string,
                 const bool finite_sorts_only,
-                const bool tau_summands_only)
+                const bool tau_summands_only,
+                const std::size_t number_of_threads)
 {
   stochastic_specification spec;
   load_lps(spec, input_filename);
@@ -282,7 +294,7 @@ void lpssuminst(const std::string& input_filename,
   mCRL2log(log::verbose, "lpssuminst") << "expanding summation variables of sorts: " << data::pp(sorts) << std::endl;
 
   mcrl2::data::rewriter r(spec.data(), rewrite_strategy);
-  lps::suminst_algorithm<data::rewriter, stochastic_specification>(spec, r, sorts, tau_summands_only).run();
+  lps::suminst_algorithm<data::rewriter, stochastic_specification>(spec, r, sorts, tau_summands_only, number_of_threads).run();
   save_lps(spec, output_filename);
 }
 
@@ -55,6 +55,21 @@ void run_confluence_test_case(const std::string& s, const std::size_t ctau_count
   checker1.check_confluence_and_mark(data::sort_bool::true_(),0);
 
   BOOST_CHECK_EQUAL(count_ctau(s0), ctau_count);
+
+#ifdef MCRL2_THREAD_SAFE
+  // Checking the summands in parallel must give exactly the same result, also when all summands are checked.
+  for (bool check_all: { false, true })
+  {
+    specification s1 = parse_linear_process_specification(s);
+    specification s2 = parse_linear_process_specification(s);
+    Confluence_Checker<specification> checker2(s1, data::jitty, 0, false, data::detail::solver_type_cvc, false, check_all);
+    Confluence_Checker<specification> checker3(s2, data::jitty, 0, false, data::detail::solver_type_cvc, false, check_all, false, "c", false, false, "", 3);
+    checker2.check_confluence_and_mark(data::sort_bool::true_(),0);
+    checker3.check_confluence_and_mark(data::sort_bool::true_(),0);
+    BOOST_CHECK_EQUAL(count_ctau(s2), ctau_count);
+    BOOST_CHECK(s1 == s2);
+  }
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(case_1)
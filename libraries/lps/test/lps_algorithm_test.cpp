@@ -67,7 +67,20 @@ void test_remove_unused_summand_variables()
   algorithm.remove_unused_summand_variables();
 }
 
+// Rewriting the summands using several threads must give the same result as a sequential run.
+void test_rewrite()
+{
+  specification spec = remove_stochastic_operators(linearise(SPECIFICATION));
+  data::rewriter R(spec.data());
+  specification spec1 = spec;
+  specification spec2 = spec;
+  lps::rewrite(spec1, R);
+  lps::detail::lps_algorithm<>(spec2).rewrite(R, 3);
+  BOOST_CHECK(spec1 == spec2);
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   test_remove_unused_summand_variables();
+  test_rewrite();
 }
@@ -371,3 +371,30 @@ BOOST_AUTO_TEST_CASE(test_boolean_variables)
   print_specifications(s0, s1);
 }
 
+
+// Sum elimination using several threads must give the same result as a sequential run.
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  const std::string text(
+    "sort S = struct s1 | s2;\n"
+    "act a:S#Nat;\n"
+    "    b:Bool;\n"
+    "proc P(n:Nat) = sum s:S, m:Nat. (s == s1 && m == n) -> a(s, m) . P(m + 1)\n"
+    "              + sum c:Bool. c -> b(c) . P(n)\n"
+    "              + sum m:Nat. (m == 2 && n > m) -> delta@n\n"
+    "              + sum m,k:Nat. (k == m + n) -> a(s2, k) . P(m);\n"
+    "init P(0);\n"
+  );
+
+  specification s0 = parse_linear_process_specification(text);
+  specification s1 = s0;
+  specification s2 = s0;
+  sumelm_algorithm<> algorithm1(s1);
+  algorithm1.run();
+  sumelm_algorithm<> algorithm2(s2, false, 3);
+  algorithm2.run();
+  BOOST_CHECK(s1 == s2);
+  BOOST_CHECK_EQUAL(algorithm1.removed(), algorithm2.removed());
+
+  print_specifications(s0, s2);
+}
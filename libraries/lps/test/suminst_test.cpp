@@ -206,6 +206,32 @@ void test_case_7()
   BOOST_CHECK(sum_count == 1);
 }
 
+// Instantiating summands using several threads must give the same result as a sequential run.
+void test_threads()
+{
+  const std::string text(
+    "sort D = struct d1|d2|d3;\n"
+    "act a:D;\n"
+    "    b:D#Bool;\n"
+    "    c:Nat;\n"
+    "proc X(x:D, n:Nat) = sum d:D . a(d) . X(d, n)\n"
+    "                   + sum d:D, e:Bool . (d != x) -> b(d, e) . X(d, n + 1)\n"
+    "                   + sum m:Nat . (m < n) -> c(m) . X(x, m)\n"
+    "                   + sum d:D . (d == x) -> delta@n\n"
+    "                   + sum d:D . (d != d) -> tau . X(d, n);\n"
+    "init X(d1, 0);\n"
+  );
+
+  specification s0=remove_stochastic_operators(linearise(text));
+  rewriter r(s0.data());
+  specification s1(s0);
+  specification s2(s0);
+  suminst_algorithm<rewriter, specification>(s1, r).run();
+  suminst_algorithm<rewriter, specification>(s2, r, std::set<data::sort_expression>(), false, 3).run();
+  BOOST_CHECK(s1 == s2);
+  BOOST_CHECK(!(s0 == s1));
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   std::clog << "test case 1" << std::endl;
@@ -220,5 +246,7 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_case_5();
   std::clog << "test case 6" << std::endl;
   test_case_6();
+  std::clog << "test threads" << std::endl;
+  test_threads();
 }
 
@@ -0,0 +1,67 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <iostream>
+#include <random>
+
+using namespace mcrl2;
+
+int main(int argc, char* argv[])
+{
+  lts::lts_equivalence equivalence = lts::lts_eq_bisim_gjkw;
+  std::size_t number_of_states = 400000;
+
+  // Accept arguments for the equivalence and the number of states.
+  if (argc > 1)
+  {
+    equivalence = lts::parse_equivalence(argv[1]);
+  }
+  if (argc > 2)
+  {
+    number_of_states = static_cast<std::size_t>(std::stoul(argv[2]));
+  }
+
+  // Generates four copies of a random LTS with tau transitions, such that every reduction removes at least three
+  // quarters of the states.
+  lts::lts_aut_t l;
+  l.set_num_states(number_of_states, false);
+  l.set_initial_state(0);
+  l.add_action(lts::action_label_string("a"));
+  l.add_action(lts::action_label_string("b"));
+  l.add_action(lts::action_label_string("c"));
+
+  const std::size_t copy_size = number_of_states / 4;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<std::size_t> target(0, copy_size - 1);
+  std::uniform_int_distribution<std::size_t> label(0, 3);
+  std::uniform_int_distribution<std::size_t> copy(0, 3);
+
+  for (std::size_t s = 0; s < copy_size; ++s)
+  {
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      const std::size_t t = target(generator);
+      const std::size_t a = label(generator);
+      for (std::size_t c = 0; c < 4; ++c)
+      {
+        // The copies are interleaved, such that the copy of the target is not the copy of the source.
+        l.add_transition(lts::transition(c * copy_size + s, a, copy(generator) * copy_size + t));
+      }
+    }
+  }
+
+  stopwatch timer;
+  lts::reduce(l, equivalence);
+  std::cerr << "time: " << timer.seconds() << std::endl;
+  std::cerr << "states: " << l.num_states() << std::endl;
+  return 0;
+}
@@ -29,7 +29,7 @@ lps::state remove_time_stamp(const lps::state& s)
 
 struct lts_builder
 {
-  typedef atermpp::indexed_set<lps::state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
+  typedef lps::indexed_set_for_states_type indexed_set_for_states_type;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
@@ -80,6 +80,7 @@ class lts_aut_builder: public lts_builder
 {
   protected:
     lts_aut_t m_lts;
+    utilities::accounted_memory m_transition_memory{utilities::memory_subsystem::lts};
 
   public:
     lts_aut_builder() = default;
@@ -88,6 +89,7 @@ class lts_aut_builder: public lts_builder
     {
       std::size_t label = add_action(a);
       m_lts.add_transition(transition(from, label, to));
+      m_transition_memory.update(m_lts.get_transitions().capacity() * sizeof(transition));
     }
 
     // Add actions and states to the LTS
@@ -153,6 +155,7 @@ class lts_lts_builder: public lts_builder
   protected:
     lts_lts_t m_lts;
     bool m_discard_state_labels = false;
+    utilities::accounted_memory m_transition_memory{utilities::memory_subsystem::lts};
 
   public:
     lts_lts_builder(
@@ -172,6 +175,7 @@ class lts_lts_builder: public lts_builder
     {
       std::size_t label = add_action(a);
       m_lts.add_transition(transition(from, label, to));
+      m_transition_memory.update(m_lts.get_transitions().capacity() * sizeof(transition));
     }
 
     // Add actions and states to the LTS
@@ -238,6 +242,7 @@ class lts_lts_disk_builder: public lts_builder
 
       mCRL2log(log::verbose) << "writing state space in LTS format to '" << filename << "'." << std::endl;
       stream = std::make_unique<atermpp::binary_aterm_ostream>(fstream);
+      stream->set_window_size(lts_stream_window_size);
 
       mcrl2::lts::write_lts_header(*stream, dataspec, process_parameters, action_labels);
     }
@@ -298,6 +298,10 @@ atermpp::aterm_ostream& operator<<(atermpp::aterm_ostream& stream, const probabi
 //  Write state labels (state_label_lts) in their order such that writing the i-th state label belongs to state with index i.
 //  Write the initial state.
 
+/// \brief The number of shared terms after which a binary LTS stream starts a new window, such that a reader never
+///        keeps more than this number of shared terms in memory.
+constexpr std::size_t lts_stream_window_size = 1 << 20;
+
 /// \brief Writes the start of an LTS stream.
 void write_lts_header(atermpp::aterm_ostream& stream,
   const data::data_specification& data,
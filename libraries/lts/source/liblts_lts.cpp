@@ -382,6 +382,7 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
   try
   {
     atermpp::binary_aterm_ostream stream(filename.empty() ? std::cout : fstream);
+    stream.set_window_size(lts_stream_window_size);
     stream << lts;
   }
   catch (const std::exception& ex)
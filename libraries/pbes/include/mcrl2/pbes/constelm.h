@@ -16,6 +16,9 @@
 #include "mcrl2/pbes/replace.h"
 #include "mcrl2/pbes/rewriters/enumerate_quantifiers_rewriter.h"
 
+#include <deque>
+#include <unordered_map>
+
 namespace mcrl2
 {
 
@@ -648,14 +651,12 @@ class pbes_constelm_algorithm
         }
 
         /// \brief Assign new values to the parameters of this vertex, and update the constraints accordingly.
-        /// The new values have a number of constraints.
-        bool update(const qvar_list& qvars, const data::data_expression_list& e, const constraint_map& e_constraints, const DataRewriter& datar)
+        /// The new values have a number of constraints, which are given by the substitution sigma.
+        bool update(const qvar_list& qvars, const data::data_expression_list& e, data::rewriter::substitution_type& sigma, const DataRewriter& datar)
         {
           bool changed = false;
 
           data::variable_list params = m_variable.parameters();
-          data::rewriter::substitution_type sigma;
-          detail::make_constelm_substitution(e_constraints, sigma);
 
           if (!m_visited)
           {
@@ -716,19 +717,19 @@ class pbes_constelm_algorithm
         }
     };
 
-    /// \brief The storage type for vertices
-    typedef std::map<core::identifier_string, vertex> vertex_map;
+    /// \brief The vertices of the dependency graph, in the order of the equations.
+    std::vector<vertex> m_vertices;
 
-    /// \brief The storage type for edges
-    typedef std::map<core::identifier_string, std::vector<edge> > edge_map;
+    /// \brief Maps the names of the propositional variables to the indices of their vertices.
+    std::unordered_map<core::identifier_string, std::size_t> m_vertex_index;
 
-    /// \brief The vertices of the dependency graph. They are stored in a map, to
-    /// support searching for a vertex.
-    vertex_map m_vertices;
+    /// \brief The out-edges of the vertices of the dependency graph, i.e. m_edges[i] contains the
+    /// out-edges of m_vertices[i].
+    std::vector<std::vector<edge> > m_edges;
 
-    /// \brief The edges of the dependency graph. They are stored in a map, to
-    /// easily access all out-edges corresponding to a particular vertex.
-    edge_map m_edges;
+    /// \brief The indices of the target vertices of the edges, i.e. m_edge_targets[i][j] is the index of
+    /// the target of m_edges[i][j].
+    std::vector<std::vector<std::size_t> > m_edge_targets;
 
     /// \brief The redundant parameters.
     std::map<core::identifier_string, std::vector<std::size_t> > m_redundant_parameters;
@@ -737,9 +738,9 @@ class pbes_constelm_algorithm
     std::string print_vertices() const
     {
       std::ostringstream out;
-      for (const auto& v: m_vertices)
+      for (const vertex& v: m_vertices)
       {
-        out << v.second.to_string() << std::endl;
+        out << v.to_string() << std::endl;
       }
       return out.str();
     }
@@ -748,9 +749,9 @@ class pbes_constelm_algorithm
     std::string print_edges()
     {
       std::ostringstream out;
-      for (const auto& source: m_edges)
+      for (const std::vector<edge>& source: m_edges)
       {
-        for (const auto& e: source.second)
+        for (const edge& e: source)
         {
           out << e.to_string() << std::endl;
         }
@@ -758,7 +759,7 @@ class pbes_constelm_algorithm
       return out.str();
     }
 
-    std::string print_todo_list(const std::deque<propositional_variable>& todo)
+    std::string print_todo_list(const std::deque<std::size_t>& todo)
     {
       std::ostringstream out;
       out << "\n<todo list> [";
@@ -768,7 +769,7 @@ class pbes_constelm_algorithm
         {
           out << ", ";
         }
-        out << core::pp(i->name());
+        out << core::pp(m_vertices[*i].variable().name());
       }
       out << "]" << std::endl;
       return out.str();
@@ -825,7 +826,7 @@ class pbes_constelm_algorithm
       std::map<propositional_variable, std::vector<data::variable> > result;
       for (const std::pair<const core::identifier_string, std::vector<std::size_t>>& red_pair: m_redundant_parameters)
       {
-        const vertex& v = m_vertices.find(red_pair.first)->second;
+        const vertex& v = m_vertices[m_vertex_index.at(red_pair.first)];
         std::vector<data::variable>& variables = result[v.variable()];
         for (const std::size_t par: red_pair.second)
         {
@@ -844,20 +845,31 @@ class pbes_constelm_algorithm
     void run(pbes& p, bool compute_conditions = false, bool check_quantifiers = true)
     {
       m_vertices.clear();
+      m_vertex_index.clear();
       m_edges.clear();
+      m_edge_targets.clear();
       m_redundant_parameters.clear();
 
-      // compute the vertices and edges of the dependency graph
-      for (pbes_equation& eqn: p.equations())
+      // compute the vertices of the dependency graph
+      m_vertices.reserve(p.equations().size());
+      for (const pbes_equation& eqn: p.equations())
       {
-        core::identifier_string name = eqn.variable().name();
-        m_vertices[name] = vertex(eqn.variable());
+        m_vertex_index[eqn.variable().name()] = m_vertices.size();
+        m_vertices.emplace_back(eqn.variable());
+      }
 
+      // compute the edges of the dependency graph
+      m_edges.resize(m_vertices.size());
+      m_edge_targets.resize(m_vertices.size());
+      std::size_t index = 0;
+      for (const pbes_equation& eqn: p.equations())
+      {
         // use an edge_condition_traverser to compute the edges
         detail::edge_condition_traverser f;
         f.apply(eqn.formula());
 
-        std::vector<edge>& edges = m_edges[name];
+        std::vector<edge>& edges = m_edges[index];
+        std::vector<std::size_t>& targets = m_edge_targets[index];
         for (const auto& [Q_X_e, details]: f.result())
         {
           const auto& [Q, X_e] = Q_X_e;
@@ -870,16 +882,23 @@ class pbes_constelm_algorithm
             : data::data_expression(data::sort_bool::true_());
 
           edges.emplace_back(eqn.variable(), quantifier_list, X_e, conj_FV, disj_FV, condition);
+          targets.push_back(m_vertex_index.at(X_e.name()));
         }
+        index++;
       }
 
-      // initialize the todo list of vertices that need to be processed
+      // initialize the todo list of vertices that need to be processed. A vertex is contained at most
+      // once in the todo list, which gives the same order as removing all later occurrences of a vertex
+      // when it is processed.
       propositional_variable_instantiation init = p.initial_state();
-      std::deque<propositional_variable> todo;
+      std::deque<std::size_t> todo;
+      std::vector<bool> in_todo(m_vertices.size(), false);
       const data::data_expression_list& e_init = init.parameters();
-      vertex& u_init = m_vertices[init.name()];
-      u_init.update(qvar_list(), e_init, constraint_map(), m_data_rewriter);
-      todo.push_back(u_init.variable());
+      std::size_t u_init = m_vertex_index.at(init.name());
+      data::rewriter::substitution_type sigma_init;
+      m_vertices[u_init].update(qvar_list(), e_init, sigma_init, m_data_rewriter);
+      todo.push_back(u_init);
+      in_todo[u_init] = true;
 
       mCRL2log(log::debug) << "\n--- initial vertices ---\n" << print_vertices();
       mCRL2log(log::debug) << "\n--- edges ---\n" << print_edges();
@@ -888,22 +907,27 @@ class pbes_constelm_algorithm
       while (!todo.empty())
       {
         mCRL2log(log::debug) << print_todo_list(todo);
-        propositional_variable var = todo.front();
-
-        // remove all occurrences of var from todo
-        todo.erase(std::remove(todo.begin(), todo.end(), var), todo.end());
-
-        const vertex& u = m_vertices[var.name()];
-        const std::vector<edge>& u_edges = m_edges[var.name()];
-
-        for (const edge& e: u_edges)
+        std::size_t i = todo.front();
+        todo.pop_front();
+        in_todo[i] = false;
+
+        // The constraints of u only change when u is updated, and then u is put in the todo list again. So the
+        // substitution is computed once for all out-edges of u. Note that u may be updated by a self loop.
+        const vertex& u = m_vertices[i];
+        data::rewriter::substitution_type sigma;
+        detail::make_constelm_substitution(u.constraints(), sigma);
+
+        const std::vector<edge>& u_edges = m_edges[i];
+        const std::vector<std::size_t>& u_targets = m_edge_targets[i];
+        for (std::size_t k = 0; k < u_edges.size(); ++k)
         {
-          vertex& v = m_vertices[e.target().name()];
+          const edge& e = u_edges[k];
+          vertex& v = m_vertices[u_targets[k]];
           mCRL2log(log::debug) << print_edge_update(e, u, v);
 
-          data::rewriter::substitution_type sigma;
-          detail::make_constelm_substitution(u.constraints(), sigma);
-          pbes_expression needs_update = m_pbes_rewriter(e.condition(), sigma);
+          // Conditions are only rewritten if they are not trivially true, which is always the case if
+          // compute_conditions is false.
+          pbes_expression needs_update = data::sort_bool::is_true_function_symbol(e.condition()) ? pbes_expression(e.condition()) : m_pbes_rewriter(e.condition(), sigma);
           mCRL2log(log::debug) << print_condition(e, u, needs_update);
 
           if (!is_false(needs_update) && !is_true(needs_update))
@@ -915,11 +939,21 @@ class pbes_constelm_algorithm
             bool changed = v.update(
                               concat(e.quantifier_inside_approximation(u.quantified_variables()), e.quantified_variables()),
                               e.target().parameters(),
-                              u.constraints(),
+                              sigma,
                               m_data_rewriter);
             if (changed)
             {
-              todo.push_back(v.variable());
+              if (&v == &u)
+              {
+                // The constraints of u have changed, so the substitution needs to be recomputed.
+                sigma = data::rewriter::substitution_type();
+                detail::make_constelm_substitution(u.constraints(), sigma);
+              }
+              if (!in_todo[u_targets[k]])
+              {
+                todo.push_back(u_targets[k]);
+                in_todo[u_targets[k]] = true;
+              }
             }
           }
           mCRL2log(log::debug) << "  <target vertex after > " << v.to_string() << "\n";
@@ -929,25 +963,23 @@ class pbes_constelm_algorithm
       mCRL2log(log::debug) << "\n--- final vertices ---\n" << print_vertices();
 
       // compute the redundant parameters and the redundant equations
-      for (const pbes_equation& eqn: p.equations())
+      for (const vertex& v: m_vertices)
       {
-        core::identifier_string name = eqn.variable().name();
-        const vertex& v = m_vertices[name];
         if (!v.constraints().empty())
         {
           std::vector<std::size_t> r = v.constant_parameter_indices();
           if (!r.empty())
           {
-            m_redundant_parameters[name] = r;
+            m_redundant_parameters[v.variable().name()] = r;
           }
         }
       }
 
       // Apply the constraints to the equations.
+      index = 0;
       for (pbes_equation& eqn: p.equations())
       {
-        core::identifier_string name = eqn.variable().name();
-        const vertex& v = m_vertices[name];
+        const vertex& v = m_vertices[index++];
 
         if (!v.constraints().empty())
         {
@@ -15,6 +15,8 @@
 #include "mcrl2/utilities/detail/iota.h"
 #include "mcrl2/utilities/reachable_nodes.h"
 
+#include <unordered_map>
+
 namespace mcrl2::pbes_system {
 
 namespace detail {
@@ -38,6 +40,20 @@ int variable_index(const data::variable_list& variables, const data::variable& d
   return -1;
 }
 
+/// \brief Maps the variables in a sequence to their indices
+/// \param variables A sequence of data variables
+inline
+std::unordered_map<data::variable, std::size_t> variable_indices(const data::variable_list& variables)
+{
+  std::unordered_map<data::variable, std::size_t> result;
+  std::size_t index = 0;
+  for (const data::variable& v: variables)
+  {
+    result.emplace(v, index++);
+  }
+  return result;
+}
+
 } // namespace detail
 
 /// \brief Algorithm class for the parelm algorithm
@@ -61,13 +77,14 @@ class pbes_parelm_algorithm
       using super::apply;
 
       graph& G;
-      const std::map<core::identifier_string, std::size_t>& propvar_offsets;
+      const std::unordered_map<core::identifier_string, std::size_t>& propvar_offsets;
 
       core::identifier_string X;
-      data::variable_list Xparams;
+      std::size_t Xoffset = 0;
+      std::unordered_map<data::variable, std::size_t> Xindices;
       std::multiset<data::variable> bound_variables;
 
-      parelm_dependency_traverser(graph& G_, const std::map<core::identifier_string, std::size_t>& propvar_offsets_)
+      parelm_dependency_traverser(graph& G_, const std::unordered_map<core::identifier_string, std::size_t>& propvar_offsets_)
         : G(G_), propvar_offsets(propvar_offsets_)
       {}
 
@@ -107,8 +124,8 @@ class pbes_parelm_algorithm
       {
         using utilities::detail::contains;
 
-        const core::identifier_string& Y = x.name();
-        int Yindex = 0;
+        std::size_t Yoffset = propvar_offsets.at(x.name());
+        std::size_t Yindex = 0;
         for (const data::data_expression& e: x.parameters())
         {
           for (const data::variable& var: data::find_free_variables(e))
@@ -117,13 +134,13 @@ class pbes_parelm_algorithm
             {
               continue;
             }
-            int Xindex = detail::variable_index(Xparams, var);
-            if (Xindex < 0)
+            auto Xindex = Xindices.find(var);
+            if (Xindex == Xindices.end())
             {
               continue;
             }
             // parameter (Y, Yindex) is influenced by (X, Xindex)
-            boost::add_edge(propvar_offsets.at(Y) + Yindex, propvar_offsets.at(X) + Xindex, G);
+            boost::add_edge(Yoffset + Yindex, Xoffset + Xindex->second, G);
           }
           Yindex++;
         }
@@ -132,7 +149,8 @@ class pbes_parelm_algorithm
       void apply(const pbes_equation& eqn)
       {
         X = eqn.variable().name();
-        Xparams = eqn.variable().parameters();
+        Xoffset = propvar_offsets.at(X);
+        Xindices = detail::variable_indices(eqn.variable().parameters());
         super::apply(eqn);
       }
     };
@@ -168,7 +186,7 @@ class pbes_parelm_algorithm
       return core::identifier_string("<not found>");
     }
 
-    static void compute_dependency_graph(const pbes& p, const std::map<core::identifier_string, std::size_t>& propvar_offsets, graph& G)
+    static void compute_dependency_graph(const pbes& p, const std::unordered_map<core::identifier_string, std::size_t>& propvar_offsets, graph& G)
     {
       parelm_dependency_traverser f(G, propvar_offsets);
       for (const pbes_equation& eqn: p.equations())
@@ -187,7 +205,7 @@ class pbes_parelm_algorithm
 
       // compute a mapping from propositional variable names to offsets
       std::size_t offset = 0;
-      std::map<core::identifier_string, std::size_t> propvar_offsets;
+      std::unordered_map<core::identifier_string, std::size_t> propvar_offsets;
       for (pbes_equation& eqn: p.equations())
       {
         propvar_offsets[eqn.variable().name()] = offset;
@@ -258,7 +276,7 @@ class pbes_parelm_algorithm
     }
 
     void print_removed_parameters(const std::vector<data::variable>& predicate_variables,
-                                  const std::map<core::identifier_string, std::size_t>& propvar_offsets,
+                                  const std::unordered_map<core::identifier_string, std::size_t>& propvar_offsets,
                                   const std::map<core::identifier_string, std::vector<std::size_t>>& removals) const
     {
       mCRL2log(log::verbose) << "\nremoving the following parameters:" << std::endl;
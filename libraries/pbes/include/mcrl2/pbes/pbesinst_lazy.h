@@ -28,6 +28,8 @@
 #include "mcrl2/pbes/rewriters/simplify_quantifiers_rewriter.h"
 #include "mcrl2/pbes/transformation_strategy.h"
 #include "mcrl2/pbes/transformations.h"
+#include "mcrl2/utilities/instrumentation.h"
+#include "mcrl2/utilities/memory_accounting.h"
 
 #ifndef MCRL2_PBES_PBESINST_LAZY_H
 #define MCRL2_PBES_PBESINST_LAZY_H
@@ -385,6 +387,7 @@ class pbesinst_lazy_algorithm
 
       if (m_options.number_of_threads>1) mCRL2log(log::debug) << "Start thread " << thread_index << ".\n";
       R.thread_initialise();
+      utilities::trace_span thread_span("pbesinst thread");
 
       propositional_variable_instantiation X_e;
       pbes_expression psi_e;
@@ -392,7 +395,7 @@ class pbesinst_lazy_algorithm
       while (number_of_active_processes > 0)
       {
         m_todo_access.lock();
-        while (!todo.elements().empty() && !m_must_abort)
+        while (!todo.elements().empty() && !m_must_abort && !utilities::memory_budget_exceeded())
         {
           ++m_iteration_count;
           mCRL2log(log::status) << status_message(m_iteration_count);
@@ -400,6 +403,7 @@ class pbesinst_lazy_algorithm
 
           next_todo(X_e);
           m_todo_access.unlock();
+          utilities::trace_span span("instantiate equation");
 
           std::size_t index = m_equation_index.index(X_e.name());
           const pbes_equation& eqn = m_pbes.equations()[index];
@@ -503,6 +507,7 @@ class pbesinst_lazy_algorithm
                    m_global_R
                   );
       }
+      utilities::check_memory_budget();
       on_end_while_loop();
     }
 
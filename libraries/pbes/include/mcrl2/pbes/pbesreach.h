@@ -20,6 +20,7 @@
 #include "mcrl2/pbes/normalize.h"
 #include "mcrl2/pbes/pbes_summand_group.h"
 #include "mcrl2/pbes/replace_constants_by_variables.h"
+#include "mcrl2/symbolic/exploration_checkpoint.h"
 #include "mcrl2/pbes/resolve_name_clashes.h"
 #include "mcrl2/pbes/rewriters/one_point_rule_rewriter.h"
 #include "mcrl2/pbes/srf_pbes.h"
@@ -174,13 +175,6 @@ pbes_system::srf_pbes split_conditions(const pbes_system::srf_pbes& pbes, std::s
   return result;
 }
 
-// Store information per lace worker.
-struct per_worker_information
-{
-  data::mutable_indexed_substitution<> m_sigma;
-  data::rewriter m_rewr;
-};
-
 class pbesreach_algorithm
 {
     using enumerator_element = data::enumerator_list_element_with_substitution<>;
@@ -188,6 +182,12 @@ class pbesreach_algorithm
     template <typename Context, bool ActionLabel>
     friend void symbolic::learn_successors_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
 
+    template <typename Context, bool ActionLabel>
+    friend void symbolic::learn_successors_parallel_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
+
+    template <typename Context, bool ActionLabel>
+    friend void symbolic::add_learned_successors(Context& context);
+
   protected:
     using ldd = sylvan::ldds::ldd;
     const symbolic_reachability_options& m_options;
@@ -204,11 +204,13 @@ class pbesreach_algorithm
     std::vector<boost::dynamic_bitset<>> m_summand_patterns;
     std::vector<boost::dynamic_bitset<>> m_group_patterns;
     std::vector<std::size_t> m_variable_order;
+    std::vector<std::unique_ptr<symbolic::learn_worker>> m_learn_workers; // used for learning transitions in parallel
 
     ldd m_visited;
     ldd m_todo;
     ldd m_deadlocks;
     ldd m_initial_vertex;
+    std::size_t m_iteration_count = 0;
 
     /// \brief Updates R.L := R.L U {(x,y) in R | x in X}
     void learn_successors(std::size_t i, pbes_summand_group& R, const ldd& X)
@@ -216,8 +218,31 @@ class pbesreach_algorithm
       mCRL2log(log::debug1) << "learn successors of summand group " << i << " for X = " << print_states(m_data_index, X, R.read) << std::endl;
 
       using namespace sylvan::ldds;
-      std::pair<pbesreach_algorithm&, pbes_summand_group&> context{*this, R};
-      sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<pbesreach_algorithm&, pbes_summand_group&>, false>, &context);
+      if (symbolic::parallel_learning_enabled())
+      {
+        // N.B. There are no action labels, so the action type is not used.
+        symbolic::learn_successors_parallel<data::data_expression, false>(*this, std::vector<pbes_summand_group*>{ &R }, std::vector<ldd>{ X }, m_learn_workers, m_rewr, m_pbes.data());
+      }
+      else
+      {
+        std::pair<pbesreach_algorithm&, pbes_summand_group&> context{*this, R};
+        sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<pbesreach_algorithm&, pbes_summand_group&>, false>, &context);
+      }
+    }
+
+    /// \brief Updates R[i].L := R[i].L U {(x,y) in R[i] | x in X} for all summand groups R[i], where the groups are learned concurrently
+    void learn_successors_all_groups(const ldd& X)
+    {
+      using namespace sylvan::ldds;
+      std::vector<pbes_summand_group*> groups;
+      std::vector<ldd> projections;
+      for (pbes_summand_group& R: m_summand_groups)
+      {
+        ldd proj = project(X, R.Ip);
+        groups.push_back(&R);
+        projections.push_back(m_options.cached ? minus(proj, R.Ldomain) : proj);
+      }
+      symbolic::learn_successors_parallel<data::data_expression, false>(*this, groups, projections, m_learn_workers, m_rewr, m_pbes.data());
     }
 
     pbes_system::srf_pbes preprocess(pbes_system::pbes pbesspec, bool make_total)
@@ -298,7 +323,7 @@ class pbesreach_algorithm
       m_summand_patterns = compute_read_write_patterns(m_pbes, m_process_parameters);
       symbolic::adjust_read_write_patterns(m_summand_patterns, m_options);
 
-      m_variable_order = symbolic::compute_variable_order(m_options.variable_order, m_process_parameters.size(), true);
+      m_variable_order = symbolic::compute_variable_order(m_options.variable_order, m_process_parameters.size(), m_summand_patterns, true);
       assert(m_variable_order[0] == 0); // It is required that the propositional variable name stays up front
       mCRL2log(log::debug) << "variable order = " << core::detail::print_list(m_variable_order) << std::endl;
       m_summand_patterns = symbolic::reorder_read_write_patterns(m_summand_patterns, m_variable_order);
@@ -375,12 +400,22 @@ class pbesreach_algorithm
         // regular and chaining.
         todo1 = m_options.chaining ? todo : empty_set();
 
+        // Without chaining all summand groups learn from todo, so they can be learned concurrently.
+        bool learn_all_groups = learn_transitions && !m_options.chaining && symbolic::parallel_learning_enabled();
+        if (learn_all_groups)
+        {
+          learn_successors_all_groups(todo);
+        }
+
         for (std::size_t i = 0; i < R.size(); i++)
         {
           if (learn_transitions)
           {
-            ldd proj = project(m_options.chaining ? todo1 : todo, R[i].Ip);
-            learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
+            if (!learn_all_groups)
+            {
+              ldd proj = project(m_options.chaining ? todo1 : todo, R[i].Ip);
+              learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
+            }
 
             mCRL2log(log::debug1) << "L =\n" << print_relation(m_data_index, R[i].L, R[i].read, R[i].write) << std::endl;
           }
@@ -446,15 +481,18 @@ class pbesreach_algorithm
     {
       using namespace sylvan::ldds;
       auto& R = m_summand_groups;
-      std::size_t iteration_count = 0;
+      std::size_t& iteration_count = m_iteration_count;
 
       mCRL2log(log::debug1) << "initial state = " << core::detail::print_list(m_initial_state) << std::endl;
 
       stopwatch timer;
       m_initial_vertex = initial_state();
-      m_visited = empty_set();
-      m_todo = m_initial_vertex;
-      m_deadlocks = empty_set();
+      if (iteration_count == 0) // otherwise the exploration is resumed from a checkpoint
+      {
+        m_visited = empty_set();
+        m_todo = m_initial_vertex;
+        m_deadlocks = empty_set();
+      }
 
       while (m_todo != empty_set() && !solution_found() && (m_options.max_iterations == 0 || iteration_count < m_options.max_iterations))
       {
@@ -482,6 +520,16 @@ class pbesreach_algorithm
 
         on_end_while_loop();
         sylvan::sylvan_stats_report(stderr);
+
+        if (!m_options.checkpoint_file.empty() && m_options.checkpoint_interval > 0 && iteration_count % m_options.checkpoint_interval == 0)
+        {
+          save_checkpoint(m_options.checkpoint_file);
+        }
+      }
+
+      if (!m_options.checkpoint_file.empty())
+      {
+        save_checkpoint(m_options.checkpoint_file);
       }
 
       if (report_states)
@@ -545,6 +593,47 @@ class pbesreach_algorithm
       return sylvan::ldds::empty_set();
     }
 
+    /// \brief Returns the state of the exploration, which can be used to resume it later on.
+    symbolic::exploration_checkpoint make_checkpoint()
+    {
+      symbolic::exploration_checkpoint result;
+      result.process_parameters = m_process_parameters;
+      result.data_index = m_data_index;
+      result.initial_state = initial_state();
+      result.visited = m_visited;
+      result.todo = m_todo;
+      result.deadlocks = m_deadlocks;
+      for (const pbes_summand_group& group: m_summand_groups)
+      {
+        result.summand_groups.push_back(symbolic::make_summand_group_checkpoint(group));
+      }
+      result.iteration_count = m_iteration_count;
+      return result;
+    }
+
+    void save_checkpoint(const std::string& filename)
+    {
+      mCRL2log(log::verbose) << "saving checkpoint to " << filename << " after " << m_iteration_count << " iterations" << std::endl;
+      symbolic::save_exploration_checkpoint(filename, make_checkpoint());
+    }
+
+    /// \brief Continues the exploration from the checkpoint. The learned transition relations and the data indices
+    ///        are reused, hence the checkpoint must have been created for the same PBES and options.
+    void load_checkpoint(const symbolic::exploration_checkpoint& checkpoint)
+    {
+      symbolic::check_exploration_checkpoint(checkpoint, m_process_parameters, m_data_index, initial_state(), m_summand_groups.size());
+      for (std::size_t i = 0; i < m_summand_groups.size(); i++)
+      {
+        symbolic::restore_summand_group(m_summand_groups[i], checkpoint.summand_groups[i], i);
+      }
+      m_data_index = checkpoint.data_index;
+      m_visited = checkpoint.visited;
+      m_todo = checkpoint.todo;
+      m_deadlocks = checkpoint.deadlocks;
+      m_iteration_count = checkpoint.iteration_count;
+      mCRL2log(log::verbose) << "resuming from a checkpoint after " << m_iteration_count << " iterations" << std::endl;
+    }
+
     std::vector<symbolic::summand_group> summand_groups() const
     {
       std::vector<symbolic::summand_group> result;
@@ -0,0 +1,356 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pg_binary_io.h
+/// \brief Versioned binary format for parity games.
+///
+/// A file in this format consists of a header, followed by a number of arrays.
+/// All integers are stored in little endian byte order, and each array starts
+/// at an offset that is a multiple of 8. This allows a reader to map the
+/// successor and predecessor arrays into memory without copying them.
+///
+///     header               pg_binary_header (64 bytes)
+///     owners               uint8[V]     0 = even, 1 = odd
+///     priorities           uint32[V]
+///     successor index      uint64[V + 1]
+///     successors           uint64[E]
+///     predecessor index    uint64[V + 1] (only if pg_binary_has_predecessors is set)
+///     predecessors         uint64[E]     (only if pg_binary_has_predecessors is set)
+///
+/// Successor and predecessor arrays are in compressed sparse row format: the
+/// successors of vertex v are successors[successor_index[v] .. successor_index[v + 1]),
+/// sorted in increasing order. Priorities use the min-parity convention, i.e. the
+/// lowest priority that occurs infinitely often determines the winner, and player even
+/// wins if it is even.
+
+#ifndef MCRL2_PBES_PG_BINARY_IO_H
+#define MCRL2_PBES_PG_BINARY_IO_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include "mcrl2/pbes/structure_graph.h"
+#include "mcrl2/utilities/file_utility.h"
+
+namespace mcrl2 {
+
+namespace pbes_system {
+
+/// \brief The version of the binary parity game format that is written.
+constexpr std::uint32_t pg_binary_version = 1;
+
+/// \brief Flag that is set if the file contains predecessor arrays.
+constexpr std::uint32_t pg_binary_has_predecessors = 1;
+
+/// \brief The magic bytes at the start of a binary parity game file.
+constexpr char pg_binary_magic[8] = { 'm', 'C', 'R', 'L', '2', 'P', 'G', '\0' };
+
+inline
+const utilities::file_format& pg_format_binary()
+{
+  static utilities::file_format result = []()
+  {
+    utilities::file_format format("pgbin", "Parity game in binary format", false);
+    format.add_extension("pgb");
+    return format;
+  }();
+  return result;
+}
+
+struct pg_binary_header
+{
+  std::uint32_t version = pg_binary_version;
+  std::uint32_t flags = 0;
+  std::uint64_t vertex_count = 0;
+  std::uint64_t edge_count = 0;
+  std::uint64_t priority_limit = 0; // all priorities are smaller than this value
+  std::uint64_t initial_vertex = 0;
+
+  static constexpr std::size_t size = 64;
+
+  bool has_predecessors() const
+  {
+    return (flags & pg_binary_has_predecessors) != 0;
+  }
+};
+
+/// \brief The offsets (in bytes) of the arrays in a binary parity game file.
+struct pg_binary_layout
+{
+  std::uint64_t owners;
+  std::uint64_t priorities;
+  std::uint64_t successor_index;
+  std::uint64_t successors;
+  std::uint64_t predecessor_index;
+  std::uint64_t predecessors;
+  std::uint64_t file_size;
+
+  explicit pg_binary_layout(const pg_binary_header& header)
+  {
+    auto align = [](std::uint64_t n) { return (n + 7) & ~std::uint64_t(7); };
+    const std::uint64_t V = header.vertex_count;
+    const std::uint64_t E = header.edge_count;
+    owners            = pg_binary_header::size;
+    priorities        = align(owners + V);
+    successor_index   = align(priorities + 4 * V);
+    successors        = successor_index + 8 * (V + 1);
+    predecessor_index = successors + 8 * E;
+    predecessors      = predecessor_index + 8 * (V + 1);
+    file_size         = header.has_predecessors() ? predecessors + 8 * E : predecessor_index;
+  }
+};
+
+namespace detail {
+
+/// \brief Writes the values in the range [first, last) as little endian integers of
+/// the given number of bytes, followed by zero bytes up to the next multiple of 8.
+template <std::size_t Bytes, typename Iter>
+void write_pg_binary_array(std::ostream& out, Iter first, Iter last)
+{
+  std::vector<char> buffer;
+  buffer.reserve(1 << 16);
+  std::size_t written = 0;
+  for (Iter i = first; i != last; ++i)
+  {
+    std::uint64_t value = *i;
+    for (std::size_t k = 0; k < Bytes; k++)
+    {
+      buffer.push_back(static_cast<char>((value >> (8 * k)) & 0xff));
+    }
+    if (buffer.size() + Bytes > buffer.capacity())
+    {
+      out.write(buffer.data(), buffer.size());
+      written += buffer.size();
+      buffer.clear();
+    }
+  }
+  written += buffer.size();
+  buffer.resize(buffer.size() + (8 - written % 8) % 8, 0);
+  out.write(buffer.data(), buffer.size());
+}
+
+inline
+void write_pg_binary_uint(char* dest, std::uint64_t value, std::size_t bytes)
+{
+  for (std::size_t k = 0; k < bytes; k++)
+  {
+    dest[k] = static_cast<char>((value >> (8 * k)) & 0xff);
+  }
+}
+
+inline
+std::uint64_t read_pg_binary_uint(const char* source, std::size_t bytes)
+{
+  std::uint64_t result = 0;
+  for (std::size_t k = 0; k < bytes; k++)
+  {
+    result |= std::uint64_t(static_cast<unsigned char>(source[k])) << (8 * k);
+  }
+  return result;
+}
+
+} // namespace detail
+
+inline
+void write_pg_binary_header(std::ostream& out, const pg_binary_header& header)
+{
+  char buffer[pg_binary_header::size] = { 0 };
+  std::memcpy(buffer, pg_binary_magic, 8);
+  detail::write_pg_binary_uint(buffer +  8, header.version, 4);
+  detail::write_pg_binary_uint(buffer + 12, header.flags, 4);
+  detail::write_pg_binary_uint(buffer + 16, header.vertex_count, 8);
+  detail::write_pg_binary_uint(buffer + 24, header.edge_count, 8);
+  detail::write_pg_binary_uint(buffer + 32, header.priority_limit, 8);
+  detail::write_pg_binary_uint(buffer + 40, header.initial_vertex, 8);
+  out.write(buffer, pg_binary_header::size);
+}
+
+/// \brief Reads and validates the header of a binary parity game.
+/// \exception mcrl2::runtime_error if the stream does not contain a supported binary parity game.
+inline
+pg_binary_header read_pg_binary_header(std::istream& in)
+{
+  char buffer[pg_binary_header::size];
+  if (!in.read(buffer, pg_binary_header::size) || std::memcmp(buffer, pg_binary_magic, 8) != 0)
+  {
+    throw mcrl2::runtime_error("The input does not contain a parity game in binary format.");
+  }
+  pg_binary_header header;
+  header.version        = static_cast<std::uint32_t>(detail::read_pg_binary_uint(buffer +  8, 4));
+  header.flags          = static_cast<std::uint32_t>(detail::read_pg_binary_uint(buffer + 12, 4));
+  header.vertex_count   = detail::read_pg_binary_uint(buffer + 16, 8);
+  header.edge_count     = detail::read_pg_binary_uint(buffer + 24, 8);
+  header.priority_limit = detail::read_pg_binary_uint(buffer + 32, 8);
+  header.initial_vertex = detail::read_pg_binary_uint(buffer + 40, 8);
+  if (header.version != pg_binary_version)
+  {
+    throw mcrl2::runtime_error("Unsupported version " + std::to_string(header.version) + " of the binary parity game format.");
+  }
+  if (header.vertex_count > 0 && header.initial_vertex >= header.vertex_count)
+  {
+    throw mcrl2::runtime_error("The initial vertex of the binary parity game is out of range.");
+  }
+  return header;
+}
+
+/// \brief Writes a parity game in binary format.
+/// \param owners The owners of the vertices (0 = even, 1 = odd).
+/// \param priorities The priorities of the vertices.
+/// \param successor_index The offsets of the successor lists, of size V + 1.
+/// \param successors The concatenated successor lists; each list must be sorted.
+/// \param initial_vertex The vertex for which the solution is requested.
+/// \param write_predecessors If true, the predecessor arrays are computed and written too.
+inline
+void write_pg_binary(std::ostream& out,
+                     const std::vector<std::uint8_t>& owners,
+                     const std::vector<std::uint32_t>& priorities,
+                     const std::vector<std::uint64_t>& successor_index,
+                     const std::vector<std::uint64_t>& successors,
+                     std::uint64_t initial_vertex,
+                     bool write_predecessors = true
+                    )
+{
+  const std::size_t V = owners.size();
+  assert(priorities.size() == V && successor_index.size() == V + 1 && successor_index[V] == successors.size());
+
+  pg_binary_header header;
+  header.flags = write_predecessors ? pg_binary_has_predecessors : 0;
+  header.vertex_count = V;
+  header.edge_count = successors.size();
+  header.priority_limit = priorities.empty() ? 0 : *std::max_element(priorities.begin(), priorities.end()) + 1;
+  header.initial_vertex = initial_vertex;
+
+  write_pg_binary_header(out, header);
+  detail::write_pg_binary_array<1>(out, owners.begin(), owners.end());
+  detail::write_pg_binary_array<4>(out, priorities.begin(), priorities.end());
+  detail::write_pg_binary_array<8>(out, successor_index.begin(), successor_index.end());
+  detail::write_pg_binary_array<8>(out, successors.begin(), successors.end());
+
+  if (write_predecessors)
+  {
+    // Counting sort of the edges on their target vertex. Since the sources are
+    // visited in increasing order, the predecessor lists are sorted as well.
+    std::vector<std::uint64_t> predecessor_index(V + 1, 0);
+    for (std::uint64_t w: successors)
+    {
+      predecessor_index[w + 1]++;
+    }
+    for (std::size_t v = 0; v < V; v++)
+    {
+      predecessor_index[v + 1] += predecessor_index[v];
+    }
+    std::vector<std::uint64_t> predecessors(successors.size());
+    std::vector<std::uint64_t> position(predecessor_index.begin(), predecessor_index.end() - 1);
+    for (std::size_t v = 0; v < V; v++)
+    {
+      for (std::uint64_t e = successor_index[v]; e < successor_index[v + 1]; e++)
+      {
+        predecessors[position[successors[e]]++] = v;
+      }
+    }
+    detail::write_pg_binary_array<8>(out, predecessor_index.begin(), predecessor_index.end());
+    detail::write_pg_binary_array<8>(out, predecessors.begin(), predecessors.end());
+  }
+}
+
+/// \brief Writes the vertices of the structure graph G that are not excluded as a
+/// parity game in binary format.
+/// \details Disjunctive vertices are owned by player even and conjunctive vertices by player
+/// odd. The vertices true and false get a self loop with priority 0 and 1 respectively. Vertices
+/// without a rank get the maximal rank of G, which does not influence the solution since every
+/// cycle contains a vertex with a rank.
+/// \exception mcrl2::runtime_error if G contains vertices that have not been explored.
+inline
+void save_structure_graph_pg_binary(const structure_graph& G, std::ostream& out, bool write_predecessors = true)
+{
+  const std::size_t N = G.all_vertices().size();
+  const std::uint64_t undefined = std::numeric_limits<std::uint64_t>::max();
+
+  // Renumber the vertices that are contained in G.
+  std::vector<std::uint64_t> index(N, undefined);
+  std::size_t V = 0;
+  std::size_t max_rank = 1;
+  for (std::size_t u = 0; u < N; u++)
+  {
+    if (G.contains(u))
+    {
+      index[u] = V++;
+      std::size_t rank = G.rank(u);
+      if (rank != data::undefined_index())
+      {
+        max_rank = std::max(max_rank, rank);
+      }
+    }
+  }
+  if (N == 0 || !G.contains(G.initial_vertex()))
+  {
+    throw mcrl2::runtime_error("Cannot save a structure graph without initial vertex as a parity game.");
+  }
+
+  std::vector<std::uint8_t> owners;
+  std::vector<std::uint32_t> priorities;
+  std::vector<std::uint64_t> successor_index;
+  std::vector<std::uint64_t> successors;
+  owners.reserve(V);
+  priorities.reserve(V);
+  successor_index.reserve(V + 1);
+  successor_index.push_back(0);
+
+  for (std::size_t u = 0; u < N; u++)
+  {
+    if (index[u] == undefined)
+    {
+      continue;
+    }
+    const structure_graph::vertex& u_ = G.find_vertex(u);
+    std::size_t first = successors.size();
+    if (u_.decoration == structure_graph::d_true || u_.decoration == structure_graph::d_false)
+    {
+      owners.push_back(0);
+      priorities.push_back(u_.decoration == structure_graph::d_true ? 0 : 1);
+      successors.push_back(index[u]);
+    }
+    else
+    {
+      owners.push_back(u_.decoration == structure_graph::d_conjunction ? 1 : 0);
+      priorities.push_back(static_cast<std::uint32_t>(u_.rank == data::undefined_index() ? max_rank : u_.rank));
+      for (structure_graph::index_type v: G.successors(u))
+      {
+        successors.push_back(index[v]);
+      }
+      if (successors.size() == first)
+      {
+        throw mcrl2::runtime_error("Cannot save a structure graph with unexplored vertices as a parity game.");
+      }
+      std::sort(successors.begin() + first, successors.end());
+      successors.erase(std::unique(successors.begin() + first, successors.end()), successors.end());
+    }
+    successor_index.push_back(successors.size());
+  }
+
+  write_pg_binary(out, owners, priorities, successor_index, successors, index[G.initial_vertex()], write_predecessors);
+}
+
+inline
+void save_structure_graph_pg_binary(const structure_graph& G, const std::string& filename, bool write_predecessors = true)
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out)
+  {
+    throw mcrl2::runtime_error("Could not open file " + filename + " for writing.");
+  }
+  save_structure_graph_pg_binary(G, out, write_predecessors);
+}
+
+} // namespace pbes_system
+
+} // namespace mcrl2
+
+#endif // MCRL2_PBES_PG_BINARY_IO_H
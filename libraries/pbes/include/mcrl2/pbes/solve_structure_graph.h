@@ -17,6 +17,7 @@
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/pbes/pbes_equation_index.h"
 #include "mcrl2/pbes/pbessolve_attractors.h"
+#include "mcrl2/utilities/instrumentation.h"
 
 namespace mcrl2 {
 
@@ -125,6 +126,7 @@ class solve_structure_graph_algorithm
     inline
     std::pair<vertex_set, vertex_set> solve_recursive(structure_graph& G)
     {
+      utilities::trace_span span("zielonka recursion");
       mCRL2log(log::debug) << "\n  --- solve_recursive input ---\n" << G << std::endl;
       std::size_t N = G.extent();
 
@@ -218,6 +220,7 @@ class solve_structure_graph_algorithm
     inline
     std::pair<vertex_set, vertex_set> solve_recursive_extended(structure_graph& G)
     {
+      utilities::trace_span span("solve parity game");
       mCRL2log(log::debug) << "\n  --- solve_recursive_extended input ---\n" << G << std::endl;
 
       std::size_t N = G.extent();
@@ -267,7 +270,7 @@ class solve_structure_graph_algorithm
       }
     }
 
-    static void insert_edge(atermpp::vector<structure_graph::vertex>& V, structure_graph::index_type ui, structure_graph::index_type vi)
+    static void insert_edge(structure_graph::vertex_vector& V, structure_graph::index_type ui, structure_graph::index_type vi)
     {
       using utilities::detail::contains;
       structure_graph::vertex& u = V[ui];
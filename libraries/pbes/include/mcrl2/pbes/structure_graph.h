@@ -17,6 +17,7 @@
 #include <boost/range/adaptor/filtered.hpp>
 
 #include "mcrl2/atermpp/standard_containers/vector.h"
+#include "mcrl2/utilities/memory_accounting.h"
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/pbes/pbes.h"
 
@@ -131,8 +132,12 @@ class structure_graph
       }
     };
 
+    /// \brief The vertices of a structure graph, of which the memory is accounted to the structure graph subsystem.
+    typedef atermpp::vector<vertex,
+      utilities::accounting_allocator<atermpp::detail::reference_aterm<vertex>, utilities::memory_subsystem::structure_graph>> vertex_vector;
+
   protected:
-    atermpp::vector<vertex> m_vertices;
+    vertex_vector m_vertices;
     index_type m_initial_vertex = 0;
     boost::dynamic_bitset<> m_exclude;
 
@@ -152,10 +157,10 @@ class structure_graph
 
     struct vertices_not_contained_in
     {
-      const atermpp::vector<vertex>& vertices;
+      const vertex_vector& vertices;
       const boost::dynamic_bitset<>& subset;
 
-      vertices_not_contained_in(const atermpp::vector<vertex>& vertices_, const boost::dynamic_bitset<>& subset_)
+      vertices_not_contained_in(const vertex_vector& vertices_, const boost::dynamic_bitset<>& subset_)
         : vertices(vertices_),
           subset(subset_)
       {}
@@ -170,7 +175,7 @@ class structure_graph
   public:
     structure_graph() = default;
 
-    structure_graph(atermpp::vector<vertex> vertices, index_type initial_vertex, boost::dynamic_bitset<> exclude)
+    structure_graph(vertex_vector vertices, index_type initial_vertex, boost::dynamic_bitset<> exclude)
       : m_vertices(std::move(vertices)),
         m_initial_vertex(initial_vertex),
         m_exclude(std::move(exclude))
@@ -196,7 +201,7 @@ class structure_graph
       return find_vertex(u).rank;
     }
 
-    const atermpp::vector<vertex>& all_vertices() const
+    const vertex_vector& all_vertices() const
     {
       return m_vertices;
     }
@@ -211,7 +216,7 @@ class structure_graph
       return find_vertex(u).successors;
     }
 
-    boost::filtered_range<vertices_not_contained_in, const atermpp::vector<vertex>> vertices() const
+    boost::filtered_range<vertices_not_contained_in, const vertex_vector> vertices() const
     {
       return all_vertices() | boost::adaptors::filtered(vertices_not_contained_in(m_vertices, m_exclude));
     }
@@ -77,12 +77,12 @@ struct structure_graph_builder
     return m_graph.extent();
   }
 
-  atermpp::vector<structure_graph::vertex>& vertices()
+  structure_graph::vertex_vector& vertices()
   {
     return m_graph.m_vertices;
   }
 
-  const atermpp::vector<structure_graph::vertex>& vertices() const
+  const structure_graph::vertex_vector& vertices() const
   {
     return m_graph.m_vertices;
   }
@@ -274,7 +274,7 @@ struct manual_structure_graph_builder
   typedef structure_graph::index_type index_type;
 
   structure_graph& m_graph;
-  atermpp::vector<structure_graph::vertex> m_vertices;
+  structure_graph::vertex_vector m_vertices;
   index_type m_initial_state; // The initial state.
 
   explicit manual_structure_graph_builder(structure_graph& G)
@@ -203,6 +203,8 @@ class symbolic_parity_game
   protected:
     ldd m_V[2]; // m_V[0] is the set of even nodes, m_V[1] is the set of odd nodes
     const std::vector<symbolic::summand_group> m_summand_groups;
+    std::vector<ldd> m_group_relations; // the relations L of the summand groups, used for parallel predecessor computations
+    std::vector<ldd> m_group_meta; // the meta data Ir of the summand groups
     std::map<std::size_t, ldd> m_rank_map;
     bool m_no_relprod = false;
     bool m_chaining = false;
@@ -227,6 +229,8 @@ class symbolic_parity_game
       using namespace sylvan::ldds;
       using utilities::detail::contains;
 
+      initialize_group_relations();
+
       // Determine priority and owner from the given pbes.
       auto equation_info = detail::compute_equation_info(pbes, data_index);
 
@@ -274,6 +278,8 @@ class symbolic_parity_game
     )
       : m_summand_groups(summand_groups), m_no_relprod(no_relprod), m_chaining(chaining), m_data_index(data_index), m_all_nodes(V)
     {
+      initialize_group_relations();
+
       m_V[0] = Veven;
       m_V[1] = minus(V, Veven);
 
@@ -514,6 +520,12 @@ class symbolic_parity_game
     {
       using namespace sylvan::ldds;
 
+      if (!m_no_relprod)
+      {
+        // The predecessors for the individual summand groups are computed by parallel Lace tasks.
+        return relprev_union(V, m_group_relations, m_group_meta, U);
+      }
+
       ldd result;
       for (int i = m_summand_groups.size() - 1; i >= 0; --i)
       {
@@ -548,6 +560,15 @@ class symbolic_parity_game
     }   
 
 private:
+    void initialize_group_relations()
+    {
+      for (const symbolic::summand_group& group: m_summand_groups)
+      {
+        m_group_relations.push_back(group.L);
+        m_group_meta.push_back(group.Ir);
+      }
+    }
+
     /// \returns The set { u in U | exists v in V: u -> v }, where -> is described by the given group.
     ldd predecessors(const ldd& U, const ldd& V, const symbolic::summand_group& group) const
     {
@@ -594,16 +615,9 @@ private:
       ldd Palpha = intersect(P, Vplayer[alpha]);
       ldd Pforced = minus(intersect(P, Vplayer[1-alpha]), I);
 
-      for (std::size_t i = 0; i < m_summand_groups.size(); ++i)
-      {
-        const symbolic::summand_group& group = m_summand_groups[i];
-
-        stopwatch watch;
-        Pforced = minus(Pforced, predecessors(Pforced, outside, group));
-
-        mCRL2log(log::debug1) << "removed 1 - alpha predecessors for group " << i << " out of " << m_summand_groups.size()
-                               << " (time = " << std::setprecision(2) << std::fixed << watch.seconds() << "s)\n";
-      }
+      // Since predecessors(U', V, group) = intersect(U', predecessors(U, V, group)) for U' subseteq U, removing the
+      // predecessors of outside group by group is the same as removing the predecessors for all groups at once.
+      Pforced = minus(Pforced, predecessors(Pforced, outside));
 
       return union_(Palpha, Pforced);
     } 
@@ -29,7 +29,8 @@ void pbesrewr(const std::string& input_filename,
               const utilities::file_format& input_format,
               const utilities::file_format& output_format,
               data::rewrite_strategy rewrite_strategy,
-              pbes_rewriter_type rewriter_type);
+              pbes_rewriter_type rewriter_type,
+              std::size_t number_of_threads = 1);
 
 void pbesconstelm(const std::string& input_filename,
                   const std::string& output_filename,
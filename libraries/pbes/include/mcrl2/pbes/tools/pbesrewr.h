@@ -13,6 +13,7 @@
 #define MCRL2_PBES_TOOLS_PBESREWR_H
 
 #include "mcrl2/data/detail/one_point_rule_preprocessor.h"
+#include "mcrl2/data/detail/thread_rewriters.h"
 #include "mcrl2/pbes/detail/bqnf_traverser.h"
 #include "mcrl2/pbes/detail/ppg_rewriter.h"
 #include "mcrl2/pbes/detail/ppg_traverser.h"
@@ -23,17 +24,44 @@
 #include "mcrl2/pbes/rewriter.h"
 #include "mcrl2/pbes/rewriters/one_point_rule_rewriter.h"
 #include "mcrl2/pbes/rewriters/quantifiers_inside_rewriter.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 namespace mcrl2 {
 
 namespace pbes_system {
 
+namespace detail {
+
+/// \brief Rewrites p with number_of_threads threads, by calling rewrite(x, R) for each equation x of p, where R is
+///        the rewriter of the thread that handles x. Thread 0 uses R and the other threads use clones of it.
+///        Finally the initial state is rewritten by the calling thread, by calling rewrite(p, R) without equations.
+/// \details As a term is only protected as long as the thread that created it exists, the results are assigned
+///          to the equations of p, which are owned by the calling thread.
+template <typename Rewriter, typename RewriteFunction>
+void parallel_pbes_rewrite(pbes& p, Rewriter& R, RewriteFunction rewrite, std::size_t number_of_threads)
+{
+  data::detail::thread_rewriters<Rewriter> rewriters(R, number_of_threads);
+  std::vector<pbes_equation>& equations = p.equations();
+  utilities::parallel_for(equations.size(), number_of_threads, [&](std::size_t i, std::size_t thread_index)
+  {
+    rewrite(equations[i], rewriters[thread_index]);
+  });
+
+  std::vector<pbes_equation> rewritten_equations;
+  rewritten_equations.swap(equations);
+  rewrite(p, R);
+  equations.swap(rewritten_equations);
+}
+
+} // namespace detail
+
 void pbesrewr(const std::string& input_filename,
               const std::string& output_filename,
               const utilities::file_format& input_format,
               const utilities::file_format& output_format,
               const data::rewrite_strategy rewrite_strategy,
-              pbes_rewriter_type rewriter_type)
+              pbes_rewriter_type rewriter_type,
+              std::size_t number_of_threads)
 {
   // load the pbes
   pbes p;
@@ -47,23 +75,26 @@ void pbesrewr(const std::string& input_filename,
   {
     case simplify:
     {
-      simplify_quantifiers_data_rewriter<data::rewriter> pbesr(datar);
-      //simplify_data_rewriter<data::rewriter> pbesr(datar);
-      pbes_rewrite(p, pbesr);
+      detail::parallel_pbes_rewrite(p, datar, [](auto& x, data::rewriter& r)
+        {
+          simplify_quantifiers_data_rewriter<data::rewriter> pbesr(r);
+          //simplify_data_rewriter<data::rewriter> pbesr(r);
+          pbes_rewrite(x, pbesr);
+        }, number_of_threads);
       break;
     }
     case quantifier_all:
     {
       bool enumerate_infinite_sorts = true;
       enumerate_quantifiers_rewriter pbesr(datar, p.data(), enumerate_infinite_sorts);
-      pbes_rewrite(p, pbesr);
+      detail::parallel_pbes_rewrite(p, pbesr, [](auto& x, enumerate_quantifiers_rewriter& r) { pbes_rewrite(x, r); }, number_of_threads);
       break;
     }
     case quantifier_finite:
     {
       bool enumerate_infinite_sorts = false;
       enumerate_quantifiers_rewriter pbesr(datar, p.data(), enumerate_infinite_sorts);
-      pbes_rewrite(p, pbesr);
+      detail::parallel_pbes_rewrite(p, pbesr, [](auto& x, enumerate_quantifiers_rewriter& r) { pbes_rewrite(x, r); }, number_of_threads);
       break;
     }
     case quantifier_inside:
@@ -80,8 +111,11 @@ void pbesrewr(const std::string& input_filename,
       replace_pbes_expressions(p, pbesr, innermost); // use replace, since the one point rule rewriter does the recursion itself
 
       // post processing: apply the simplifying rewriter
-      simplify_data_rewriter<data::rewriter> simp(datar);
-      pbes_rewrite(p, simp);
+      detail::parallel_pbes_rewrite(p, datar, [](auto& x, data::rewriter& r)
+        {
+          simplify_data_rewriter<data::rewriter> simp(r);
+          pbes_rewrite(x, simp);
+        }, number_of_threads);
       break;
     }
     case pfnf:
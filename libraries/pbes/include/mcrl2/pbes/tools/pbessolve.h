@@ -19,6 +19,7 @@
 #include "mcrl2/lps/detail/lps_io.h"
 #include "mcrl2/pbes/detail/pbes_io.h"
 #include "mcrl2/pbes/pbesinst_structure_graph2.h"
+#include "mcrl2/pbes/pg_binary_io.h"
 #include "mcrl2/utilities/input_output_tool.h"
 #include "mcrl2/utilities/parallel_tool.h"
 
@@ -51,6 +52,7 @@ class pbessolve_tool
   std::string lpsfile;
   std::string ltsfile;
   std::string evidence_file;
+  std::string pg_file;
 
   void add_options(utilities::interface_description& desc) override
   {
@@ -79,6 +81,11 @@ class pbessolve_tool
     desc.add_option("evidence-file", utilities::make_file_argument("NAME"),
                     "The file to which the evidence is written. If not set, a "
                     "default name will be chosen.");
+    desc.add_option("export-pg", utilities::make_file_argument("NAME"),
+                    "Save the instantiated parity game to NAME in binary "
+                    "format, such that it can be solved repeatedly using "
+                    "pbespgsolve without instantiating the PBES again. "
+                    "This requires --solve-strategy=0.");
     desc.add_option(
         "solve-strategy",
         utilities::make_enum_argument<int>("NAME")
@@ -162,6 +169,11 @@ class pbessolve_tool
       evidence_file = parser.option_argument("evidence-file");
     }
 
+    if (parser.has_option("export-pg"))
+    {
+      pg_file = parser.option_argument("export-pg");
+    }
+
     if (parser.has_option("long-strategy"))
     {
       options.optimization = parser.option_argument_as<int>("long-strategy");
@@ -196,6 +208,11 @@ class pbessolve_tool
       throw mcrl2::runtime_error("Invalid strategy " +
                                  std::to_string(options.optimization));
     }
+    if (!pg_file.empty() && options.optimization > 2)
+    {
+      throw mcrl2::runtime_error("Option --export-pg cannot be used in "
+                                 "combination with on-the-fly solving.");
+    }
     if (options.prune_todo_list && options.optimization < 2)
     {
       mCRL2log(log::warning) << "Option --prune-todo-list has no effect for "
@@ -235,6 +252,14 @@ class pbessolve_tool
     mCRL2log(log::verbose) << "Number of vertices in the structure graph: "
                            << G.all_vertices().size() << std::endl;
 
+    if (!pg_file.empty())
+    {
+      timer().start("export");
+      save_structure_graph_pg_binary(G, pg_file);
+      timer().finish("export");
+      mCRL2log(log::verbose) << "Saved parity game in " << pg_file << std::endl;
+    }
+
     if ((!lpsfile.empty() || !ltsfile.empty()) &&
         !has_counter_example_information(pbesspec))
     {
@@ -18,6 +18,7 @@
 #include "mcrl2/pbes/lps2pbes.h"
 #include "mcrl2/pbes/rewrite.h"
 #include "mcrl2/pbes/rewriter.h"
+#include "mcrl2/pbes/tools/pbesrewr.h"
 #include "mcrl2/pbes/txt2pbes.h"
 
 using namespace mcrl2;
@@ -52,3 +53,20 @@ BOOST_AUTO_TEST_CASE(test_pbesrewr2)
   pbes_rewrite(p, pbesr);
   BOOST_CHECK(p.is_well_typed());
 }
+
+BOOST_AUTO_TEST_CASE(test_pbesrewr_threads)
+{
+  lps::specification spec = remove_stochastic_operators(lps::linearise(lps::detail::ABP_SPECIFICATION()));
+  state_formulas::state_formula formula = state_formulas::parse_state_formula(lps::detail::NO_DEADLOCK(), spec);
+  bool timed = false;
+  pbes p1 = lps2pbes(spec, formula, timed);
+  pbes p2 = p1;
+
+  data::rewriter datar(p1.data(), data::jitty);
+  bool enumerate_infinite_sorts = true;
+  enumerate_quantifiers_rewriter pbesr(datar, p1.data(), enumerate_infinite_sorts);
+  pbes_rewrite(p1, pbesr);
+  detail::parallel_pbes_rewrite(p2, pbesr, [](auto& x, enumerate_quantifiers_rewriter& r) { pbes_rewrite(x, r); }, 3);
+  BOOST_CHECK(p2.is_well_typed());
+  BOOST_CHECK_EQUAL(pp(p1), pp(p2));
+}
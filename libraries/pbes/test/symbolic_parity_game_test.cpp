@@ -260,6 +260,23 @@ ldd forced_cycles(const symbolic_parity_game& G, const ldd& V, std::size_t alpha
   );
 }
 
+BOOST_AUTO_TEST_CASE(random_test_parallel_predecessors)
+{
+  initialise_sylvan();
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    auto [V, Veven, prio, groups, index] = compute_random_game(5000, 2);
+    symbolic_parity_game G(groups, index, V, Veven, prio, false, false);
+    symbolic_parity_game G_sequential(groups, index, V, Veven, prio, true, false);
+
+    ldd U = random_subset(V, 250);
+    BOOST_CHECK_EQUAL(G.predecessors(V, U), G_sequential.predecessors(V, U));
+  }
+
+  quit_sylvan();
+}
+
 BOOST_AUTO_TEST_CASE(random_test_attractor)
 {
   initialise_sylvan();
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -142,6 +143,16 @@ public:
     /*! Reset the graph based on the given edge structure. */
     void assign(edge_list edges, EdgeDirection edge_dir);
 
+    /*! Reset the graph to use the given successor and predecessor lists
+        without copying them. The lists are not freed by the graph; instead,
+        `storage` (e.g. a memory mapped file that contains the lists) is kept
+        alive for as long as the graph refers to them. Lists for directions
+        that are not in `edge_dir` are ignored. */
+    void assign_external( verti V, edgei E, EdgeDirection edge_dir,
+                          verti *successors, edgei *successor_index,
+                          verti *predecessors, edgei *predecessor_index,
+                          std::shared_ptr<void> storage );
+
     /*! Convert the graph into a list of edges. */
     edge_list get_edges() const;
 
@@ -253,6 +264,10 @@ protected:
         with `V` vertices and `E` edges. */
     void reset(verti V, edgei E, EdgeDirection edge_dir);
 
+    /*! Frees the successor/predecessor lists, unless they are owned by
+        `storage_`. */
+    void release();
+
     /*! Reset the graph to the subgraph induced by the given vertex set, using
         the given map data structure to create the vertex mapping. */
     template<class ForwardIterator, class VertexMapT>
@@ -285,6 +300,10 @@ private:
     /*! Direction of stored edges. */
     EdgeDirection edge_dir_;
 
+    /*! Owner of the successor/predecessor lists if they were assigned by
+        assign_external(), or NULL if they were allocated by the graph. */
+    std::shared_ptr<void> storage_;
+
 private:
     /* This is a bit of a hack to allow the small progress measures code to
        do a preprocessing pass for nodes with self-loops. */
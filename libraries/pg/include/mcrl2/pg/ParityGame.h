@@ -230,6 +230,17 @@ public:
         StaticGraph::EdgeDirection edge_dir = StaticGraph::EDGE_BIDIRECTIONAL,
         const std::string &rewrite_strategy = "jitty" );
 
+    /*! Read a game in the binary parity game format described in
+        mcrl2/pbes/pg_binary_io.h. Where possible, the successor and
+        predecessor lists are memory mapped from the file instead of copied.
+        If `goal_vertex` is non-NULL, it is set to the initial vertex. */
+    void read_binary( const std::string &file_path, verti *goal_vertex = 0,
+        StaticGraph::EdgeDirection edge_dir = StaticGraph::EDGE_BIDIRECTIONAL );
+
+    /*! Write a game in the binary parity game format, with `goal_vertex` as
+        its initial vertex. Requires that successors are stored. */
+    void write_binary(std::ostream &os, verti goal_vertex = 0) const;
+
     /*! Read raw parity game data from input stream */
     void read_raw(std::istream &is);
 
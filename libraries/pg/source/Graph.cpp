@@ -21,10 +21,26 @@ StaticGraph::StaticGraph()
 
 StaticGraph::~StaticGraph()
 {
-    delete[] successors_;
-    delete[] predecessors_;
-    delete[] successor_index_;
-    delete[] predecessor_index_;
+    release();
+}
+
+void StaticGraph::release()
+{
+    if (storage_)
+    {
+        storage_.reset();
+    }
+    else
+    {
+        delete[] successors_;
+        delete[] predecessors_;
+        delete[] successor_index_;
+        delete[] predecessor_index_;
+    }
+    successors_        = NULL;
+    predecessors_      = NULL;
+    successor_index_   = NULL;
+    predecessor_index_ = NULL;
 }
 
 void StaticGraph::clear()
@@ -38,10 +54,7 @@ void StaticGraph::reset(verti V, edgei E, EdgeDirection edge_dir)
     E_ = E;
     edge_dir_ = edge_dir;
 
-    delete[] successors_;
-    delete[] predecessors_;
-    delete[] successor_index_;
-    delete[] predecessor_index_;
+    release();
 
     if ((edge_dir & EDGE_SUCCESSOR))
     {
@@ -305,6 +318,35 @@ void StaticGraph::assign(const StaticGraph &graph)
     }
 }
 
+void StaticGraph::assign_external( verti V, edgei E, EdgeDirection edge_dir,
+                                   verti *successors, edgei *successor_index,
+                                   verti *predecessors, edgei *predecessor_index,
+                                   std::shared_ptr<void> storage )
+{
+    assert(storage);
+    release();
+
+    V_ = V;
+    E_ = E;
+    edge_dir_ = edge_dir;
+    storage_ = storage;
+
+    if (edge_dir & EDGE_SUCCESSOR)
+    {
+        assert(successors != NULL && successor_index != NULL);
+        assert(successor_index[V] == E);
+        successors_      = successors;
+        successor_index_ = successor_index;
+    }
+    if (edge_dir & EDGE_PREDECESSOR)
+    {
+        assert(predecessors != NULL && predecessor_index != NULL);
+        assert(predecessor_index[V] == E);
+        predecessors_      = predecessors;
+        predecessor_index_ = predecessor_index;
+    }
+}
+
 void StaticGraph::assign(edge_list edges, EdgeDirection edge_dir)
 {
     // Find number of vertices
@@ -505,6 +547,7 @@ void StaticGraph::swap(StaticGraph &g)
     std::swap(successor_index_, g.successor_index_);
     std::swap(predecessor_index_, g.predecessor_index_);
     std::swap(edge_dir_, g.edge_dir_);
+    std::swap(storage_, g.storage_);
 }
 
 #ifdef WITH_THREADS
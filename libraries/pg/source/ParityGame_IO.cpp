@@ -9,7 +9,15 @@
 
 #include "mcrl2/pbes/io.h"
 #include "mcrl2/pbes/parity_game_generator.h"
+#include "mcrl2/pbes/pg_binary_io.h"
 #include "mcrl2/pg/ParityGame.h"
+#include "mcrl2/utilities/platform.h"
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 /* N.B. The PGSolver I/O functions reverse the priorities when reading/writing
    the game description. This is done to preserve solutions, since PGSolver
@@ -230,6 +238,155 @@ void ParityGame::assign_pbes(mcrl2::pbes_system::pbes &pbes, verti *goal_vertex,
     graph_.assign(edges, edge_dir);
 }
 
+/* Returns whether the successor/predecessor lists of the binary format can be
+   used in place, i.e. whether verti and edgei are 64-bit little endian. */
+static bool binary_lists_are_native()
+{
+    const std::uint16_t probe = 1;
+    return sizeof(verti) == 8 && sizeof(edgei) == 8 &&
+           *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+/* Maps the first `size` bytes of the given file into memory, or returns NULL
+   if this is not possible. Pages are mapped copy-on-write, such that the graph
+   may still be modified in place (e.g. by StaticGraph::remove_edges()). */
+static std::shared_ptr<void> map_file(const std::string &file_path,
+                                      std::size_t size)
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) return std::shared_ptr<void>();
+    void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return std::shared_ptr<void>();
+    return std::shared_ptr<void>(addr, [size](void *p) { munmap(p, size); });
+#else
+    (void)file_path;
+    (void)size;
+    return std::shared_ptr<void>();
+#endif
+}
+
+void ParityGame::read_binary( const std::string &file_path, verti *goal_vertex,
+                              StaticGraph::EdgeDirection edge_dir )
+{
+    using mcrl2::pbes_system::detail::read_pg_binary_uint;
+
+    std::ifstream is(file_path.c_str(), std::ios::binary);
+    if (!is)
+    {
+        throw mcrl2::runtime_error("Could not open file " + file_path);
+    }
+    const mcrl2::pbes_system::pg_binary_header header =
+        mcrl2::pbes_system::read_pg_binary_header(is);
+    const mcrl2::pbes_system::pg_binary_layout layout(header);
+    const verti V = header.vertex_count;
+    const edgei E = header.edge_count;
+
+    is.seekg(0, std::ios::end);
+    if (!is || static_cast<std::uint64_t>(is.tellg()) < layout.file_size)
+    {
+        throw mcrl2::runtime_error("The parity game in " + file_path +
+                                   " is truncated.");
+    }
+    if (goal_vertex) *goal_vertex = header.initial_vertex;
+
+    // Vertex owners and priorities are always copied, since their in-memory
+    // representation differs from the file format.
+    std::vector<char> buffer(layout.successor_index - layout.owners);
+    is.seekg(layout.owners);
+    is.read(buffer.data(), buffer.size());
+    reset(V, (int)header.priority_limit);
+    const char *priorities = &buffer[layout.priorities - layout.owners];
+    for (verti v = 0; v < V; ++v)
+    {
+        vertex_[v].player   = buffer[v] ? PLAYER_ODD : PLAYER_EVEN;
+        vertex_[v].priority = read_pg_binary_uint(priorities + 4*v, 4);
+        if (vertex_[v].priority >= header.priority_limit)
+        {
+            throw mcrl2::runtime_error("The parity game in " + file_path +
+                                       " contains an invalid priority.");
+        }
+    }
+    recalculate_cardinalities(V);
+
+    if (V > 0 && binary_lists_are_native() &&
+        ((edge_dir & StaticGraph::EDGE_PREDECESSOR) == 0 ||
+         header.has_predecessors()))
+    {
+        std::shared_ptr<void> storage = map_file(file_path, layout.file_size);
+        if (storage)
+        {
+            char *base = static_cast<char*>(storage.get());
+            edgei *successor_index = reinterpret_cast<edgei*>(base + layout.successor_index);
+            edgei *predecessor_index = NULL;
+            verti *predecessors = NULL;
+            if (header.has_predecessors())
+            {
+                predecessor_index = reinterpret_cast<edgei*>(base + layout.predecessor_index);
+                predecessors = reinterpret_cast<verti*>(base + layout.predecessors);
+            }
+            if (successor_index[V] != E ||
+                (predecessor_index != NULL && predecessor_index[V] != E))
+            {
+                throw mcrl2::runtime_error("The parity game in " + file_path +
+                                           " has an invalid edge index.");
+            }
+            graph_.assign_external( V, E, edge_dir,
+                reinterpret_cast<verti*>(base + layout.successors),
+                successor_index, predecessors, predecessor_index, storage );
+            return;
+        }
+    }
+
+    // Fall back to reading the successor lists and rebuilding the graph.
+    std::vector<char> index(8*(V + 1)), successors(8*E);
+    is.seekg(layout.successor_index);
+    is.read(index.data(), index.size());
+    is.read(successors.data(), successors.size());
+    StaticGraph::edge_list edges;
+    edges.reserve(E);
+    for (verti v = 0; v < V; ++v)
+    {
+        edgei begin = read_pg_binary_uint(&index[8*v], 8),
+              end   = read_pg_binary_uint(&index[8*(v + 1)], 8);
+        if (begin > end || end > E)
+        {
+            throw mcrl2::runtime_error("The parity game in " + file_path +
+                                       " has an invalid edge index.");
+        }
+        for (edgei e = begin; e < end; ++e)
+        {
+            edges.push_back(std::make_pair(v,
+                (verti)read_pg_binary_uint(&successors[8*e], 8)));
+        }
+    }
+    graph_.assign(edges, edge_dir);
+}
+
+void ParityGame::write_binary(std::ostream &os, verti goal_vertex) const
+{
+    assert(graph_.edge_dir() & StaticGraph::EDGE_SUCCESSOR);
+
+    const verti V = graph_.V();
+    std::vector<std::uint8_t> owners(V);
+    std::vector<std::uint32_t> priorities(V);
+    std::vector<std::uint64_t> successor_index(V + 1, 0);
+    std::vector<std::uint64_t> successors;
+    successors.reserve(graph_.E());
+    for (verti v = 0; v < V; ++v)
+    {
+        owners[v] = player(v) == PLAYER_ODD ? 1 : 0;
+        priorities[v] = (std::uint32_t)priority(v);
+        successors.insert( successors.end(),
+                           graph_.succ_begin(v), graph_.succ_end(v) );
+        successor_index[v + 1] = successors.size();
+    }
+    mcrl2::pbes_system::write_pg_binary( os, owners, priorities,
+                                         successor_index, successors,
+                                         goal_vertex );
+}
+
 void ParityGame::read_raw(std::istream &is)
 {
     graph_.read_raw(is);
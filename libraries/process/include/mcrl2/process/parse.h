@@ -24,7 +24,7 @@ namespace detail {
 
 process_expression parse_process_expression_new(const std::string& text);
 process_specification parse_process_specification_new(const std::string& text);
-void complete_process_specification(process_specification& x, bool alpha_reduce = false);
+void complete_process_specification(process_specification& x, bool alpha_reduce = false, std::size_t number_of_threads = 1);
 
 } // namespace detail
 
@@ -37,14 +37,15 @@ process::action_label_list parse_action_declaration(const std::string& text, con
 
 /// \brief Parses a process specification from an input stream
 /// \param in An input stream
+/// \param number_of_threads The number of threads used to type check the specification
 /// \return The parse result
 inline
 process_specification
-parse_process_specification(std::istream& in)
+parse_process_specification(std::istream& in, std::size_t number_of_threads = 1)
 {
   std::string text = utilities::read_text(in);
   process_specification result = detail::parse_process_specification_new(text);
-  detail::complete_process_specification(result);
+  detail::complete_process_specification(result, false, number_of_threads);
   return result;
 }
 
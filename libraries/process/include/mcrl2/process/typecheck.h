@@ -17,6 +17,7 @@
 #include "mcrl2/process/detail/match_action_parameters.h"
 #include "mcrl2/process/detail/process_context.h"
 #include "mcrl2/process/normalize_sorts.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 namespace mcrl2
 {
@@ -592,6 +593,7 @@ class process_type_checker
     detail::action_context m_action_context;
     detail::process_context m_process_context;
     data::detail::variable_context m_variable_context;
+    std::size_t m_number_of_threads = 1;
 
     static std::vector<process_identifier> equation_identifiers(const std::vector<process_equation>& equations)
     {
@@ -618,8 +620,11 @@ class process_type_checker
     }
 
     /// \brief Default constructor
-    explicit process_type_checker(const data::data_specification& dataspec = data::data_specification())
-      : m_data_type_checker(dataspec)
+    /// \param dataspec A data specification
+    /// \param number_of_threads The number of threads that are used to type check the equations of a specification.
+    explicit process_type_checker(const data::data_specification& dataspec = data::data_specification(), std::size_t number_of_threads = 1)
+      : m_data_type_checker(dataspec, number_of_threads),
+        m_number_of_threads(number_of_threads)
     {}
 
     /** \brief     Type check a process expression.
@@ -638,7 +643,7 @@ class process_type_checker
       mCRL2log(log::verbose) << "type checking process specification..." << std::endl;
 
       // reset the context
-      m_data_type_checker = data::data_type_checker(procspec.data());
+      m_data_type_checker = data::data_type_checker(procspec.data(), m_number_of_threads);
 
       process::normalize_sorts(procspec, m_data_type_checker.typechecked_data_specification());
 
@@ -649,13 +654,17 @@ class process_type_checker
       m_variable_context.add_context_variables(procspec.global_variables(), m_data_type_checker);
       m_process_context.add_process_identifiers(equation_identifiers(procspec.equations()), m_action_context, m_data_type_checker);
 
-      // typecheck the equations
-      for (process_equation& eqn: procspec.equations())
+      // typecheck the equations, each thread with its own copy of the data type checker
+      std::vector<process_equation>& equations = procspec.equations();
+      std::vector<data::data_type_checker> data_type_checkers(m_number_of_threads > 1 ? m_number_of_threads - 1 : 0, m_data_type_checker);
+      utilities::parallel_for(equations.size(), m_number_of_threads, [&](std::size_t i, std::size_t thread_index)
       {
+        data::data_type_checker& data_type_checker = (thread_index == 0 ? m_data_type_checker : data_type_checkers[thread_index - 1]);
+        process_equation& eqn = equations[i];
         data::detail::variable_context variable_context = m_variable_context;
-        variable_context.add_context_variables(eqn.identifier().variables(), m_data_type_checker);
-        eqn = process_equation(eqn.identifier(), eqn.formal_parameters(), typecheck_process_expression(variable_context, eqn.expression(), &eqn.identifier()));
-      }
+        variable_context.add_context_variables(eqn.identifier().variables(), data_type_checker);
+        eqn = process_equation(eqn.identifier(), eqn.formal_parameters(), typecheck_process_expression(data_type_checker, variable_context, eqn.expression(), &eqn.identifier()));
+      });
 
       // typecheck the initial state
       procspec.init() = typecheck_process_expression(m_variable_context, procspec.init());
@@ -667,24 +676,30 @@ class process_type_checker
     }
 
   protected:
-    process_expression typecheck_process_expression(const data::detail::variable_context& variables, const process_expression& x, const process_identifier* current_equation = nullptr)
+    process_expression typecheck_process_expression(data::data_type_checker& data_type_checker, const data::detail::variable_context& variables, const process_expression& x, const process_identifier* current_equation = nullptr)
     {
       process_expression result;
-      detail::make_typecheck_builder(m_data_type_checker, variables, m_process_context, m_action_context, current_equation).apply(result, x);
+      detail::make_typecheck_builder(data_type_checker, variables, m_process_context, m_action_context, current_equation).apply(result, x);
       return result;
     }
+
+    process_expression typecheck_process_expression(const data::detail::variable_context& variables, const process_expression& x, const process_identifier* current_equation = nullptr)
+    {
+      return typecheck_process_expression(m_data_type_checker, variables, x, current_equation);
+    }
 };
 
 /** \brief     Type check a parsed mCRL2 process specification.
  *  Throws an exception if something went wrong.
  *  \param[in] proc_spec A process specification  that has not been type checked.
+ *  \param[in] number_of_threads The number of threads used to type check the equations.
  *  \post      proc_spec is type checked.
  **/
 
 inline
-void typecheck_process_specification(process_specification& proc_spec)
+void typecheck_process_specification(process_specification& proc_spec, std::size_t number_of_threads = 1)
 {
-  process_type_checker type_checker;
+  process_type_checker type_checker(data::data_specification(), number_of_threads);
   type_checker(proc_spec);
 }
 
@@ -156,9 +156,9 @@ process_specification parse_process_specification_new(const std::string& text)
   return result;
 }
 
-void complete_process_specification(process_specification& x, bool alpha_reduce)
+void complete_process_specification(process_specification& x, bool alpha_reduce, std::size_t number_of_threads)
 {
-  typecheck_process_specification(x);
+  typecheck_process_specification(x, number_of_threads);
   process::translate_user_notation(x);
   if (alpha_reduce)
   {
@@ -11,6 +11,7 @@
 
 #define BOOST_TEST_MODULE parse_test
 
+#include "mcrl2/core/parse.h"
 #include "mcrl2/process/parse.h"
 
 #include <boost/test/included/unit_test.hpp>
@@ -115,3 +116,36 @@ BOOST_AUTO_TEST_CASE(parse_process_expression_test)
   test_parse_process_expression("a . Q(n)", procspec.global_variables(), procspec.data(), procspec.action_labels(), process_identifiers);
 }
 
+
+BOOST_AUTO_TEST_CASE(test_parse_whitespace)
+{
+  std::string text =
+    "act  a: Nat;                     \n"
+    "proc P(i: Nat) = a(i) . P(i + 1);\n"
+    "init P(0);                       \n"
+    ;
+  std::string commented_text =
+    "% A specification with comments,\r\n"
+    "\t% tabs and carriage returns\r\n"
+    "act  a: Nat;  % an action\r\n"
+    "proc P(i: Nat) =%\r\n"
+    "  a(i) . P(i + 1);\r\n"
+    "init P(0);% the initial state";
+  BOOST_CHECK_EQUAL(process::pp(parse_process_specification(text)), process::pp(parse_process_specification(commented_text)));
+
+  // The '%' starts a comment, so the initial state is missing.
+  BOOST_CHECK_THROW(parse_process_specification("act a; proc P = a . P; % init P;"), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_sum)
+{
+  // Parsing a long sum and freeing its parse tree must not overflow the call stack.
+  std::string text = "a";
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    text += " + a";
+  }
+  core::parser p(parser_tables_mcrl2, core::detail::ambiguity_fn, core::detail::syntax_error_fn);
+  core::parse_node node = p.parse(text, p.start_symbol_index("ProcExpr"), false);
+  BOOST_CHECK_EQUAL(p.symbol_table().symbol_name(node), "ProcExpr");
+}
@@ -458,3 +458,60 @@ BOOST_AUTO_TEST_CASE(test_incomplete_assignment_in_init_clause)
   );
 }
 
+
+// Type checking with several threads must give the same specification and the same error as with one thread.
+BOOST_AUTO_TEST_CASE(test_parallel_typecheck)
+{
+  const std::string text =
+    "sort D = struct d1 | d2;\n"
+    "map  f: Nat -> Nat;\n"
+    "     g: D # Nat -> Int;\n"
+    "var  n: Nat;\n"
+    "     d: D;\n"
+    "eqn  f(0) = 1;\n"
+    "     f(n + 1) = 2 * f(n);\n"
+    "     g(d1, n) = n - 1;\n"
+    "     g(d2, n) = f(n) + 1;\n"
+    "act  a: Nat;\n"
+    "     b: Int;\n"
+    "proc P(n: Nat) = a(f(n)) . Q(d1, n) + (n < 10) -> a(n) . P(n + 1);\n"
+    "     Q(d: D, m: Nat) = b(g(d, m)) . P(m) + sum k: Nat . (k < m) -> b(k) . Q(d2, k);\n"
+    "     R = a(1) . R;\n"
+    "init P(0);\n";
+
+  process::process_specification spec1 = process::detail::parse_process_specification_new(text);
+  process::process_specification spec4 = spec1;
+  process::typecheck_process_specification(spec1, 1);
+  process::typecheck_process_specification(spec4, 4);
+  BOOST_CHECK_EQUAL(process::pp(spec1), process::pp(spec4));
+  BOOST_CHECK(spec1.data() == spec4.data());
+
+  const std::string wrong_text =
+    "act  a: Nat;\n"
+    "proc P = a(true) . P;\n"
+    "     Q = a(1) . Q;\n"
+    "     R = a(false) . R;\n"
+    "init P;\n";
+  std::string error1;
+  std::string error4;
+  try
+  {
+    process::process_specification spec = process::detail::parse_process_specification_new(wrong_text);
+    process::typecheck_process_specification(spec, 1);
+  }
+  catch (mcrl2::runtime_error& e)
+  {
+    error1 = e.what();
+  }
+  try
+  {
+    process::process_specification spec = process::detail::parse_process_specification_new(wrong_text);
+    process::typecheck_process_specification(spec, 4);
+  }
+  catch (mcrl2::runtime_error& e)
+  {
+    error4 = e.what();
+  }
+  BOOST_CHECK(!error1.empty());
+  BOOST_CHECK_EQUAL(error1, error4);
+}
@@ -0,0 +1,161 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/smt/incremental_solver.h
+/// \brief An SMT solver for the BDD prover that keeps a single solver session.
+
+#ifndef MCRL2_SMT_INCREMENTAL_SOLVER_H
+#define MCRL2_SMT_INCREMENTAL_SOLVER_H
+
+#include "mcrl2/data/detail/prover/smt_solver.h"
+#include "mcrl2/data/detail/prover/solver_type.h"
+#include "mcrl2/data/find.h"
+#include "mcrl2/smt/solver.h"
+#include "mcrl2/smt/translation_error.h"
+
+namespace mcrl2
+{
+namespace smt
+{
+
+/// \brief Checks the satisfiability of conjunctions of clauses using a single session of an SMT solver, in which
+///        the data specification is declared only once.
+/// \details Every clause is asserted in its own scope. The formulas passed to is_satisfiable are lists, and the
+///          scopes for the longest suffix that is shared with the previous formula are kept. This matches the
+///          formulas of the BDD path eliminator, which extends the current path at the front.
+class incremental_smt_solver: public data::detail::SMT_Solver
+{
+  protected:
+    smt_solver m_solver;
+
+    /// \brief The i-th element is the suffix of the formula that is asserted by the scopes 0 up to and including i.
+    std::vector<data::data_expression_list> m_asserted;
+
+    /// \brief The variables that have been declared in each of the scopes.
+    std::vector<std::vector<data::variable>> m_declared_in_scope;
+
+    /// \brief All declared variables.
+    std::set<data::variable> m_declared;
+
+    void pop_scope()
+    {
+      m_solver.pop();
+      m_asserted.pop_back();
+      for (const data::variable& v: m_declared_in_scope.back())
+      {
+        m_declared.erase(v);
+      }
+      m_declared_in_scope.pop_back();
+    }
+
+    void push_scope(const data::data_expression_list& suffix)
+    {
+      const data::data_expression& clause = suffix.front();
+      data::variable_list undeclared;
+      for (const data::variable& v: data::find_free_variables(clause))
+      {
+        if (m_declared.find(v) == m_declared.end())
+        {
+          undeclared.push_front(v);
+        }
+      }
+
+      m_solver.push();
+      m_asserted.push_back(suffix);
+      m_declared_in_scope.emplace_back();
+      try
+      {
+        m_solver.declare_variables(undeclared);
+        for (const data::variable& v: undeclared)
+        {
+          m_declared.insert(v);
+          m_declared_in_scope.back().push_back(v);
+        }
+        m_solver.add_assertion(clause);
+      }
+      catch (const translation_error&)
+      {
+        pop_scope();
+        throw;
+      }
+    }
+
+  public:
+    explicit incremental_smt_solver(const data::data_specification& dataspec)
+      : m_solver(dataspec)
+    {}
+
+    bool is_incremental() const override
+    {
+      return true;
+    }
+
+    /// \brief Returns false if the conjunction of the clauses in a_formula is unsatisfiable. If the solver cannot
+    ///        decide, or some clause cannot be translated, then true is returned.
+    bool is_satisfiable(const data::data_expression_list& a_formula) override
+    {
+      // The suffixes of a_formula, such that suffixes[i] has length i + 1.
+      std::vector<data::data_expression_list> suffixes(a_formula.size());
+      data::data_expression_list suffix = a_formula;
+      for (std::size_t i = suffixes.size(); i > 0; --i)
+      {
+        suffixes[i - 1] = suffix;
+        suffix.pop_front();
+      }
+
+      // Lists are maximally shared, so comparing them takes constant time.
+      std::size_t shared = 0;
+      while (shared < m_asserted.size() && shared < suffixes.size() && m_asserted[shared] == suffixes[shared])
+      {
+        shared++;
+      }
+      while (m_asserted.size() > shared)
+      {
+        pop_scope();
+      }
+
+      try
+      {
+        for (std::size_t i = shared; i < suffixes.size(); ++i)
+        {
+          push_scope(suffixes[i]);
+        }
+      }
+      catch (const translation_error& e)
+      {
+        mCRL2log(log::debug) << "Could not translate the formula for the SMT solver: " << e.what() << std::endl;
+        return true;
+      }
+      return m_solver.check() != answer::UNSAT;
+    }
+};
+
+/// \brief Returns an incremental solver for path elimination in the BDD prover if the solver type is z3, and nullptr
+///        otherwise or if the data specification cannot be translated. If nullptr is returned, the prover starts a
+///        separate solver of the given type for every formula.
+inline
+std::shared_ptr<data::detail::SMT_Solver> make_incremental_smt_solver(const data::data_specification& dataspec, data::detail::smt_solver_type solver_type)
+{
+  if (solver_type != data::detail::solver_type_z3)
+  {
+    return nullptr;
+  }
+  try
+  {
+    return std::make_shared<incremental_smt_solver>(dataspec);
+  }
+  catch (const translation_error& e)
+  {
+    mCRL2log(log::verbose) << "The data specification cannot be translated for an incremental SMT solver: " << e.what() << std::endl;
+    return nullptr;
+  }
+}
+
+} // namespace smt
+} // namespace mcrl2
+
+#endif // MCRL2_SMT_INCREMENTAL_SOLVER_H
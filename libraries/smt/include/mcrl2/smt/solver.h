@@ -27,14 +27,58 @@ protected:
   std::unordered_map<data::data_expression, std::string> m_cache;
   child_process z3;
 
+  /// \brief Output of the solver that has been read, but not yet consumed.
+  std::string m_output;
+
+  /// \brief The number of scopes that have been opened with push() and not yet closed.
+  std::size_t m_depth = 0;
+
 protected:
 
-  answer execute_and_check(const std::string& command, const std::chrono::microseconds& timeout) const;
+  /// \brief Reads a single line of output of the solver.
+  std::string read_line(const std::chrono::microseconds& timeout);
+
+  /// \brief Reads an answer to a (check-sat) command.
+  answer read_answer(const std::string& command, const std::chrono::microseconds& timeout);
+
+  answer execute_and_check(const std::string& command, const std::chrono::microseconds& timeout);
 
 public:
+  /// \brief Starts the solver and declares the translated data specification, which is done only once.
   smt_solver(const data::data_specification& dataspec);
 
+  /// \brief Checks whether expr is satisfiable, where vars are the free variables of expr. This does not change
+  ///        the assertions of the current scope.
   answer solve(const data::variable_list& vars, const data::data_expression& expr, const std::chrono::microseconds& timeout = std::chrono::microseconds::zero());
+
+  /// \brief Checks for each pair (vars, expr) of queries whether expr is satisfiable, where vars are the free
+  ///        variables of expr. The queries are sent to the solver in one batch, which avoids waiting for the
+  ///        answer of one query before sending the next.
+  /// \throws translation_error if one of the queries cannot be translated, in which case nothing is sent.
+  std::vector<answer> solve_all(const std::vector<std::pair<data::variable_list, data::data_expression>>& queries);
+
+  /// \brief Opens a new scope. Declarations and assertions made in this scope are removed by the matching pop().
+  void push();
+
+  /// \brief Closes the scope that was opened by the last push().
+  void pop();
+
+  /// \brief Returns the number of open scopes.
+  std::size_t depth() const
+  {
+    return m_depth;
+  }
+
+  /// \brief Declares the variables in the current scope.
+  /// \throws translation_error if the sort of a variable cannot be translated, in which case nothing is sent.
+  void declare_variables(const data::variable_list& vars);
+
+  /// \brief Adds the assertion expr to the current scope. The free variables of expr must have been declared.
+  /// \throws translation_error if expr cannot be translated, in which case nothing is sent.
+  void add_assertion(const data::data_expression& expr);
+
+  /// \brief Checks whether the assertions of all open scopes are satisfiable.
+  answer check(const std::chrono::microseconds& timeout = std::chrono::microseconds::zero());
 };
 
 } // namespace smt
@@ -18,10 +18,22 @@ namespace mcrl2
 namespace smt
 {
 
-answer smt_solver::execute_and_check(const std::string& s, const std::chrono::microseconds& timeout) const
+std::string smt_solver::read_line(const std::chrono::microseconds& timeout)
 {
-  z3.write(s);
-  std::string result = timeout == std::chrono::microseconds::zero() ? z3.read() : z3.read(timeout);
+  std::size_t end = m_output.find('\n');
+  while (end == std::string::npos)
+  {
+    m_output += timeout == std::chrono::microseconds::zero() ? z3.read() : z3.read(timeout);
+    end = m_output.find('\n');
+  }
+  std::string result = m_output.substr(0, end);
+  m_output.erase(0, end + 1);
+  return result;
+}
+
+answer smt_solver::read_answer(const std::string& s, const std::chrono::microseconds& timeout)
+{
+  std::string result = read_line(timeout);
   if(result.compare(0, 3, "sat") == 0)
   {
     return answer::SAT;
@@ -41,6 +53,12 @@ answer smt_solver::execute_and_check(const std::string& s, const std::chrono::mi
   }
 }
 
+answer smt_solver::execute_and_check(const std::string& s, const std::chrono::microseconds& timeout)
+{
+  z3.write(s);
+  return read_answer(s, timeout);
+}
+
 smt_solver::smt_solver(const data::data_specification& dataspec)
 : m_native(initialise_native_translation(dataspec))
 , z3("Z3")
@@ -52,8 +70,8 @@ smt_solver::smt_solver(const data::data_specification& dataspec)
 
 answer smt_solver::solve(const data::variable_list& vars, const data::data_expression& expr, const std::chrono::microseconds& timeout)
 {
-  z3.write("(push)\n");
   std::ostringstream out;
+  out << "(push)\n";
   translate_variable_declaration(vars, out, m_cache, m_native);
   translate_assertion(expr, out, m_cache, m_native);
   out << "(check-sat)\n";
@@ -62,6 +80,64 @@ answer smt_solver::solve(const data::variable_list& vars, const data::data_expre
   return result;
 }
 
+std::vector<answer> smt_solver::solve_all(const std::vector<std::pair<data::variable_list, data::data_expression>>& queries)
+{
+  // All queries are written before the first answer is read.
+  std::ostringstream out;
+  for (const auto& [vars, expr]: queries)
+  {
+    out << "(push)\n";
+    translate_variable_declaration(vars, out, m_cache, m_native);
+    translate_assertion(expr, out, m_cache, m_native);
+    out << "(check-sat)\n(pop)\n";
+  }
+
+  const std::string command = out.str();
+  z3.write(command);
+  std::vector<answer> result;
+  result.reserve(queries.size());
+  for (std::size_t i = 0; i < queries.size(); ++i)
+  {
+    result.push_back(read_answer(command, std::chrono::microseconds::zero()));
+  }
+  return result;
+}
+
+void smt_solver::push()
+{
+  z3.write("(push)\n");
+  m_depth++;
+}
+
+void smt_solver::pop()
+{
+  if (m_depth == 0)
+  {
+    throw mcrl2::runtime_error("Cannot pop a scope of the SMT-solver, since no scope is open.");
+  }
+  z3.write("(pop)\n");
+  m_depth--;
+}
+
+void smt_solver::declare_variables(const data::variable_list& vars)
+{
+  std::ostringstream out;
+  translate_variable_declaration(vars, out, m_cache, m_native);
+  z3.write(out.str());
+}
+
+void smt_solver::add_assertion(const data::data_expression& expr)
+{
+  std::ostringstream out;
+  translate_assertion(expr, out, m_cache, m_native);
+  z3.write(out.str());
+}
+
+answer smt_solver::check(const std::chrono::microseconds& timeout)
+{
+  return execute_and_check("(check-sat)\n", timeout);
+}
+
 
 namespace detail {
 
@@ -0,0 +1,122 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/symbolic/exploration_checkpoint.h
+/// \brief A persistent format for the state of a symbolic exploration.
+
+#ifndef MCRL2_SYMBOLIC_EXPLORATION_CHECKPOINT_H
+#define MCRL2_SYMBOLIC_EXPLORATION_CHECKPOINT_H
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/data/variable.h"
+#include "mcrl2/symbolic/data_index.h"
+#include "mcrl2/symbolic/summand_group.h"
+#include "mcrl2/utilities/exception.h"
+
+#include <sylvan_ldd.hpp>
+
+namespace mcrl2::symbolic
+{
+
+/// \brief The learned transition relation of a single summand group.
+struct summand_group_checkpoint
+{
+  std::vector<std::size_t> read;  // indices of the read parameters
+  std::vector<std::size_t> write; // indices of the write parameters
+  sylvan::ldds::ldd L;            // the projected transition relation
+  sylvan::ldds::ldd Ldomain;      // the domain of L (only nonempty if caching is used)
+};
+
+/// \brief Everything that is needed to continue a symbolic exploration (lpsreach or pbesreach), or to reuse the
+///        learned transition relations in a later exploration of the same specification.
+/// \details The vectors in the LDDs refer to the positions in the data indices, and to the positions in
+///          action_labels for the action label of a transition (if any).
+struct exploration_checkpoint
+{
+  data::variable_list process_parameters;    // the process parameters in the variable order of the exploration
+  std::vector<data_expression_index> data_index;
+  std::vector<atermpp::aterm> action_labels; // the entries of the action index (empty for PBESs)
+  sylvan::ldds::ldd initial_state;
+  sylvan::ldds::ldd visited;
+  sylvan::ldds::ldd todo;
+  sylvan::ldds::ldd deadlocks;
+  std::vector<summand_group_checkpoint> summand_groups;
+  std::size_t iteration_count = 0;            // the number of breadth-first iterations that have been done
+};
+
+/// \brief Creates a checkpoint entry for a summand group.
+inline
+summand_group_checkpoint make_summand_group_checkpoint(const summand_group& group)
+{
+  return summand_group_checkpoint{ group.read, group.write, group.L, group.Ldomain };
+}
+
+/// \brief Restores the learned relation of group from the checkpoint entry.
+/// \throws mcrl2::runtime_error if the read and write parameters of the group are different.
+inline
+void restore_summand_group(summand_group& group, const summand_group_checkpoint& checkpoint, std::size_t i)
+{
+  if (group.read != checkpoint.read || group.write != checkpoint.write)
+  {
+    throw mcrl2::runtime_error("The read and write parameters of summand group " + std::to_string(i) + " do not match the checkpoint.");
+  }
+  group.L = checkpoint.L;
+  group.Ldomain = checkpoint.Ldomain;
+}
+
+/// \brief Checks that the checkpoint belongs to an exploration with the given parameters, initial state and number
+///        of summand groups.
+/// \throws mcrl2::runtime_error if this is not the case.
+inline
+void check_exploration_checkpoint(const exploration_checkpoint& checkpoint,
+                                  const data::variable_list& process_parameters,
+                                  const std::vector<data_expression_index>& data_index,
+                                  const sylvan::ldds::ldd& initial_state,
+                                  std::size_t number_of_summand_groups)
+{
+  if (checkpoint.process_parameters != process_parameters)
+  {
+    throw mcrl2::runtime_error("The process parameters (in the chosen variable order) do not match the checkpoint.");
+  }
+  if (checkpoint.summand_groups.size() != number_of_summand_groups)
+  {
+    throw mcrl2::runtime_error("The checkpoint contains " + std::to_string(checkpoint.summand_groups.size()) + " summand groups, but "
+                               + std::to_string(number_of_summand_groups) + " were expected.");
+  }
+
+  // The initial states are compared by value, since they may have been numbered differently.
+  std::vector<std::vector<std::uint32_t>> x = sylvan::ldds::ldd_solutions(initial_state);
+  std::vector<std::vector<std::uint32_t>> y = sylvan::ldds::ldd_solutions(checkpoint.initial_state);
+  bool equal = x.size() == 1 && y.size() == 1 && x[0].size() == y[0].size() && x[0].size() == data_index.size();
+  for (std::size_t i = 0; equal && i < data_index.size(); i++)
+  {
+    equal = y[0][i] < checkpoint.data_index[i].size() && data_index[i][x[0][i]] == checkpoint.data_index[i][y[0][i]];
+  }
+  if (!equal)
+  {
+    throw mcrl2::runtime_error("The initial state does not match the checkpoint.");
+  }
+}
+
+/// \brief Writes the checkpoint to the stream.
+void save_exploration_checkpoint(std::ostream& stream, const exploration_checkpoint& checkpoint);
+
+/// \brief Writes the checkpoint to the file with the given name.
+void save_exploration_checkpoint(const std::string& filename, const exploration_checkpoint& checkpoint);
+
+/// \brief Reads a checkpoint from the stream.
+void load_exploration_checkpoint(std::istream& stream, exploration_checkpoint& checkpoint);
+
+/// \brief Reads a checkpoint from the file with the given name.
+void load_exploration_checkpoint(const std::string& filename, exploration_checkpoint& checkpoint);
+
+} // namespace mcrl2::symbolic
+
+#endif // MCRL2_ENABLE_SYLVAN
+
+#endif // MCRL2_SYMBOLIC_EXPLORATION_CHECKPOINT_H
@@ -18,6 +18,7 @@
 #include <boost/dynamic_bitset.hpp>
 
 #include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <iterator>
 #include <random>
@@ -210,8 +211,351 @@ std::vector<std::size_t> parse_variable_order(std::string text, std::size_t n, b
   return result;
 }
 
+// Returns for each variable the set of variables that are used together with it in some summand. A variable is used
+// in a summand if it is read or written, according to the read/write patterns.
 inline
-std::vector<std::size_t> compute_variable_order(const std::string& text, std::size_t number_of_variables, bool exclude_first_variable = false)
+std::vector<std::set<std::size_t>> variable_interaction_graph(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n)
+{
+  std::vector<std::set<std::size_t>> result(n);
+  for (const boost::dynamic_bitset<>& pattern: patterns)
+  {
+    std::vector<std::size_t> used;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      if (pattern[2*i] || pattern[2*i+1])
+      {
+        used.push_back(i);
+      }
+    }
+    for (std::size_t i: used)
+    {
+      for (std::size_t j: used)
+      {
+        if (i != j)
+        {
+          result[i].insert(j);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+// Returns the sum over all summands of the distance between the first and the last used variable in the given
+// variable order. This is the quantity that is minimized by the FORCE heuristic.
+inline
+std::size_t variable_order_span(const std::vector<boost::dynamic_bitset<>>& patterns, const std::vector<std::size_t>& variable_order)
+{
+  std::size_t result = 0;
+  for (const boost::dynamic_bitset<>& pattern: patterns)
+  {
+    std::size_t first = variable_order.size();
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < variable_order.size(); i++)
+    {
+      std::size_t j = variable_order[i];
+      if (pattern[2*j] || pattern[2*j+1])
+      {
+        first = std::min(first, i);
+        last = i;
+      }
+    }
+    if (first <= last)
+    {
+      result += last - first;
+    }
+  }
+  return result;
+}
+
+namespace detail {
+
+// Returns the distances from source to all vertices of the graph, or n for unreachable vertices.
+inline
+std::vector<std::size_t> breadth_first_distances(const std::vector<std::set<std::size_t>>& graph, std::size_t source)
+{
+  std::size_t n = graph.size();
+  std::vector<std::size_t> result(n, n);
+  std::deque<std::size_t> todo{ source };
+  result[source] = 0;
+  while (!todo.empty())
+  {
+    std::size_t u = todo.front();
+    todo.pop_front();
+    for (std::size_t v: graph[u])
+    {
+      if (result[v] == n)
+      {
+        result[v] = result[u] + 1;
+        todo.push_back(v);
+      }
+    }
+  }
+  return result;
+}
+
+// Returns an unvisited vertex of minimal degree.
+inline
+std::size_t minimal_degree_vertex(const std::vector<std::set<std::size_t>>& graph, const std::vector<bool>& visited)
+{
+  std::size_t result = graph.size();
+  for (std::size_t i = 0; i < graph.size(); i++)
+  {
+    if (!visited[i] && (result == graph.size() || graph[i].size() < graph[result].size()))
+    {
+      result = i;
+    }
+  }
+  return result;
+}
+
+// Returns a pair (s, e) of pseudo-peripheral vertices in the component of u, i.e. vertices that are far apart.
+inline
+std::pair<std::size_t, std::size_t> pseudo_peripheral_vertices(const std::vector<std::set<std::size_t>>& graph, std::size_t u)
+{
+  std::size_t n = graph.size();
+  std::size_t s = u;
+  std::size_t eccentricity = 0;
+  while (true)
+  {
+    std::vector<std::size_t> dist = breadth_first_distances(graph, s);
+
+    // Choose the vertex with minimal degree among the vertices that are farthest away from s.
+    std::size_t e = s;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      if (dist[i] == n)
+      {
+        continue;
+      }
+      if (dist[i] > dist[e] || (dist[i] == dist[e] && graph[i].size() < graph[e].size()))
+      {
+        e = i;
+      }
+    }
+
+    if (dist[e] <= eccentricity)
+    {
+      return { s, e };
+    }
+    eccentricity = dist[e];
+    std::swap(s, e);
+  }
+}
+
+// The propositional variable name of a PBES must stay up front.
+inline
+void move_first_variable_to_front(std::vector<std::size_t>& variable_order, bool exclude_first_variable)
+{
+  if (exclude_first_variable && !variable_order.empty())
+  {
+    std::stable_partition(variable_order.begin(), variable_order.end(), [](std::size_t i) { return i == 0; });
+  }
+}
+
+} // namespace detail
+
+// Orders the variables using the Cuthill-McKee algorithm on the variable interaction graph, such that variables that
+// are used together by summands are put close to each other.
+inline
+std::vector<std::size_t> compute_variable_order_cuthill_mckee(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n, bool exclude_first_variable = false)
+{
+  std::vector<std::set<std::size_t>> graph = variable_interaction_graph(patterns, n);
+  std::vector<std::size_t> result;
+  std::vector<bool> visited(n, false);
+
+  while (result.size() < n)
+  {
+    std::size_t start = detail::pseudo_peripheral_vertices(graph, detail::minimal_degree_vertex(graph, visited)).first;
+    std::deque<std::size_t> todo{ start };
+    visited[start] = true;
+    while (!todo.empty())
+    {
+      std::size_t u = todo.front();
+      todo.pop_front();
+      result.push_back(u);
+
+      std::vector<std::size_t> successors;
+      for (std::size_t v: graph[u])
+      {
+        if (!visited[v])
+        {
+          visited[v] = true;
+          successors.push_back(v);
+        }
+      }
+      std::stable_sort(successors.begin(), successors.end(), [&](std::size_t i, std::size_t j) { return graph[i].size() < graph[j].size(); });
+      todo.insert(todo.end(), successors.begin(), successors.end());
+    }
+  }
+
+  detail::move_first_variable_to_front(result, exclude_first_variable);
+  return result;
+}
+
+// Orders the variables using Sloan's profile reduction algorithm on the variable interaction graph.
+inline
+std::vector<std::size_t> compute_variable_order_sloan(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n, bool exclude_first_variable = false)
+{
+  enum class status { inactive, preactive, active, postactive };
+
+  // The weights of the global (distance to the end vertex) and local (degree) criteria, as proposed by Sloan.
+  const long W1 = 1;
+  const long W2 = 2;
+
+  std::vector<std::set<std::size_t>> graph = variable_interaction_graph(patterns, n);
+  std::vector<std::size_t> result;
+  std::vector<status> state(n, status::inactive);
+  std::vector<long> priority(n, 0);
+  std::vector<bool> visited(n, false);
+
+  while (result.size() < n)
+  {
+    auto [s, e] = detail::pseudo_peripheral_vertices(graph, detail::minimal_degree_vertex(graph, visited));
+    std::vector<std::size_t> dist = detail::breadth_first_distances(graph, e);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      if (dist[i] < n)
+      {
+        priority[i] = W1 * static_cast<long>(dist[i]) - W2 * static_cast<long>(graph[i].size() + 1);
+      }
+    }
+
+    std::vector<std::size_t> queue{ s };
+    state[s] = status::preactive;
+
+    auto make_preactive = [&](std::size_t k)
+    {
+      if (state[k] == status::inactive)
+      {
+        state[k] = status::preactive;
+        queue.push_back(k);
+      }
+    };
+
+    while (!queue.empty())
+    {
+      auto max = std::max_element(queue.begin(), queue.end(), [&](std::size_t i, std::size_t j) { return priority[i] < priority[j]; });
+      std::size_t i = *max;
+      queue.erase(max);
+
+      if (state[i] == status::preactive)
+      {
+        for (std::size_t j: graph[i])
+        {
+          priority[j] += W2;
+          make_preactive(j);
+        }
+      }
+      state[i] = status::postactive;
+      visited[i] = true;
+      result.push_back(i);
+
+      for (std::size_t j: graph[i])
+      {
+        if (state[j] == status::preactive)
+        {
+          state[j] = status::active;
+          priority[j] += W2;
+          for (std::size_t k: graph[j])
+          {
+            if (state[k] != status::postactive)
+            {
+              priority[k] += W2;
+              make_preactive(k);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  detail::move_first_variable_to_front(result, exclude_first_variable);
+  return result;
+}
+
+// Orders the variables using the FORCE heuristic of Aloul, Markov and Sakallah. Each summand pulls the variables it
+// uses towards their center of gravity, until the total span of the summands no longer decreases.
+inline
+std::vector<std::size_t> compute_variable_order_force(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n, bool exclude_first_variable = false, std::size_t max_iterations = 200)
+{
+  // For each summand the variables it uses.
+  std::vector<std::vector<std::size_t>> edges;
+  for (const boost::dynamic_bitset<>& pattern: patterns)
+  {
+    std::vector<std::size_t> used;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      if (pattern[2*i] || pattern[2*i+1])
+      {
+        used.push_back(i);
+      }
+    }
+    if (!used.empty())
+    {
+      edges.push_back(used);
+    }
+  }
+
+  std::vector<std::size_t> order = compute_variable_order_default(n);
+  std::vector<std::size_t> best = order;
+  std::size_t best_span = variable_order_span(patterns, order);
+  std::size_t previous_span = best_span;
+
+  std::vector<double> position(n);
+  for (std::size_t iteration = 0; iteration < max_iterations; iteration++)
+  {
+    for (std::size_t i = 0; i < n; i++)
+    {
+      position[order[i]] = static_cast<double>(i);
+    }
+
+    std::vector<double> sum(n, 0.0);
+    std::vector<std::size_t> count(n, 0);
+    for (const std::vector<std::size_t>& edge: edges)
+    {
+      double center = 0.0;
+      for (std::size_t i: edge)
+      {
+        center += position[i];
+      }
+      center /= static_cast<double>(edge.size());
+      for (std::size_t i: edge)
+      {
+        sum[i] += center;
+        count[i]++;
+      }
+    }
+
+    std::vector<double> new_position(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      new_position[i] = count[i] == 0 ? position[i] : sum[i] / static_cast<double>(count[i]);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) { return new_position[i] < new_position[j]; });
+
+    std::size_t span = variable_order_span(patterns, order);
+    if (span < best_span)
+    {
+      best = order;
+      best_span = span;
+    }
+    if (span >= previous_span)
+    {
+      break;
+    }
+    previous_span = span;
+  }
+
+  detail::move_first_variable_to_front(best, exclude_first_variable);
+  return best;
+}
+
+/// \brief Computes a variable order from a textual description.
+/// \param text Either 'none', 'random', 'cuthill-mckee', 'sloan', 'force' or a permutation of [0 .. n).
+/// \param patterns The read/write patterns of the summands, which are used by the heuristics.
+inline
+std::vector<std::size_t> compute_variable_order(const std::string& text, std::size_t number_of_variables, const std::vector<boost::dynamic_bitset<>>& patterns, bool exclude_first_variable = false)
 {
   if (text == "none")
   {
@@ -221,6 +565,18 @@ std::vector<std::size_t> compute_variable_order(const std::string& text, std::si
   {
     return compute_variable_order_random(number_of_variables, exclude_first_variable);
   }
+  else if (text == "cuthill-mckee")
+  {
+    return compute_variable_order_cuthill_mckee(patterns, number_of_variables, exclude_first_variable);
+  }
+  else if (text == "sloan")
+  {
+    return compute_variable_order_sloan(patterns, number_of_variables, exclude_first_variable);
+  }
+  else if (text == "force")
+  {
+    return compute_variable_order_force(patterns, number_of_variables, exclude_first_variable);
+  }
   else
   {
     return parse_variable_order(text, number_of_variables, exclude_first_variable);
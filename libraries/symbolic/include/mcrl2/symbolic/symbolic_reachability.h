@@ -22,6 +22,9 @@
 #include "mcrl2/symbolic/summand_group.h"
 
 #include <sylvan_ldd.hpp>
+#include <iomanip>
+#include <limits>
+#include <memory>
 
 namespace mcrl2::symbolic {
 
@@ -30,6 +33,8 @@ struct symbolic_reachability_options
   data::rewrite_strategy rewrite_strategy = data::jitty;
   std::size_t max_workers = 0;
   std::size_t max_iterations = 0;
+  std::size_t reorder_iterations = 5;
+  std::size_t checkpoint_interval = 0;
   bool cached = false;
   bool chaining = false;
   bool detect_deadlocks = false;
@@ -46,6 +51,7 @@ struct symbolic_reachability_options
   std::string summand_groups;
   std::string variable_order;
   std::string dot_file;
+  std::string checkpoint_file;
 };
 
 inline
@@ -67,7 +73,10 @@ std::ostream& operator<<(std::ostream& out, const symbolic_reachability_options&
   out << "info = " << std::boolalpha << options.info << std::endl;
   out << "groups = " << options.summand_groups << std::endl;
   out << "reorder = " << options.variable_order << std::endl;
+  out << "reorder-iterations = " << options.reorder_iterations << std::endl;
   out << "dot = " << options.dot_file << std::endl;
+  out << "checkpoint = " << options.checkpoint_file << std::endl;
+  out << "checkpoint-interval = " << options.checkpoint_interval << std::endl;
   return out;
 }
 
@@ -107,12 +116,54 @@ void check_enumerator_solution(const EnumeratorElement& p, const summand_group&)
   }
 }
 
+/// \brief Enumerates the transitions of the summands in group that start in the vector x. For each transition
+///        report(i, smd) is called, where smd is the summand and sigma contains the assignments of the transition.
+template <typename Group, typename ReportTransition>
+void enumerate_transitions(const Group& group,
+                           const std::vector<data_expression_index>& data_index,
+                           const data::rewriter& rewr,
+                           data::mutable_indexed_substitution<>& sigma,
+                           const data::enumerator_algorithm<>& enumerator,
+                           const std::uint32_t* x,
+                           ReportTransition report)
+{
+  using enumerator_element = data::enumerator_list_element_with_substitution<>;
+
+  // add the assignments corresponding to x to sigma
+  for (std::size_t j = 0; j < group.read.size(); j++)
+  {
+    sigma[group.read_parameters[j]] = data_index[group.read[j]][x[j]];
+  }
+
+  std::size_t i = 0;
+  for (const auto& smd: group.summands)
+  {
+    data::data_expression condition = rewr(smd.condition, sigma);
+    if (!data::is_false(condition))
+    {
+      enumerator.enumerate(enumerator_element(smd.variables, condition),
+                           sigma,
+                           [&](const enumerator_element& p) {
+                             check_enumerator_solution(p, group);
+                             p.add_assignments(smd.variables, sigma, rewr);
+                             report(i, smd);
+                             return false;
+                           },
+                           data::is_false
+      );
+
+      ++i;
+    }
+    data::remove_assignments(sigma, smd.variables);
+  }
+  data::remove_assignments(sigma, group.read_parameters);
+}
+
 /// \brief If ActionLabel is true then the multi-action will be rewritten and added to the relation.
 template <typename Context, bool ActionLabel>
 void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, void* context)
 {
   using namespace sylvan::ldds;
-  using enumerator_element = data::enumerator_list_element_with_substitution<>;
 
   auto p = reinterpret_cast<Context*>(context);
   auto& algorithm = p->first;
@@ -134,53 +185,35 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
 
   MCRL2_DECLARE_STACK_ARRAY(xy, std::uint32_t, xy_size);
 
-  // add the assignments corresponding to x to sigma
   // add x to the transition xy
   stopwatch learn_start;
   for (std::size_t j = 0; j < x_size; j++)
   {
-    sigma[group.read_parameters[j]] = data_index[group.read[j]][x[j]];
     xy[group.read_pos[j]] = x[j];
   }
 
-  std::size_t i = 0;
-  for (const auto& smd: group.summands)
-  {
-    data::data_expression condition = rewr(smd.condition, sigma);
-    if (!data::is_false(condition))
+  enumerate_transitions(group, data_index, rewr, sigma, enumerator, x,
+    [&](std::size_t i, const summand_group::summand& smd)
     {
-      enumerator.enumerate(enumerator_element(smd.variables, condition),
-                           sigma,
-                           [&](const enumerator_element& p) {
-                             check_enumerator_solution(p, group);
-                             p.add_assignments(smd.variables, sigma, rewr);
-                             for (std::size_t j = 0; j < y_size; j++)
-                             {
-                               data::data_expression value = rewr(smd.next_state[j], sigma);
-                               assert(value != data::undefined_data_expression());
-
-                               // Determine whether this is a copy parameter, insert special value if that is the case.
-                               xy[group.write_pos[j]] = smd.copy[group.write_pos[j]] ? relprod_ignore : data_index[group.write[j]].insert(value).first;
-                             }
-
-                             if constexpr (ActionLabel)
-                             {
-                               // Action is always located on the last index of the cube.
-                               xy[xy_size - 1] = algorithm.action_index().insert(algorithm.rewrite_action(group.actions[i], rewr, sigma)).first;
-                             }
-
-                             mCRL2log(log::debug1) << "  " << print_transition(data_index, xy.data(), group.read, group.write) << std::endl;
-                             group.L = options.no_relprod ? union_cube(group.L, xy.data(), xy_size) : union_cube_copy(group.L, xy.data(), smd.copy.data(), xy_size);
-                             return false;
-                           },
-                           data::is_false
-      );
+      for (std::size_t j = 0; j < y_size; j++)
+      {
+        data::data_expression value = rewr(smd.next_state[j], sigma);
+        assert(value != data::undefined_data_expression());
 
-      ++i;
+        // Determine whether this is a copy parameter, insert special value if that is the case.
+        xy[group.write_pos[j]] = smd.copy[group.write_pos[j]] ? relprod_ignore : data_index[group.write[j]].insert(value).first;
+      }
+
+      if constexpr (ActionLabel)
+      {
+        // Action is always located on the last index of the cube.
+        xy[xy_size - 1] = algorithm.action_index().insert(algorithm.rewrite_action(group.actions[i], rewr, sigma)).first;
+      }
+
+      mCRL2log(log::debug1) << "  " << print_transition(data_index, xy.data(), group.read, group.write) << std::endl;
+      group.L = options.no_relprod ? union_cube(group.L, xy.data(), xy_size) : union_cube_copy(group.L, xy.data(), smd.copy.data(), xy_size);
     }
-    data::remove_assignments(sigma, smd.variables);
-  }
-  data::remove_assignments(sigma, group.read_parameters);
+  );
   group.learn_calls += 1;
   group.learn_time += learn_start.seconds();
 
@@ -190,6 +223,232 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
   }
 }
 
+/// \brief A rewriter, substitution and enumerator that are used by a single Lace worker to learn transitions.
+struct learn_worker
+{
+  data::rewriter rewr;
+  data::mutable_indexed_substitution<> sigma;
+  data::enumerator_identifier_generator id_generator;
+  data::enumerator_algorithm<> enumerator;
+  bool initialised = false;
+
+  // N.B. The rewriter is cloned, since one rewriter cannot be used in parallel.
+  learn_worker(data::rewriter& global_rewr, const data::data_specification& dataspec)
+    : rewr(global_rewr.clone()),
+      id_generator("t_"),
+      enumerator(rewr, dataspec, rewr, id_generator, false)
+  {}
+};
+
+/// \brief The transitions that were learned by a Lace worker for a single vector x. They are added to the
+///        data indices and to the transition relation by the calling thread.
+template <typename Action>
+struct learned_successors
+{
+  std::vector<std::uint32_t> x;
+  std::vector<std::size_t> summands;         // for each transition the index of the summand in the group
+  std::vector<data::data_expression> values; // for each transition the values of the write parameters
+  std::vector<Action> actions;               // for each transition the rewritten action (only if ActionLabel)
+  double learn_time = 0.0;
+};
+
+/// \brief The context of learn_successors_parallel_callback for one summand group.
+template <typename Algorithm, typename Group, typename Action>
+struct parallel_learn_context
+{
+  using action_type = Action;
+
+  Algorithm& algorithm;
+  Group& group;
+  std::vector<std::unique_ptr<learn_worker>>& workers;
+  std::vector<std::vector<learned_successors<Action>>> results; // the learned transitions per Lace worker
+
+  parallel_learn_context(Algorithm& algorithm_, Group& group_, std::vector<std::unique_ptr<learn_worker>>& workers_)
+    : algorithm(algorithm_), group(group_), workers(workers_), results(workers_.size())
+  {}
+};
+
+/// \brief Computes the successors of x on the Lace worker that executes the callback. The data indices and the
+///        transition relation are only read, the results are stored in the context.
+template <typename Context, bool ActionLabel>
+void learn_successors_parallel_callback(WorkerP* w, Task*, std::uint32_t* x, std::size_t, void* context)
+{
+  auto p = reinterpret_cast<Context*>(context);
+  auto& algorithm = p->algorithm;
+  auto& group = p->group;
+  learn_worker& worker = *p->workers[w->worker];
+  const auto& data_index = algorithm.data_index();
+  std::size_t y_size = group.write.size();
+
+  if (!worker.initialised)
+  {
+    worker.rewr.thread_initialise();
+    worker.initialised = true;
+  }
+
+  stopwatch learn_start;
+  learned_successors<typename Context::action_type> result;
+  result.x.assign(x, x + group.read.size());
+  enumerate_transitions(group, data_index, worker.rewr, worker.sigma, worker.enumerator, x,
+    [&](std::size_t i, const summand_group::summand& smd)
+    {
+      result.summands.push_back(&smd - group.summands.data());
+      for (std::size_t j = 0; j < y_size; j++)
+      {
+        result.values.push_back(worker.rewr(smd.next_state[j], worker.sigma));
+        assert(result.values.back() != data::undefined_data_expression());
+      }
+
+      if constexpr (ActionLabel)
+      {
+        result.actions.push_back(algorithm.rewrite_action(group.actions[i], worker.rewr, worker.sigma));
+      }
+    }
+  );
+  result.learn_time = learn_start.seconds();
+  p->results[w->worker].push_back(std::move(result));
+}
+
+/// \brief Adds the transitions that were learned by learn_successors_parallel_callback to the data indices and
+///        to the transition relation of the summand group.
+template <typename Context, bool ActionLabel>
+void add_learned_successors(Context& context)
+{
+  using namespace sylvan::ldds;
+
+  auto& algorithm = context.algorithm;
+  auto& group = context.group;
+  auto& data_index = algorithm.data_index();
+  const auto& options = algorithm.m_options;
+  std::size_t x_size = group.read.size();
+  std::size_t y_size = group.write.size();
+  std::size_t xy_size = x_size + y_size;
+
+  if constexpr (ActionLabel)
+  {
+    // One additional space for the action label.
+    xy_size += 1;
+  }
+
+  MCRL2_DECLARE_STACK_ARRAY(xy, std::uint32_t, xy_size);
+
+  for (const auto& results: context.results)
+  {
+    for (const auto& result: results)
+    {
+      for (std::size_t j = 0; j < x_size; j++)
+      {
+        xy[group.read_pos[j]] = result.x[j];
+      }
+
+      for (std::size_t k = 0; k < result.summands.size(); k++)
+      {
+        const auto& smd = group.summands[result.summands[k]];
+        for (std::size_t j = 0; j < y_size; j++)
+        {
+          // Determine whether this is a copy parameter, insert special value if that is the case.
+          xy[group.write_pos[j]] = smd.copy[group.write_pos[j]] ? relprod_ignore : data_index[group.write[j]].insert(result.values[k * y_size + j]).first;
+        }
+
+        if constexpr (ActionLabel)
+        {
+          // Action is always located on the last index of the cube.
+          xy[xy_size - 1] = algorithm.action_index().insert(result.actions[k]).first;
+        }
+
+        mCRL2log(log::debug1) << "  " << print_transition(data_index, xy.data(), group.read, group.write) << std::endl;
+        group.L = options.no_relprod ? union_cube(group.L, xy.data(), xy_size) : union_cube_copy(group.L, xy.data(), smd.copy.data(), xy_size);
+      }
+
+      group.learn_calls += 1;
+      group.learn_time += result.learn_time;
+
+      if (options.cached)
+      {
+        group.Ldomain = union_cube(group.Ldomain, result.x.data(), x_size);
+      }
+    }
+  }
+}
+
+/// \brief Returns true if transitions are learned by all Lace workers in parallel.
+inline
+bool parallel_learning_enabled()
+{
+  return atermpp::detail::GlobalThreadSafe && lace_workers() > 1;
+}
+
+/// \brief Updates groups[i].L := groups[i].L U {(x,y) in R | x in X[i]} for all i. The vectors of all sets X[i] are
+///        enumerated by parallel Lace tasks, and each Lace worker uses its own rewriter and enumerator.
+template <typename Action, bool ActionLabel, typename Algorithm, typename Group>
+void learn_successors_parallel(Algorithm& algorithm,
+                               const std::vector<Group*>& groups,
+                               const std::vector<sylvan::ldds::ldd>& X,
+                               std::vector<std::unique_ptr<learn_worker>>& workers,
+                               data::rewriter& rewr,
+                               const data::data_specification& dataspec)
+{
+  using context_type = parallel_learn_context<Algorithm, Group, Action>;
+
+  while (workers.size() < lace_workers())
+  {
+    workers.push_back(std::make_unique<learn_worker>(rewr, dataspec));
+  }
+
+  std::vector<context_type> contexts;
+  std::vector<void*> context_pointers;
+  contexts.reserve(groups.size());
+  for (Group* group: groups)
+  {
+    contexts.emplace_back(algorithm, *group, workers);
+    context_pointers.push_back(&contexts.back());
+  }
+
+  sylvan::ldds::sat_all(X, learn_successors_parallel_callback<context_type, ActionLabel>, context_pointers);
+
+  for (context_type& context: contexts)
+  {
+    add_learned_successors<context_type, ActionLabel>(context);
+  }
+}
+
+/// \brief Selects the variable order with the smallest LDDs by exploring the first options.reorder_iterations
+///        breadth-first iterations of spec for each of the candidate orders.
+/// \returns The candidate for which the number of nodes of the visited states and the learned transition relations
+///          is minimal.
+template <typename Algorithm, typename Specification, typename Options>
+std::string select_variable_order(const Specification& spec, const Options& options, const std::vector<std::string>& candidates = { "none", "cuthill-mckee", "sloan", "force" })
+{
+  std::string result;
+  std::size_t result_size = std::numeric_limits<std::size_t>::max();
+
+  for (const std::string& candidate: candidates)
+  {
+    Options candidate_options = options;
+    candidate_options.variable_order = candidate;
+    candidate_options.max_iterations = options.reorder_iterations;
+
+    stopwatch timer;
+    Algorithm algorithm(spec, candidate_options);
+    std::size_t size = sylvan::ldds::nodecount(algorithm.run(false));
+    for (const auto& group: algorithm.summand_groups())
+    {
+      size += sylvan::ldds::nodecount(group.L);
+    }
+    mCRL2log(log::verbose) << "variable order " << candidate << " uses " << size << " LDD nodes after " << options.reorder_iterations
+                           << " iterations (time = " << std::setprecision(2) << std::fixed << timer.seconds() << "s)" << std::endl;
+
+    if (size < result_size)
+    {
+      result = candidate;
+      result_size = size;
+    }
+  }
+
+  mCRL2log(log::verbose) << "selected variable order " << result << std::endl;
+  return result;
+}
+
 } // namespace mcrl2::symbolic
 
 #endif // MCRL2_ENABLE_SYLVAN
@@ -0,0 +1,190 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/platform.h"
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/symbolic/exploration_checkpoint.h"
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/data/detail/io.h"
+#include "mcrl2/symbolic/ldd_stream.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace mcrl2::symbolic
+{
+
+static atermpp::aterm exploration_checkpoint_mark()
+{
+  return atermpp::aterm_appl(atermpp::function_symbol("symbolic_exploration_checkpoint", 0));
+}
+
+// The version of the format, which must be increased whenever the format changes.
+static constexpr std::size_t exploration_checkpoint_version = 1;
+
+static void write_indices(utilities::obitstream& bitstream, const std::vector<std::size_t>& indices)
+{
+  bitstream.write_integer(indices.size());
+  for (std::size_t i: indices)
+  {
+    bitstream.write_integer(i);
+  }
+}
+
+static std::vector<std::size_t> read_indices(utilities::ibitstream& bitstream)
+{
+  std::vector<std::size_t> result(bitstream.read_integer());
+  for (std::size_t& i: result)
+  {
+    i = bitstream.read_integer();
+  }
+  return result;
+}
+
+void save_exploration_checkpoint(std::ostream& stream, const exploration_checkpoint& checkpoint)
+{
+  std::shared_ptr<utilities::obitstream> bitstream = std::make_shared<utilities::obitstream>(stream);
+
+  atermpp::binary_aterm_ostream aterm_stream(bitstream);
+  binary_ldd_ostream ldd_stream(bitstream);
+
+  aterm_stream << data::detail::remove_index_impl;
+
+  aterm_stream << exploration_checkpoint_mark();
+  bitstream->write_integer(exploration_checkpoint_version);
+  bitstream->write_integer(checkpoint.iteration_count);
+  aterm_stream << checkpoint.process_parameters;
+
+  // Write the mapping from indices to terms.
+  for (const data_expression_index& index: checkpoint.data_index)
+  {
+    bitstream->write_integer(index.size());
+    for (const data::data_expression& value: index)
+    {
+      aterm_stream << value;
+    }
+  }
+
+  bitstream->write_integer(checkpoint.action_labels.size());
+  for (const atermpp::aterm& label: checkpoint.action_labels)
+  {
+    aterm_stream << label;
+  }
+
+  ldd_stream << checkpoint.initial_state;
+  ldd_stream << checkpoint.visited;
+  ldd_stream << checkpoint.todo;
+  ldd_stream << checkpoint.deadlocks;
+
+  bitstream->write_integer(checkpoint.summand_groups.size());
+  for (const summand_group_checkpoint& group: checkpoint.summand_groups)
+  {
+    write_indices(*bitstream, group.read);
+    write_indices(*bitstream, group.write);
+    ldd_stream << group.L;
+    ldd_stream << group.Ldomain;
+  }
+}
+
+void save_exploration_checkpoint(const std::string& filename, const exploration_checkpoint& checkpoint)
+{
+  // The checkpoint is first written to a temporary file, such that an interruption while writing does not destroy
+  // a previous checkpoint.
+  std::string temporary_filename = filename + ".tmp";
+  {
+    std::ofstream to(temporary_filename, std::ofstream::out | std::ofstream::binary);
+    if (!to.good())
+    {
+      throw mcrl2::runtime_error("Could not write to filename " + temporary_filename);
+    }
+    save_exploration_checkpoint(to, checkpoint);
+  }
+  std::remove(filename.c_str());
+  if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+  {
+    throw mcrl2::runtime_error("Could not rename " + temporary_filename + " to " + filename);
+  }
+}
+
+void load_exploration_checkpoint(std::istream& stream, exploration_checkpoint& checkpoint)
+{
+  std::shared_ptr<utilities::ibitstream> bitstream = std::make_shared<utilities::ibitstream>(stream);
+
+  atermpp::binary_aterm_istream aterm_stream(bitstream);
+  binary_ldd_istream ldd_stream(bitstream);
+
+  aterm_stream >> data::detail::add_index_impl;
+
+  atermpp::aterm marker;
+  aterm_stream >> marker;
+  if (marker != exploration_checkpoint_mark())
+  {
+    throw mcrl2::runtime_error("Stream does not contain a symbolic exploration checkpoint.");
+  }
+
+  std::size_t version = bitstream->read_integer();
+  if (version != exploration_checkpoint_version)
+  {
+    throw mcrl2::runtime_error("The symbolic exploration checkpoint has version " + std::to_string(version) + ", but version "
+                               + std::to_string(exploration_checkpoint_version) + " was expected.");
+  }
+
+  checkpoint.iteration_count = bitstream->read_integer();
+  aterm_stream >> checkpoint.process_parameters;
+
+  checkpoint.data_index.clear();
+  for (const data::variable& parameter: checkpoint.process_parameters)
+  {
+    checkpoint.data_index.emplace_back(parameter.sort());
+
+    std::size_t number_of_entries = bitstream->read_integer();
+    for (std::size_t i = 0; i < number_of_entries; ++i)
+    {
+      data::data_expression value;
+      aterm_stream >> value;
+      checkpoint.data_index.back().insert(value);
+    }
+  }
+
+  checkpoint.action_labels.resize(bitstream->read_integer());
+  for (atermpp::aterm& label: checkpoint.action_labels)
+  {
+    aterm_stream >> label;
+  }
+
+  ldd_stream >> checkpoint.initial_state;
+  ldd_stream >> checkpoint.visited;
+  ldd_stream >> checkpoint.todo;
+  ldd_stream >> checkpoint.deadlocks;
+
+  checkpoint.summand_groups.resize(bitstream->read_integer());
+  for (summand_group_checkpoint& group: checkpoint.summand_groups)
+  {
+    group.read = read_indices(*bitstream);
+    group.write = read_indices(*bitstream);
+    ldd_stream >> group.L;
+    ldd_stream >> group.Ldomain;
+  }
+}
+
+void load_exploration_checkpoint(const std::string& filename, exploration_checkpoint& checkpoint)
+{
+  std::ifstream from(filename, std::ifstream::in | std::ifstream::binary);
+  if (!from.good())
+  {
+    throw mcrl2::runtime_error("Could not read from filename " + filename);
+  }
+  load_exploration_checkpoint(from, checkpoint);
+}
+
+} // namespace mcrl2::symbolic
+
+#endif // MCRL2_ENABLE_SYLVAN
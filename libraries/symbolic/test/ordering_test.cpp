@@ -0,0 +1,88 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file ordering_test.cpp
+/// \brief Tests for the variable ordering heuristics.
+
+#define BOOST_TEST_MODULE ordering_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/symbolic/ordering.h"
+
+using namespace mcrl2::symbolic;
+
+// Creates read/write patterns from strings in which 'r', 'w', '+' and '-' denote read, write, read and write, and unused.
+static
+std::vector<boost::dynamic_bitset<>> make_patterns(const std::vector<std::string>& text)
+{
+  std::vector<boost::dynamic_bitset<>> result;
+  for (const std::string& s: text)
+  {
+    boost::dynamic_bitset<> pattern(2 * s.size());
+    for (std::size_t i = 0; i < s.size(); i++)
+    {
+      pattern[2*i] = s[i] == 'r' || s[i] == '+';
+      pattern[2*i+1] = s[i] == 'w' || s[i] == '+';
+    }
+    result.push_back(pattern);
+  }
+  return result;
+}
+
+static
+bool is_permutation(const std::vector<std::size_t>& order, std::size_t n)
+{
+  std::vector<std::size_t> expected = compute_variable_order_default(n);
+  std::vector<std::size_t> sorted = order;
+  std::sort(sorted.begin(), sorted.end());
+  return sorted == expected;
+}
+
+BOOST_AUTO_TEST_CASE(test_heuristics_are_permutations)
+{
+  std::vector<boost::dynamic_bitset<>> patterns = make_patterns({
+    "r---w-",
+    "-+--r-",
+    "---r-w",
+    "+-----",
+    "--w--r"
+  });
+
+  for (const std::string& text: { "none", "random", "cuthill-mckee", "sloan", "force" })
+  {
+    std::vector<std::size_t> order = compute_variable_order(text, 6, patterns);
+    BOOST_CHECK(is_permutation(order, 6));
+
+    order = compute_variable_order(text, 6, patterns, true);
+    BOOST_CHECK(is_permutation(order, 6));
+    BOOST_CHECK_EQUAL(order.front(), 0u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_heuristics_reduce_span)
+{
+  // The summands connect the variables in the chain 0 - 3 - 1 - 4 - 2 - 5.
+  std::vector<boost::dynamic_bitset<>> patterns = make_patterns({
+    "r--w--",
+    "-w-r--",
+    "-r--w-",
+    "--w-r-",
+    "--r--w"
+  });
+
+  std::size_t span = variable_order_span(patterns, compute_variable_order_default(6));
+  BOOST_CHECK_EQUAL(span, 13u);
+
+  // A chain can be ordered such that every summand uses two adjacent variables.
+  for (const std::string& text: { "cuthill-mckee", "sloan", "force" })
+  {
+    std::vector<std::size_t> order = compute_variable_order(text, 6, patterns);
+    BOOST_CHECK(variable_order_span(patterns, order) <= span);
+  }
+  BOOST_CHECK_EQUAL(variable_order_span(patterns, compute_variable_order_cuthill_mckee(patterns, 6)), 5u);
+  BOOST_CHECK_EQUAL(variable_order_span(patterns, compute_variable_order_sloan(patterns, 6)), 5u);
+}
@@ -0,0 +1,105 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/concurrent_indexed_set.h"
+#include "mcrl2/utilities/indexed_set.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace mcrl2::utilities;
+
+/// \brief Runs f(thread_index) on the given number of threads and prints the elapsed time.
+template<typename F>
+void benchmark_threads(const std::string& name, std::size_t number_of_threads, F f)
+{
+  stopwatch timer;
+
+  std::vector<std::thread> threads;
+  for (std::size_t id = 1; id < number_of_threads; ++id)
+  {
+    threads.emplace_back(f, id);
+  }
+  f(0);
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::cerr << name << " time: " << timer.seconds() << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t number_of_threads = 1;
+  std::size_t number_of_keys = 4000000;
+
+  // Accept arguments for the number of threads and the number of keys per thread.
+  if (argc > 1)
+  {
+    number_of_threads = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+  if (argc > 2)
+  {
+    number_of_keys = static_cast<std::size_t>(std::stoul(argv[2]));
+  }
+
+  // Every thread inserts its own keys and the keys of its neighbour, so half of the insertions find an existing key
+  // similar to the exploration of a state space.
+  auto key = [&](std::size_t thread, std::size_t i)
+  {
+    return ((thread + i % 2) % number_of_threads) * number_of_keys + i;
+  };
+
+  {
+    indexed_set<std::size_t, true> set(number_of_threads);
+    benchmark_threads("indexed_set", number_of_threads, [&](std::size_t id)
+      {
+        // With multiple threads the indexed_set numbers its threads from one.
+        const std::size_t thread_index = number_of_threads > 1 ? id + 1 : 0;
+        for (std::size_t i = 0; i < number_of_keys; ++i)
+        {
+          set.insert(key(id, i), thread_index);
+        }
+      });
+  }
+
+  {
+    concurrent_indexed_set<std::size_t> set(number_of_threads);
+    benchmark_threads("concurrent_indexed_set", number_of_threads, [&](std::size_t id)
+      {
+        for (std::size_t i = 0; i < number_of_keys; ++i)
+        {
+          set.insert(key(id, i), id);
+        }
+      });
+  }
+
+  {
+    std::vector<std::size_t> keys;
+    keys.reserve(number_of_threads * number_of_keys);
+    for (std::size_t id = 0; id < number_of_threads; ++id)
+    {
+      for (std::size_t i = 0; i < number_of_keys; ++i)
+      {
+        keys.push_back(key(id, i));
+      }
+    }
+
+    concurrent_indexed_set<std::size_t> set(number_of_threads);
+    benchmark_threads("concurrent_indexed_set::insert_batch", 1, [&](std::size_t)
+      {
+        set.insert_batch(keys, number_of_threads);
+      });
+  }
+
+  return 0;
+}
@@ -12,6 +12,8 @@
 
 #include <vector>
 #include <bitset>
+#include <cstdint>
+#include <iostream>
 
 namespace mcrl2
 {
@@ -25,13 +27,28 @@ constexpr std::size_t integer_encoding_size()
   return ((sizeof(T) + 1) * 8) / 7;
 }
 
+/// \brief Enables the compression of the bitstreams that are constructed afterwards without explicit settings.
+/// \param number_of_threads The number of threads that compress blocks simultaneously.
+void set_bitstream_compression(bool enable, std::size_t number_of_threads = 1);
+
+/// \returns True iff bitstreams are compressed by default, see set_bitstream_compression.
+bool bitstream_compression();
+
 /// \brief A bitstream provides per bit writing of data to any stream (including stdout).
-/// \details Internally uses bitpacking and buffering for compact and efficient IO.
+/// \details Internally uses bitpacking and buffering for compact and efficient IO. When compression is enabled the
+///          stream starts with a magic value, followed by frames that each contain a block of at most 1 MiB
+///          compressed by compress_block. An ibitstream recognises such a stream automatically.
 class obitstream
 {
 public:
-  /// \brief Provides the stream on which the write function operate.
+  /// \brief Provides the stream on which the write function operate, compressed as set by set_bitstream_compression.
   obitstream(std::ostream& stream);
+
+  /// \brief Provides the stream on which the write function operate.
+  /// \param compress Compresses the written data in blocks.
+  /// \param number_of_threads The number of threads that compress blocks simultaneously.
+  obitstream(std::ostream& stream, bool compress, std::size_t number_of_threads = 1);
+
   ~obitstream() { flush(); }
 
   /// \brief Write the num_of_bits least significant bits in descending order from value.
@@ -47,16 +64,29 @@ public:
   /// \details Uses most significant bit encoding.
   void write_integer(std::size_t value);
 
+  /// \brief Writes size bytes from the given buffer.
+  void write(const std::uint8_t* buffer, std::size_t size);
+
 private:
   /// \brief Flush the remaining bits in the buffer to the output stream.
   /// \details Note that this aligns it to the next byte, e.g. when bits_in_buffer is 6 then two zero bits are added redundantly.
   void flush();
 
-  /// \brief Writes size bytes from the given buffer.
-  void write(const std::uint8_t* buffer, std::size_t size);
+  /// \brief Writes a single byte to the stream, or to the current block when compressed.
+  void put(std::uint8_t byte);
+
+  /// \brief Compresses the pending blocks in parallel and writes them to the stream in order.
+  void write_blocks();
 
   std::ostream& stream;
 
+  bool m_compress = false; ///< Whether the output is compressed in blocks.
+  std::size_t m_number_of_threads = 1; ///< The number of blocks that are compressed simultaneously.
+
+  std::vector<std::uint8_t> m_block; ///< The block that is being filled.
+  std::vector<std::vector<std::uint8_t>> m_pending_blocks; ///< Full blocks that have not yet been written.
+  std::vector<std::vector<std::uint8_t>> m_compressed_blocks; ///< Reserved space for the compressed blocks.
+
   /// \brief Buffer that is filled starting from bit 127 when writing
   std::bitset<128> write_buffer = 0;
 
@@ -84,12 +114,24 @@ public:
   /// \returns A natural number that was read from the binary stream encoded in most significant bit encoding.
   std::size_t read_integer();
 
-private:
   /// \brief Read size bytes into the provided buffer.
   void read(std::size_t size, std::uint8_t* buffer);
 
+private:
+  /// \returns The next byte from the current block, or from the stream when it is exhausted.
+  std::uint8_t get();
+
+  /// \brief Reads and decompresses the next frame of a compressed stream into the current block.
+  void read_block();
+
   std::istream& stream;
 
+  bool m_compressed = false; ///< Whether the input was compressed by an obitstream.
+
+  std::vector<std::uint8_t> m_block; ///< The current block, or the bytes read while checking for compression.
+  std::size_t m_block_position = 0; ///< The next byte of the current block.
+  std::vector<std::uint8_t> m_compressed_block; ///< Space to read a compressed block.
+
   /// \brief Buffer that is filled starting from bit 127 when reading.
   std::bitset<128> read_buffer = 0;
 
@@ -25,11 +25,12 @@ namespace utilities
 /// \details Also provides several non-standard allocate functions specifically for the term pool.
 template <class T,
           std::size_t ElementsPerBlock = 1024,
-          bool ThreadSafe = false>
-class block_allocator : public memory_pool<T, ElementsPerBlock, ThreadSafe>
+          bool ThreadSafe = false,
+          memory_subsystem Subsystem = memory_subsystem::blocks>
+class block_allocator : public memory_pool<T, ElementsPerBlock, ThreadSafe, Subsystem>
 {
 private:
-  using super = memory_pool<T, ElementsPerBlock, ThreadSafe>;
+  using super = memory_pool<T, ElementsPerBlock, ThreadSafe, Subsystem>;
 
 public:
   using value_type = T;
@@ -39,7 +40,7 @@ public:
   template <class U>
   struct rebind
   {
-      typedef block_allocator<U, ElementsPerBlock, ThreadSafe> other;
+      typedef block_allocator<U, ElementsPerBlock, ThreadSafe, Subsystem> other;
   };
 
   block_allocator() = default;
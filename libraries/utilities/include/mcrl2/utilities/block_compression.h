@@ -0,0 +1,37 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/block_compression.h
+/// \brief A fast LZ77 codec for compressing blocks of bytes, as used by the compressed bitstreams.
+
+#ifndef MCRL2_UTILITIES_BLOCK_COMPRESSION_H
+#define MCRL2_UTILITIES_BLOCK_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief Compresses size bytes of input and replaces the content of output by the result.
+/// \details The compressed block is a sequence of tokens similar to LZ4. Every token consists of a number of literal bytes
+///          that are copied as is, followed by a match that repeats earlier output at a distance of at most 65535 bytes.
+///          Lengths that do not fit in the four bits of a token are extended with bytes that are summed up to the first
+///          byte that is not 255.
+void compress_block(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output);
+
+/// \brief Decompresses a block produced by compress_block that contains exactly output_size bytes.
+/// \throws mcrl2::runtime_error when the block is corrupt.
+void decompress_block(const std::uint8_t* input, std::size_t size, std::uint8_t* output, std::size_t output_size);
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_BLOCK_COMPRESSION_H
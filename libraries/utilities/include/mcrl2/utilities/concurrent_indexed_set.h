@@ -0,0 +1,203 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/concurrent_indexed_set.h
+/// \brief An indexed set into which multiple threads can insert without locks.
+
+#ifndef MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
+#define MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
+
+#include "mcrl2/utilities/noncopyable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mcrl2::utilities
+{
+
+namespace detail
+{
+
+/// \brief Indicates that a thread is accessing the hash table of a concurrent_indexed_set.
+/// \details Aligned to a cache line such that threads do not share the cache line of their flag.
+struct alignas(64) concurrent_busy_flag
+{
+  std::atomic<bool> busy{false};
+};
+
+} // namespace detail
+
+/// \brief A set that assigns consecutive indices, starting at zero, to its keys in the order in which they are inserted.
+/// \details Keys are stored in segments that double in size, such that keys never move and references to them remain
+///          valid. Threads claim a slot of the hash table with a compare-and-swap and obtain the index of a new key
+///          with a fetch-and-add, so insertions do not take locks and the indices have no holes. Only when the hash
+///          table doubles in size the other threads wait until the resize is finished. For this purpose every thread
+///          passes its own thread index, between zero and the number of threads given to the constructor.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key>,
+         typename Allocator = std::allocator<Key>>
+class concurrent_indexed_set : private noncopyable
+{
+public:
+  typedef Key key_type;
+  typedef std::size_t size_type;
+  typedef Hash hasher;
+  typedef Equals key_equal;
+
+  /// \brief Value returned when an element does not exist in the set.
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  /// \brief Iterates over the keys in the order of their indices.
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    const_iterator(const concurrent_indexed_set& set, size_type index)
+      : m_set(&set),
+        m_index(index)
+    {}
+
+    reference operator*() const { return (*m_set)[m_index]; }
+    pointer operator->() const { return &(*m_set)[m_index]; }
+
+    const_iterator& operator++() { ++m_index; return *this; }
+    const_iterator operator++(int) { const_iterator result = *this; ++m_index; return result; }
+
+    bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+    bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+  private:
+    const concurrent_indexed_set* m_set;
+    size_type m_index;
+  };
+
+  /// \brief Constructs an empty set for the given number of threads, numbered from zero, with a hash table that can
+  ///        store initial_capacity keys before it is resized.
+  explicit concurrent_indexed_set(std::size_t number_of_threads = 1,
+    std::size_t initial_capacity = 1024,
+    const hasher& hash = hasher(),
+    const key_equal& equals = key_equal());
+
+  ~concurrent_indexed_set();
+
+  /// \brief Inserts the key when it is not yet in the set.
+  /// \returns The index of the key and whether it was inserted.
+  /// \threadsafe
+  std::pair<size_type, bool> insert(const key_type& key, std::size_t thread_index = 0);
+
+  /// \brief Inserts all keys, using threads zero up to number_of_threads.
+  /// \details The threads that are used must not access this set at the same time.
+  /// \returns For every key its index in the set.
+  std::vector<size_type> insert_batch(const std::vector<key_type>& keys, std::size_t number_of_threads = 1);
+
+  /// \returns The index of the key, or npos when it is not in the set.
+  /// \threadsafe
+  size_type index(const key_type& key, std::size_t thread_index = 0) const;
+
+  /// \brief Resizes the hash table such that it can store the given number of keys without being resized again.
+  void reserve(size_type number_of_keys, std::size_t thread_index = 0);
+
+  /// \returns The key with the given index, which must be smaller than size().
+  /// \threadsafe
+  const key_type& operator[](size_type index) const;
+
+  /// \returns The key with the given index, throws std::out_of_range when it is not smaller than size().
+  const key_type& at(size_type index) const;
+
+  /// \returns The number of keys. During concurrent insertions the keys with the last indices can still be under
+  ///          construction, a key can be accessed safely once its index has been returned by insert or index.
+  /// \threadsafe
+  size_type size() const { return m_size.load(std::memory_order_acquire); }
+
+  bool empty() const { return size() == 0; }
+
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, size()); }
+
+  /// \brief Removes all keys, this function is not thread safe.
+  void clear();
+
+private:
+  /// \brief Every slot of the hash table stores the index of a key in its lower bits and part of the hash of that key
+  ///        in its upper bits, such that most keys that differ are not compared.
+  static constexpr unsigned int tag_shift = 48;
+  static constexpr std::uint64_t index_mask = (std::uint64_t(1) << tag_shift) - 1;
+  static constexpr std::uint64_t empty_slot = std::numeric_limits<std::uint64_t>::max();
+  static constexpr std::uint64_t reserved_slot = empty_slot - 1; ///< A key is being stored for this slot.
+
+  /// \brief The hash table is resized when it is filled for more than this fraction.
+  static constexpr float max_load_factor = 0.6f;
+
+  /// \brief The first segment stores 2^first_segment_bits keys and every following segment twice as many as all
+  ///        previous segments together.
+  static constexpr std::size_t first_segment_bits = 10;
+  static constexpr std::size_t number_of_segments = 64 - first_segment_bits;
+
+  /// \returns The segment that stores the given index, and the position of the index in it.
+  static std::size_t segment_of(size_type index, std::size_t& offset);
+
+  /// \returns The number of keys in the given segment.
+  static std::size_t segment_size(std::size_t segment);
+
+  /// \returns Storage for the key with the given index, the segment is allocated when necessary.
+  Key* key_storage(size_type index);
+
+  /// \returns The upper bits of a slot for the given hash.
+  static std::uint64_t tag(std::size_t hash) { return (static_cast<std::uint64_t>(hash) >> tag_shift) << tag_shift; }
+
+  /// \returns The first slot in which the key with the given hash is sought.
+  std::size_t first_position(std::size_t hash) const
+  {
+    return (hash * 0x9E3779B97F4A7C15ull) >> (64 - m_capacity_bits);
+  }
+
+  /// \brief Announces that the thread accesses the hash table, which waits while the table is resized.
+  void enter(std::size_t thread_index) const;
+  void leave(std::size_t thread_index) const;
+
+  /// \brief Doubles the hash table until it can store the given number of keys, unless another thread already did.
+  void resize(size_type number_of_keys, std::size_t thread_index);
+
+  /// \returns True iff the hash table must be resized before inserting a key.
+  bool must_resize(size_type number_of_keys) const
+  {
+    return static_cast<float>(number_of_keys + m_busy_flags.size()) >= max_load_factor * static_cast<float>(m_capacity);
+  }
+
+  std::unique_ptr<std::atomic<std::uint64_t>[]> m_table;
+  std::size_t m_capacity; ///< The number of slots of m_table, which is a power of two.
+  unsigned int m_capacity_bits; ///< The logarithm of m_capacity.
+
+  std::unique_ptr<std::atomic<Key*>[]> m_segments;
+  std::atomic<size_type> m_size{0};
+
+  mutable std::vector<detail::concurrent_busy_flag> m_busy_flags;
+  mutable std::mutex m_resize_mutex;
+  std::atomic<bool> m_resizing{false};
+
+  hasher m_hasher;
+  key_equal m_equals;
+  Allocator m_allocator;
+};
+
+} // namespace mcrl2::utilities
+
+#include "mcrl2/utilities/detail/concurrent_indexed_set_implementation.h"
+
+#endif // MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
@@ -0,0 +1,350 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/concurrent_indexed_set_implementation.h
+/// \brief Implementation of the concurrent_indexed_set.
+
+#ifndef MCRL2_UTILITIES_DETAIL_CONCURRENT_INDEXED_SET_IMPLEMENTATION_H
+#define MCRL2_UTILITIES_DETAIL_CONCURRENT_INDEXED_SET_IMPLEMENTATION_H
+#pragma once
+
+#include "mcrl2/utilities/concurrent_indexed_set.h"
+#include "mcrl2/utilities/parallel_for.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <thread>
+
+#define MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES template<typename Key, typename Hash, typename Equals, typename Allocator>
+#define MCRL2_CONCURRENT_INDEXED_SET_CLASS concurrent_indexed_set<Key, Hash, Equals, Allocator>
+
+namespace mcrl2::utilities
+{
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+MCRL2_CONCURRENT_INDEXED_SET_CLASS::concurrent_indexed_set(std::size_t number_of_threads,
+  std::size_t initial_capacity,
+  const hasher& hash,
+  const key_equal& equals)
+  : m_segments(new std::atomic<Key*>[number_of_segments]),
+    m_busy_flags(std::max<std::size_t>(number_of_threads, 1)),
+    m_hasher(hash),
+    m_equals(equals)
+{
+  for (std::size_t i = 0; i < number_of_segments; ++i)
+  {
+    m_segments[i].store(nullptr, std::memory_order_relaxed);
+  }
+
+  m_capacity_bits = 4;
+  m_capacity = std::size_t(1) << m_capacity_bits;
+  while (must_resize(initial_capacity))
+  {
+    ++m_capacity_bits;
+    m_capacity *= 2;
+  }
+
+  m_table.reset(new std::atomic<std::uint64_t>[m_capacity]);
+  for (std::size_t i = 0; i < m_capacity; ++i)
+  {
+    m_table[i].store(empty_slot, std::memory_order_relaxed);
+  }
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+MCRL2_CONCURRENT_INDEXED_SET_CLASS::~concurrent_indexed_set()
+{
+  clear();
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+inline std::size_t MCRL2_CONCURRENT_INDEXED_SET_CLASS::segment_of(size_type index, std::size_t& offset)
+{
+  // The segments together store the indices shifted by the size of the first segment, such that the segment follows
+  // from the most significant bit.
+  const std::uint64_t shifted = static_cast<std::uint64_t>(index) + (std::uint64_t(1) << first_segment_bits);
+  const std::size_t msb = 63 - static_cast<std::size_t>(__builtin_clzll(shifted));
+  offset = static_cast<std::size_t>(shifted - (std::uint64_t(1) << msb));
+  return msb - first_segment_bits;
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+inline std::size_t MCRL2_CONCURRENT_INDEXED_SET_CLASS::segment_size(std::size_t segment)
+{
+  return std::size_t(1) << (segment + first_segment_bits);
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+inline Key* MCRL2_CONCURRENT_INDEXED_SET_CLASS::key_storage(size_type index)
+{
+  std::size_t offset;
+  const std::size_t segment = segment_of(index, offset);
+
+  Key* keys = m_segments[segment].load(std::memory_order_acquire);
+  if (keys == nullptr)
+  {
+    // Multiple threads can allocate the segment at the same time, only one of them is kept.
+    Key* allocated = std::allocator_traits<Allocator>::allocate(m_allocator, segment_size(segment));
+    if (m_segments[segment].compare_exchange_strong(keys, allocated, std::memory_order_acq_rel))
+    {
+      keys = allocated;
+    }
+    else
+    {
+      std::allocator_traits<Allocator>::deallocate(m_allocator, allocated, segment_size(segment));
+    }
+  }
+
+  return keys + offset;
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+inline void MCRL2_CONCURRENT_INDEXED_SET_CLASS::enter(std::size_t thread_index) const
+{
+  assert(thread_index < m_busy_flags.size());
+  std::atomic<bool>& busy = m_busy_flags[thread_index].busy;
+
+  // Sequentially consistent, such that either this thread observes the resize or the resizing thread observes this flag.
+  busy.store(true);
+  while (m_resizing.load())
+  {
+    busy.store(false);
+    {
+      // Wait until the resize has finished.
+      std::lock_guard<std::mutex> guard(m_resize_mutex);
+    }
+    busy.store(true);
+  }
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+inline void MCRL2_CONCURRENT_INDEXED_SET_CLASS::leave(std::size_t thread_index) const
+{
+  m_busy_flags[thread_index].busy.store(false, std::memory_order_release);
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+void MCRL2_CONCURRENT_INDEXED_SET_CLASS::resize(size_type number_of_keys, std::size_t thread_index)
+{
+  std::lock_guard<std::mutex> guard(m_resize_mutex);
+  if (!must_resize(number_of_keys))
+  {
+    // Another thread has already resized the hash table.
+    return;
+  }
+
+  m_resizing.store(true);
+  for (std::size_t i = 0; i < m_busy_flags.size(); ++i)
+  {
+    if (i != thread_index)
+    {
+      while (m_busy_flags[i].busy.load())
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // All threads have left, so every key with an index below the size has been constructed.
+  while (must_resize(number_of_keys))
+  {
+    ++m_capacity_bits;
+    m_capacity *= 2;
+  }
+
+  m_table.reset(new std::atomic<std::uint64_t>[m_capacity]);
+  for (std::size_t i = 0; i < m_capacity; ++i)
+  {
+    m_table[i].store(empty_slot, std::memory_order_relaxed);
+  }
+
+  const std::size_t mask = m_capacity - 1;
+  const size_type size = m_size.load(std::memory_order_relaxed);
+  for (size_type index = 0; index < size; ++index)
+  {
+    const std::size_t hash = m_hasher((*this)[index]);
+    std::size_t position = first_position(hash);
+    while (m_table[position].load(std::memory_order_relaxed) != empty_slot)
+    {
+      position = (position + 1) & mask;
+    }
+    m_table[position].store(tag(hash) | index, std::memory_order_relaxed);
+  }
+
+  m_resizing.store(false);
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+std::pair<typename MCRL2_CONCURRENT_INDEXED_SET_CLASS::size_type, bool>
+MCRL2_CONCURRENT_INDEXED_SET_CLASS::insert(const key_type& key, std::size_t thread_index)
+{
+  enter(thread_index);
+
+  // Every thread that passed this check inserts at most one key, which is accounted for by must_resize.
+  while (must_resize(m_size.load(std::memory_order_relaxed)))
+  {
+    leave(thread_index);
+    resize(m_size.load(std::memory_order_relaxed) + 1, thread_index);
+    enter(thread_index);
+  }
+
+  const std::size_t hash = m_hasher(key);
+  const std::uint64_t key_tag = tag(hash);
+  const std::size_t mask = m_capacity - 1;
+
+  std::size_t position = first_position(hash);
+  while (true)
+  {
+    std::uint64_t slot = m_table[position].load(std::memory_order_acquire);
+    if (slot == empty_slot)
+    {
+      if (m_table[position].compare_exchange_strong(slot, reserved_slot, std::memory_order_acq_rel))
+      {
+        const size_type index = m_size.fetch_add(1, std::memory_order_acq_rel);
+        std::allocator_traits<Allocator>::construct(m_allocator, key_storage(index), key);
+        m_table[position].store(key_tag | index, std::memory_order_release);
+
+        leave(thread_index);
+        return std::make_pair(index, true);
+      }
+
+      // Another thread claimed this slot, which must be inspected again.
+      continue;
+    }
+
+    if (slot == reserved_slot)
+    {
+      // The key in this slot is being stored, which can be the same key.
+      std::this_thread::yield();
+      continue;
+    }
+
+    if ((slot & ~index_mask) == key_tag && m_equals((*this)[slot & index_mask], key))
+    {
+      leave(thread_index);
+      return std::make_pair(static_cast<size_type>(slot & index_mask), false);
+    }
+
+    position = (position + 1) & mask;
+  }
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+std::vector<typename MCRL2_CONCURRENT_INDEXED_SET_CLASS::size_type>
+MCRL2_CONCURRENT_INDEXED_SET_CLASS::insert_batch(const std::vector<key_type>& keys, std::size_t number_of_threads)
+{
+  // Resize once up front, such that the threads are not interrupted.
+  reserve(size() + keys.size());
+
+  std::vector<size_type> result(keys.size());
+  constexpr std::size_t block_size = 1024;
+  const std::size_t number_of_blocks = (keys.size() + block_size - 1) / block_size;
+  parallel_for(number_of_blocks, std::min(number_of_threads, m_busy_flags.size()),
+    [&](std::size_t block, std::size_t thread_index)
+    {
+      const std::size_t last = std::min(keys.size(), (block + 1) * block_size);
+      for (std::size_t i = block * block_size; i < last; ++i)
+      {
+        result[i] = insert(keys[i], thread_index).first;
+      }
+    });
+
+  return result;
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+typename MCRL2_CONCURRENT_INDEXED_SET_CLASS::size_type
+MCRL2_CONCURRENT_INDEXED_SET_CLASS::index(const key_type& key, std::size_t thread_index) const
+{
+  enter(thread_index);
+
+  const std::size_t hash = m_hasher(key);
+  const std::uint64_t key_tag = tag(hash);
+  const std::size_t mask = m_capacity - 1;
+
+  std::size_t position = first_position(hash);
+  while (true)
+  {
+    const std::uint64_t slot = m_table[position].load(std::memory_order_acquire);
+    if (slot == empty_slot)
+    {
+      leave(thread_index);
+      return npos;
+    }
+
+    if (slot == reserved_slot)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    if ((slot & ~index_mask) == key_tag && m_equals((*this)[slot & index_mask], key))
+    {
+      leave(thread_index);
+      return static_cast<size_type>(slot & index_mask);
+    }
+
+    position = (position + 1) & mask;
+  }
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+void MCRL2_CONCURRENT_INDEXED_SET_CLASS::reserve(size_type number_of_keys, std::size_t thread_index)
+{
+  resize(number_of_keys, thread_index);
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+inline const Key& MCRL2_CONCURRENT_INDEXED_SET_CLASS::operator[](size_type index) const
+{
+  std::size_t offset;
+  const std::size_t segment = segment_of(index, offset);
+  return m_segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+const Key& MCRL2_CONCURRENT_INDEXED_SET_CLASS::at(size_type index) const
+{
+  if (index >= size())
+  {
+    throw std::out_of_range("concurrent_indexed_set: index does not exist.");
+  }
+  return (*this)[index];
+}
+
+MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+void MCRL2_CONCURRENT_INDEXED_SET_CLASS::clear()
+{
+  const size_type size = m_size.load(std::memory_order_relaxed);
+  for (size_type index = 0; index < size; ++index)
+  {
+    std::allocator_traits<Allocator>::destroy(m_allocator, const_cast<Key*>(&(*this)[index]));
+  }
+
+  for (std::size_t segment = 0; segment < number_of_segments; ++segment)
+  {
+    Key* keys = m_segments[segment].exchange(nullptr, std::memory_order_relaxed);
+    if (keys != nullptr)
+    {
+      std::allocator_traits<Allocator>::deallocate(m_allocator, keys, segment_size(segment));
+    }
+  }
+
+  for (std::size_t i = 0; i < m_capacity; ++i)
+  {
+    m_table[i].store(empty_slot, std::memory_order_relaxed);
+  }
+  m_size.store(0, std::memory_order_relaxed);
+}
+
+} // namespace mcrl2::utilities
+
+#undef MCRL2_CONCURRENT_INDEXED_SET_TEMPLATES
+#undef MCRL2_CONCURRENT_INDEXED_SET_CLASS
+
+#endif // MCRL2_UTILITIES_DETAIL_CONCURRENT_INDEXED_SET_IMPLEMENTATION_H
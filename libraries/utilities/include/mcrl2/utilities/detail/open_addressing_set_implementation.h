@@ -0,0 +1,541 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/open_addressing_set_implementation.h
+/// \brief Implementation of the open_addressing_set.
+
+#ifndef MCRL2_UTILITIES_DETAIL_OPEN_ADDRESSING_SET_IMPLEMENTATION_H
+#define MCRL2_UTILITIES_DETAIL_OPEN_ADDRESSING_SET_IMPLEMENTATION_H
+#pragma once
+
+#include "mcrl2/utilities/open_addressing_set.h"
+#include "mcrl2/utilities/power_of_two.h"
+
+#include <thread>
+
+#define MCRL2_OPEN_ADDRESSING_SET_TEMPLATES template<typename Key, typename Hash, typename Equals, typename Allocator, bool ThreadSafe, bool Resize>
+#define MCRL2_OPEN_ADDRESSING_SET_CLASS open_addressing_set<Key, Hash, Equals, Allocator, ThreadSafe, Resize>
+
+namespace mcrl2::utilities
+{
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS::open_addressing_set(const open_addressing_set& set)
+  : m_hash(set.m_hash),
+    m_equals(set.m_equals)
+{
+  reserve(set.size());
+
+  for (const Key& element : set)
+  {
+    emplace(element);
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS& MCRL2_OPEN_ADDRESSING_SET_CLASS::operator=(const open_addressing_set& set)
+{
+  if (this != &set)
+  {
+    clear();
+    reserve(set.size());
+
+    for (const Key& element : set)
+    {
+      emplace(element);
+    }
+  }
+
+  return *this;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS::open_addressing_set(open_addressing_set&& other) noexcept
+  : m_control(std::move(other.m_control)),
+    m_slots(std::move(other.m_slots)),
+    m_capacity(other.m_capacity),
+    m_mask(other.m_mask),
+    m_number_of_elements(static_cast<size_type>(other.m_number_of_elements)),
+    m_used_slots(static_cast<size_type>(other.m_used_slots)),
+    m_closed(static_cast<bool>(other.m_closed)),
+    m_overflow(std::move(other.m_overflow)),
+    m_hash(std::move(other.m_hash)),
+    m_equals(std::move(other.m_equals)),
+    m_allocator(std::move(other.m_allocator))
+{
+  other.reset();
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS& MCRL2_OPEN_ADDRESSING_SET_CLASS::operator=(open_addressing_set&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (m_capacity > 0)
+    {
+      clear();
+    }
+
+    m_control = std::move(other.m_control);
+    m_slots = std::move(other.m_slots);
+    m_capacity = other.m_capacity;
+    m_mask = other.m_mask;
+    m_number_of_elements = static_cast<size_type>(other.m_number_of_elements);
+    m_used_slots = static_cast<size_type>(other.m_used_slots);
+    m_closed = static_cast<bool>(other.m_closed);
+    m_overflow = std::move(other.m_overflow);
+    m_hash = std::move(other.m_hash);
+    m_equals = std::move(other.m_equals);
+    m_allocator = std::move(other.m_allocator);
+    other.reset();
+  }
+
+  return *this;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS::~open_addressing_set()
+{
+  // This set is not moved-from.
+  if (m_capacity > 0)
+  {
+    clear();
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::clear()
+{
+  for (std::size_t index = 0; index < number_of_slots(); ++index)
+  {
+    if (m_control[index].load(std::memory_order_relaxed) < detail::ControlEmpty)
+    {
+      destroy(m_slots[index].key);
+    }
+    m_control[index].store(detail::ControlEmpty, std::memory_order_relaxed);
+  }
+
+  for (const auto& [hash, key] : m_overflow)
+  {
+    mcrl2_unused(hash);
+    destroy(key);
+  }
+  m_overflow.clear();
+
+  m_number_of_elements = 0;
+  m_used_slots = 0;
+  m_closed = false;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+auto MCRL2_OPEN_ADDRESSING_SET_CLASS::emplace(Args&&... args) -> std::pair<iterator, bool>
+{
+  if constexpr (Resize) { rehash_if_needed(); }
+
+  if constexpr (allow_transparent)
+  {
+    return emplace_impl(m_hash(args...), std::forward<Args>(args)...);
+  }
+  else
+  {
+    // Compute the hash on a temporary object.
+    const std::size_t hash = m_hash(Key(args...));
+    return emplace_impl(hash, std::forward<Args>(args)...);
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+auto MCRL2_OPEN_ADDRESSING_SET_CLASS::erase(const_iterator it) -> iterator
+{
+  assert(it != end());
+  --m_number_of_elements;
+
+  if (it.m_index < number_of_slots())
+  {
+    // The slot stays used, because it can be part of the probe sequence of another element.
+    m_control[it.m_index].store(detail::ControlDeleted, std::memory_order_relaxed);
+    destroy(it.m_key);
+    return const_iterator::first_from(this, it.m_index + 1);
+  }
+
+  auto next = m_overflow.erase(it.m_overflow_it);
+  destroy(it.m_key);
+  return const_iterator(this, next);
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::erase(const Args&... args)
+{
+  const_iterator it = find(args...);
+  if (it != end())
+  {
+    erase(it);
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+auto MCRL2_OPEN_ADDRESSING_SET_CLASS::find(const Args&... args) const -> const_iterator
+{
+  if constexpr (allow_transparent)
+  {
+    return find_impl(m_hash(args...), args...);
+  }
+  else
+  {
+    Key element(args...);
+    return find_impl(m_hash(element), element);
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::rehash(size_type number_of_buckets)
+{
+  // The table must be able to store the current elements without exceeding the maximum load.
+  number_of_buckets = std::max(number_of_buckets, m_number_of_elements + m_number_of_elements / 3 + 1);
+  number_of_buckets = std::max(utilities::round_up_to_power_of_two(number_of_buckets), minimum_slots);
+
+  if (number_of_buckets > m_capacity || m_used_slots > m_number_of_elements || !m_overflow.empty())
+  {
+    rebuild(std::max(number_of_buckets, m_capacity));
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::rehash_if_needed()
+{
+  if (m_used_slots >= maximum_used_slots(m_capacity) || !m_overflow.empty())
+  {
+    // Only grow when the elements themselves, as opposed to erased elements, fill half of the table.
+    rehash(m_number_of_elements >= m_capacity / 2 ? 2 * m_capacity : m_capacity);
+  }
+}
+
+/// Private functions
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+auto MCRL2_OPEN_ADDRESSING_SET_CLASS::emplace_impl(std::size_t hash, Args&&... args) -> std::pair<iterator, bool>
+{
+  const std::uint8_t h2 = detail::control_hash(hash);
+
+  // Visit windows of GroupSize slots with triangular steps. The windows start at the same position modulo GroupSize,
+  // and as the number of windows is a power of two every slot in them is visited. Within the probe sequence the
+  // elements are compared up to the first empty slot. All insertions of equal elements follow the same probe sequence
+  // and have to claim that empty slot with a compare-and-swap, which guarantees that an element is inserted once.
+  std::size_t first = hash & m_mask;
+  for (std::size_t step = 1; step <= m_capacity / detail::GroupSize; ++step)
+  {
+    std::size_t offset = 0;
+    while (offset < detail::GroupSize)
+    {
+      const detail::control_group control(&m_control[first]);
+      const std::uint32_t remaining = (0xFFFFu << offset) & 0xFFFFu;
+
+      // Slots are never emptied, so an equal element is always stored before the first empty slot of the probe
+      // sequence. This means that the published elements can be compared before the end of the sequence is known.
+      std::uint32_t candidates = control.match(h2) & remaining;
+      while (candidates != 0)
+      {
+        const std::size_t index = first + detail::lowest_bit(candidates);
+        candidates &= candidates - 1;
+
+        if (m_control[index].load(std::memory_order_acquire) == h2
+            && m_slots[index].hash == hash
+            && m_equals(*m_slots[index].key, args...))
+        {
+          return std::make_pair(const_iterator(this, index), false);
+        }
+      }
+
+      const std::uint32_t stop = (control.match(detail::ControlEmpty) | control.match(detail::ControlRedirect)) & remaining;
+      const std::size_t limit = stop != 0 ? detail::lowest_bit(stop) : detail::GroupSize;
+
+      // Elements that are being inserted by other threads must be compared once they are published.
+      candidates = control.match(detail::ControlBusy) & remaining & ((1u << limit) - 1);
+      while (candidates != 0)
+      {
+        const std::size_t index = first + detail::lowest_bit(candidates);
+        candidates &= candidates - 1;
+
+        if (wait_until_published(index) == h2
+            && m_slots[index].hash == hash
+            && m_equals(*m_slots[index].key, args...))
+        {
+          return std::make_pair(const_iterator(this, index), false);
+        }
+      }
+
+      if (limit == detail::GroupSize)
+      {
+        break;
+      }
+
+      // Claim the first slot that ends the probe sequence, or redirect the probe sequence to the overflow table.
+      const std::size_t index = first + limit;
+      std::uint8_t expected = m_control[index].load(std::memory_order_acquire);
+      if (expected == detail::ControlRedirect)
+      {
+        return emplace_overflow(hash, std::forward<Args>(args)...);
+      }
+
+      if (expected == detail::ControlEmpty)
+      {
+        const bool closed = m_closed;
+        if (claim(index, expected, closed ? detail::ControlRedirect : detail::ControlBusy))
+        {
+          if (closed)
+          {
+            return emplace_overflow(hash, std::forward<Args>(args)...);
+          }
+
+          Key* key;
+          try
+          {
+            key = construct(std::forward<Args>(args)...);
+          }
+          catch (...)
+          {
+            m_control[index].store(detail::ControlDeleted, std::memory_order_release);
+            ++m_used_slots;
+            throw;
+          }
+
+          // Publish the element, after which other threads can inspect the slot.
+          m_slots[index] = slot{key, hash};
+          m_control[index].store(h2, std::memory_order_release);
+
+          ++m_number_of_elements;
+          if (++m_used_slots >= closing_used_slots(m_capacity))
+          {
+            m_closed = true;
+          }
+
+          return std::make_pair(const_iterator(this, index), true);
+        }
+      }
+
+      // Another thread has changed this slot in the meantime, so inspect it again.
+      offset = limit;
+    }
+
+    first = (first + step * detail::GroupSize) & m_mask;
+  }
+
+  // There is always an empty slot, because the table is closed before it becomes full.
+  assert(false);
+  return emplace_overflow(hash, std::forward<Args>(args)...);
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+auto MCRL2_OPEN_ADDRESSING_SET_CLASS::emplace_overflow(std::size_t hash, Args&&... args) -> std::pair<iterator, bool>
+{
+  std::unique_lock<std::mutex> lock(m_overflow_mutex, std::defer_lock);
+  if constexpr (ThreadSafe) { lock.lock(); }
+
+  auto [begin, end] = m_overflow.equal_range(hash);
+  for (auto it = begin; it != end; ++it)
+  {
+    if (m_equals(*it->second, args...))
+    {
+      return std::make_pair(const_iterator(this, it), false);
+    }
+  }
+
+  auto it = m_overflow.emplace(hash, construct(std::forward<Args>(args)...));
+  ++m_number_of_elements;
+  return std::make_pair(const_iterator(this, it), true);
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+auto MCRL2_OPEN_ADDRESSING_SET_CLASS::find_impl(std::size_t hash, const Args&... args) const -> const_iterator
+{
+  const std::uint8_t h2 = detail::control_hash(hash);
+
+  std::size_t first = hash & m_mask;
+  for (std::size_t step = 1; step <= m_capacity / detail::GroupSize; ++step)
+  {
+    const detail::control_group control(&m_control[first]);
+
+    const std::uint32_t stop = control.match(detail::ControlEmpty) | control.match(detail::ControlRedirect);
+    const std::size_t limit = stop != 0 ? detail::lowest_bit(stop) : detail::GroupSize;
+
+    std::uint32_t candidates = (control.match(h2) | control.match(detail::ControlBusy)) & ((1u << limit) - 1);
+    while (candidates != 0)
+    {
+      const std::size_t index = first + detail::lowest_bit(candidates);
+      candidates &= candidates - 1;
+
+      if (wait_until_published(index) == h2
+          && m_slots[index].hash == hash
+          && m_equals(*m_slots[index].key, args...))
+      {
+        return const_iterator(this, index);
+      }
+    }
+
+    if (limit < detail::GroupSize)
+    {
+      // A slot that was empty when the group was loaded can have been claimed by another thread since, in which case
+      // the element in that slot was inserted after this lookup started. So it is fine to stop here, unless the
+      // probe sequence was redirected to the overflow table.
+      if (m_control[first + limit].load(std::memory_order_acquire) != detail::ControlRedirect)
+      {
+        return end();
+      }
+
+      std::unique_lock<std::mutex> lock(m_overflow_mutex, std::defer_lock);
+      if constexpr (ThreadSafe) { lock.lock(); }
+
+      auto [begin, end] = m_overflow.equal_range(hash);
+      for (auto it = begin; it != end; ++it)
+      {
+        if (m_equals(*it->second, args...))
+        {
+          return const_iterator(this, it);
+        }
+      }
+      return this->end();
+    }
+
+    first = (first + step * detail::GroupSize) & m_mask;
+  }
+
+  return end();
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+Key* MCRL2_OPEN_ADDRESSING_SET_CLASS::construct(Args&&... args)
+{
+  Key* key = detail::allocate(m_allocator, args...);
+  std::allocator_traits<allocator_type>::construct(m_allocator, key, std::forward<Args>(args)...);
+  return key;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::destroy(Key* key)
+{
+  std::allocator_traits<allocator_type>::destroy(m_allocator, key);
+  std::allocator_traits<allocator_type>::deallocate(m_allocator, key, 1);
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+bool MCRL2_OPEN_ADDRESSING_SET_CLASS::claim(std::size_t index, std::uint8_t& expected, std::uint8_t desired)
+{
+  if constexpr (ThreadSafe)
+  {
+    return m_control[index].compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+  }
+  else
+  {
+    m_control[index].store(desired, std::memory_order_relaxed);
+    return true;
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+std::uint8_t MCRL2_OPEN_ADDRESSING_SET_CLASS::wait_until_published(std::size_t index) const
+{
+  std::uint8_t control = m_control[index].load(std::memory_order_acquire);
+  if constexpr (ThreadSafe)
+  {
+    while (control == detail::ControlBusy)
+    {
+      std::this_thread::yield();
+      control = m_control[index].load(std::memory_order_acquire);
+    }
+  }
+
+  assert(control != detail::ControlBusy);
+  return control;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::rebuild(size_type capacity)
+{
+  assert(is_power_of_two(capacity) && capacity >= minimum_slots);
+
+  control_vector old_control(std::move(m_control));
+  slot_vector old_slots(std::move(m_slots));
+  const size_type old_number_of_slots = number_of_slots();
+
+  // Create the new table, the elements themselves are not moved or copied. There are GroupSize - 1 control bytes
+  // after the last slot, such that a group can be loaded at every slot, which never indicate an element.
+  m_capacity = capacity;
+  m_mask = capacity - 1;
+  m_control = control_vector(number_of_slots() + detail::GroupSize - 1);
+  m_slots = slot_vector(number_of_slots());
+  for (std::size_t index = 0; index < number_of_slots(); ++index)
+  {
+    m_control[index].store(detail::ControlEmpty, std::memory_order_relaxed);
+  }
+  for (std::size_t index = number_of_slots(); index < number_of_slots() + detail::GroupSize - 1; ++index)
+  {
+    m_control[index].store(detail::ControlDeleted, std::memory_order_relaxed);
+  }
+
+  // The elements are known to be unique, so each element is put into the first empty slot of its probe sequence.
+  auto insert = [this](const slot& element)
+  {
+    std::size_t first = element.hash & m_mask;
+    for (std::size_t step = 1; ; ++step)
+    {
+      const std::uint32_t empty = detail::control_group(&m_control[first]).match(detail::ControlEmpty);
+      if (empty != 0)
+      {
+        const std::size_t index = first + detail::lowest_bit(empty);
+        m_control[index].store(detail::control_hash(element.hash), std::memory_order_relaxed);
+        m_slots[index] = element;
+        return;
+      }
+
+      first = (first + step * detail::GroupSize) & m_mask;
+    }
+  };
+
+  for (std::size_t index = 0; index < old_number_of_slots; ++index)
+  {
+    if (old_control[index].load(std::memory_order_relaxed) < detail::ControlEmpty)
+    {
+      insert(old_slots[index]);
+    }
+  }
+
+  for (const auto& [hash, key] : m_overflow)
+  {
+    insert(slot{key, hash});
+  }
+  m_overflow.clear();
+
+  m_used_slots = static_cast<size_type>(m_number_of_elements);
+  m_closed = false;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::reset() noexcept
+{
+  control_vector().swap(m_control);
+  slot_vector().swap(m_slots);
+  m_capacity = 0;
+  m_mask = 0;
+  m_number_of_elements = 0;
+  m_used_slots = 0;
+  m_closed = false;
+  m_overflow.clear();
+}
+
+#undef MCRL2_OPEN_ADDRESSING_SET_CLASS
+#undef MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_DETAIL_OPEN_ADDRESSING_SET_IMPLEMENTATION_H
@@ -218,7 +218,7 @@ void MCRL2_UNORDERED_SET_CLASS::rehash(std::size_t number_of_buckets)
   // Recreate the hash table, but don't move or copy the old elements.
   {
     // clear() doesn't actually free the memory used and still results in an 3n peak.
-    std::vector<bucket_type>().swap(m_buckets);
+    bucket_vector().swap(m_buckets);
   }
   m_buckets.resize(number_of_buckets);
   m_buckets_mask = m_buckets.size() - 1;
@@ -10,6 +10,7 @@
 #define MCRL2_UTILITIES_INDEXED_SET_H
 
 #include <deque>
+#include <memory>
 #include <mutex>
 
 #include "mcrl2/utilities/unordered_map.h"
@@ -85,7 +86,8 @@ template<typename Key,
 class indexed_set
 {
 private:
-  std::vector<std::size_t> m_hashtable;
+  /// \brief The hash table uses the same allocator as the keys.
+  std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> m_hashtable;
   KeyTable m_keys;
 
   /// \brief Mutex for the m_hashtable and m_keys data structures.
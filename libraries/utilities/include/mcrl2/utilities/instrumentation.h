@@ -0,0 +1,128 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/instrumentation.h
+/// \brief Spans and counters to measure where time goes inside the tools.
+
+#ifndef MCRL2_UTILITIES_INSTRUMENTATION_H
+#define MCRL2_UTILITIES_INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace mcrl2::utilities
+{
+
+namespace detail
+{
+
+/// \brief Whether spans and counters are recorded, which is checked on every use.
+extern std::atomic<bool> g_tracing_enabled;
+
+/// \returns The number of nanoseconds since tracing was enabled.
+std::uint64_t trace_clock();
+
+/// \brief Stores a span in the ring buffer of the calling thread.
+void record_span(const char* name, std::uint64_t start, std::uint64_t finish);
+
+/// \brief Adds to the counter with the given identifier of the calling thread.
+void add_to_counter(std::size_t id, std::size_t value);
+
+} // namespace detail
+
+/// \returns True iff spans and counters are recorded.
+inline bool tracing_enabled()
+{
+  return detail::g_tracing_enabled.load(std::memory_order_relaxed);
+}
+
+/// \brief Enables or disables the recording of spans and counters. Enabling discards everything recorded before.
+/// \details Every thread records its spans in its own ring buffer, of which only the most recent spans are kept,
+///          but the totals per span are always complete. This must not be called while other threads record spans.
+void enable_tracing(bool enable = true);
+
+/// \brief Writes a table with the number of calls and the total time of every span and the total of every counter.
+/// \details Must only be called when no other thread records spans, for example after all worker threads have joined.
+void write_trace_summary(std::ostream& out);
+
+/// \brief Writes all spans in the ring buffers and the counters in the Chrome trace format, which can be inspected
+///        with chrome://tracing or Perfetto.
+void write_chrome_trace(std::ostream& out);
+
+/// \brief Writes the Chrome trace to the given file, or the summary to standard error if the filename is empty.
+/// \throws mcrl2::runtime_error when the file cannot be written.
+void write_trace(const std::string& filename);
+
+/// \brief Measures the time between its construction and destruction when tracing is enabled.
+/// \details The name must be a string literal, or otherwise outlive the recorded trace.
+///
+/// Example usage:
+///   {
+///     utilities::trace_span span("garbage collection");
+///     ... (execute some code here) ...
+///   }
+class trace_span
+{
+public:
+  explicit trace_span(const char* name)
+    : m_name(name),
+      m_enabled(tracing_enabled()),
+      m_start(m_enabled ? detail::trace_clock() : 0)
+  {}
+
+  ~trace_span()
+  {
+    if (m_enabled)
+    {
+      detail::record_span(m_name, m_start, detail::trace_clock());
+    }
+  }
+
+  trace_span(const trace_span&) = delete;
+  trace_span& operator=(const trace_span&) = delete;
+
+private:
+  const char* m_name;
+  bool m_enabled;
+  std::uint64_t m_start;
+};
+
+/// \brief A named counter of which every thread keeps its own total, such that counting does not synchronise.
+/// \details Counters are intended to be static objects, the name must be a string literal.
+class trace_counter
+{
+public:
+  explicit trace_counter(const char* name);
+
+  /// \brief Adds the value to the counter when tracing is enabled.
+  void add(std::size_t value = 1) const
+  {
+    if (tracing_enabled())
+    {
+      detail::add_to_counter(m_id, value);
+    }
+  }
+
+  const trace_counter& operator++() const
+  {
+    add(1);
+    return *this;
+  }
+
+  /// \returns The sum of the counter over all threads since tracing was enabled.
+  std::size_t total() const;
+
+private:
+  std::size_t m_id;
+};
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_INSTRUMENTATION_H
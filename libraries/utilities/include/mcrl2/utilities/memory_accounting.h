@@ -0,0 +1,178 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/memory_accounting.h
+/// \brief Accounts the memory of the major data structures per subsystem, and enforces a memory budget.
+
+#ifndef MCRL2_UTILITIES_MEMORY_ACCOUNTING_H
+#define MCRL2_UTILITIES_MEMORY_ACCOUNTING_H
+
+#include "mcrl2/utilities/page_allocator.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace mcrl2::utilities
+{
+
+/// \brief The subsystems to which memory is accounted.
+enum class memory_subsystem : std::size_t
+{
+  terms,           ///< The blocks that store the terms and function symbols of the term pool.
+  blocks,          ///< The blocks of the other memory pools, such as the nodes of unordered sets and maps.
+  hash_tables,     ///< The bucket arrays of hash tables, which includes the hash table of the term pool.
+  explorer,        ///< The discovered states and the todo lists of the explorer.
+  lts,             ///< The transitions of an LTS under construction.
+  structure_graph, ///< The vertices of structure graphs.
+  enumerator       ///< The queues of the enumerator.
+};
+
+/// \brief The number of elements of memory_subsystem.
+constexpr std::size_t number_of_memory_subsystems = 7;
+
+/// \returns A printable name of the subsystem.
+const char* to_string(memory_subsystem subsystem);
+
+/// \returns The statistics of the memory accounted to the given subsystem.
+allocation_statistics& memory_statistics(memory_subsystem subsystem);
+
+/// \returns The statistics of the memory accounted to all subsystems together.
+allocation_statistics& memory_statistics();
+
+/// \returns The number of bytes that are resident in main memory for this process, or zero when it is unknown.
+std::size_t resident_memory();
+
+/// \returns The maximum number of bytes that were resident in main memory for this process, or zero when it is
+///          unknown.
+std::size_t peak_resident_memory();
+
+/// \returns The number of bytes as a human readable string, for example 1.5 GiB.
+std::string format_bytes(std::size_t bytes);
+
+/// \brief Converts a number of bytes with an optional suffix K, M, G or T, denoting powers of 1024, to a number.
+/// \throws mcrl2::runtime_error when the text is not a valid size.
+std::size_t parse_memory_size(const std::string& text);
+
+namespace detail
+{
+
+/// \brief Set when more memory is used than the budget allows, which is checked frequently.
+extern std::atomic<bool> g_memory_budget_exceeded;
+
+} // namespace detail
+
+/// \brief Limits the memory that may be used to the given number of bytes, or removes the limit when it is zero.
+/// \details The budget is exceeded when the memory accounted to all subsystems or the resident memory of the process
+///          exceeds it. The accounted memory is checked on every allocation, the resident memory is checked ten
+///          times per second by a background thread. Long running algorithms stop when the budget is exceeded, after
+///          which check_memory_budget reports it.
+void set_memory_budget(std::size_t bytes);
+
+/// \returns The current memory budget, or zero when there is none.
+std::size_t memory_budget();
+
+/// \returns True iff the memory budget has been exceeded.
+inline bool memory_budget_exceeded()
+{
+  return detail::g_memory_budget_exceeded.load(std::memory_order_relaxed);
+}
+
+/// \brief Aborts the current computation when the memory budget has been exceeded.
+/// \details Must be called outside of worker threads, for example after they have been joined.
+/// \throws mcrl2::runtime_error describing the memory use per subsystem when the budget has been exceeded.
+void check_memory_budget();
+
+/// \brief Writes a table with the memory in use and the peak memory of every subsystem, and of the process.
+void write_memory_report(std::ostream& out);
+
+/// \brief Starts a background thread that writes a one line summary of the memory use to standard error after each
+///        interval. An interval of zero stops the reports.
+void set_memory_report_interval(std::chrono::milliseconds interval);
+
+/// \brief A stateless allocator that accounts the memory it allocates to the given subsystem.
+template<typename T, memory_subsystem Subsystem>
+class accounting_allocator
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <class U>
+  struct rebind
+  {
+    typedef accounting_allocator<U, Subsystem> other;
+  };
+
+  accounting_allocator() = default;
+
+  template<typename U>
+  accounting_allocator(const accounting_allocator<U, Subsystem>&) {}
+
+  T* allocate(size_type n)
+  {
+    T* result = std::allocator<T>().allocate(n);
+    memory_statistics(Subsystem).allocate(n * sizeof(T));
+    return result;
+  }
+
+  void deallocate(T* pointer, size_type n)
+  {
+    memory_statistics(Subsystem).deallocate(n * sizeof(T));
+    std::allocator<T>().deallocate(pointer, n);
+  }
+
+  template<typename U>
+  bool operator==(const accounting_allocator<U, Subsystem>&) const noexcept { return true; }
+
+  template<typename U>
+  bool operator!=(const accounting_allocator<U, Subsystem>&) const noexcept { return false; }
+};
+
+/// \brief Accounts the memory of a container that is not allocator aware, by updating its size when it changes.
+/// \details The memory is no longer accounted when this object is destroyed.
+class accounted_memory : private noncopyable
+{
+public:
+  explicit accounted_memory(memory_subsystem subsystem)
+    : m_subsystem(subsystem)
+  {}
+
+  ~accounted_memory()
+  {
+    update(0);
+  }
+
+  /// \brief Sets the number of bytes used by the container, which is cheap when it did not change.
+  void update(std::size_t bytes)
+  {
+    if (bytes != m_bytes)
+    {
+      if (m_bytes != 0)
+      {
+        memory_statistics(m_subsystem).deallocate(m_bytes);
+      }
+      if (bytes != 0)
+      {
+        memory_statistics(m_subsystem).allocate(bytes);
+      }
+      m_bytes = bytes;
+    }
+  }
+
+private:
+  memory_subsystem m_subsystem;
+  std::size_t m_bytes = 0;
+};
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_MEMORY_ACCOUNTING_H
@@ -12,10 +12,12 @@
 
 #include "mcrl2/utilities/detail/free_list.h"
 #include "mcrl2/utilities/noncopyable.h"
+#include "mcrl2/utilities/memory_accounting.h"
 
 #include <array>
 #include <cstdint>
 #include <forward_list>
+#include <new>
 #include <type_traits>
 #include <mutex>
 
@@ -25,10 +27,13 @@ namespace utilities
 {
 
 /// \brief The memory pool allocates elements of size T from blocks.
-/// \details When ThreadSafe is true then the thread-safe guarantees will be satisfied.
+/// \details When ThreadSafe is true then the thread-safe guarantees will be satisfied. The blocks are obtained from a
+///          page arena, which uses huge pages and NUMA placement when these are enabled by set_huge_page_mode and
+///          set_numa_aware. The blocks are accounted to the given subsystem.
 template <class T, 
           std::size_t ElementsPerBlock = 1024, 
-          bool ThreadSafe = false>
+          bool ThreadSafe = false,
+          memory_subsystem Subsystem = memory_subsystem::blocks>
 class memory_pool : private mcrl2::utilities::noncopyable
 {
 public:
@@ -42,14 +47,14 @@ public:
 
     /// For all actual elements stored in the pool trigger the destructor.
     bool first_block = true;
-    for (auto& block : m_blocks)
+    for (Block* block : m_blocks)
     {
       if (first_block)
       {
         // This is the first block, for that one only m_current_index elements were inserted.
         for (std::size_t index = 0; index < m_current_index; ++index)
         {
-          auto& slot = block[index];
+          auto& slot = (*block)[index];
           if (!slot.is_marked())
           {
             reinterpret_cast<T*>(&slot)->~T();
@@ -59,7 +64,7 @@ public:
       }
       else
       {
-        for (auto& slot : block)
+        for (auto& slot : *block)
         {
           if (!slot.is_marked())
           {
@@ -67,6 +72,8 @@ public:
           }
         }
       }
+
+      free_block(block);
     }
 
     assert(m_freelist.empty());
@@ -91,13 +98,13 @@ public:
     if (m_current_index >= ElementsPerBlock)
     {
       // The whole buffer was used so allocate a new one.
-      m_blocks.emplace_front();
+      m_blocks.push_front(new (m_arena.allocate(sizeof(Block))) Block());
       ++m_number_of_blocks;
       m_current_index = 0;
     }
 
     // The object was last written as this slot is not part of the freelist.
-    T& slot = (m_blocks.front()[m_current_index++]).element();
+    T& slot = ((*m_blocks.front())[m_current_index++]).element();
 
     if constexpr (ThreadSafe) { m_block_mutex.unlock(); }
     assert(contains(&slot));
@@ -126,7 +133,7 @@ public:
     auto block_before_it = m_blocks.before_begin();
     for (auto it = m_blocks.begin(); it != m_blocks.end();)
     {
-      Block& block = *it;
+      Block& block = **it;
 
       // Keep track of the head of the freelist.
       FreelistIt old_freelist_head = m_freelist.begin();
@@ -153,6 +160,7 @@ public:
         m_freelist.erase_after(m_freelist.before_begin(), old_freelist_head);
 
         // The current block only has elements in the freelist, so erase it.
+        free_block(&block);
         it = m_blocks.erase_after(block_before_it);
         --m_number_of_blocks;
       }
@@ -180,6 +188,12 @@ public:
     return m_number_of_blocks * ElementsPerBlock;
   }
 
+  /// \returns The statistics of the blocks allocated by this pool.
+  const allocation_statistics& statistics() const noexcept
+  {
+    return m_arena.statistics();
+  }
+
   // Move constructor and assignment are possible.
   memory_pool(memory_pool&& other) = default;
   memory_pool& operator=(memory_pool&& other) = default;
@@ -199,8 +213,11 @@ private:
   /// \brief Equal to the size of the blocks array to prevent iterating over the block list.
   SizeType m_number_of_blocks = 0;
 
+  /// \brief Provides the memory for the blocks.
+  detail::page_arena m_arena{memory_statistics(Subsystem)};
+
   /// \brief The list of blocks allocated by this pool.
-  std::forward_list<Block> m_blocks;
+  std::forward_list<Block*> m_blocks;
 
   /// \brief Ensures that the block list is only modified by a single thread.
   std::mutex m_block_mutex = {};
@@ -214,9 +231,9 @@ private:
     assert(p != nullptr);
 
     std::uintptr_t pointer = reinterpret_cast<std::uintptr_t>(p);
-    for (auto& block : m_blocks)
+    for (Block* block : m_blocks)
     {
-      std::uintptr_t firstSlot = reinterpret_cast<std::uintptr_t>(block.data());
+      std::uintptr_t firstSlot = reinterpret_cast<std::uintptr_t>(block->data());
       if (firstSlot <= pointer && pointer < firstSlot + sizeof(Slot) * ElementsPerBlock)
       {
         assert((pointer - firstSlot) % sizeof(Slot) == 0);
@@ -227,6 +244,12 @@ private:
     return false;
   }
 
+  /// \brief Returns the memory of the given block, without destroying the elements stored in it.
+  void free_block(Block* block)
+  {
+    block->~Block();
+    m_arena.deallocate(block, sizeof(Block));
+  }
 };
 
 } // namespace utilities
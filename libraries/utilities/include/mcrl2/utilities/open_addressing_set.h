@@ -0,0 +1,481 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/open_addressing_set.h
+/// \brief A hash set that stores pointers to its elements in an open addressing table.
+
+#ifndef MCRL2_UTILITIES_OPEN_ADDRESSING_SET_H
+#define MCRL2_UTILITIES_OPEN_ADDRESSING_SET_H
+
+#include "mcrl2/utilities/detail/bucket_list.h"
+#include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/page_allocator.h"
+#include "mcrl2/utilities/unused.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MCRL2_OPEN_ADDRESSING_SET_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mcrl2::utilities
+{
+
+namespace detail
+{
+
+/// \brief The number of slots of which the control bytes are compared at once.
+constexpr static std::size_t GroupSize = 16;
+
+/// \brief Control bytes of slots that do not store an element, all of them have the highest bit set. The control
+///        byte of a slot that stores an element is equal to seven bits of the hash of that element.
+constexpr static std::uint8_t ControlEmpty = 0x80;    ///< The slot was never used.
+constexpr static std::uint8_t ControlRedirect = 0xFC; ///< Probing continues in the overflow table.
+constexpr static std::uint8_t ControlBusy = 0xFD;     ///< An element is being inserted into the slot.
+constexpr static std::uint8_t ControlDeleted = 0xFE;  ///< The element in the slot was erased.
+
+using control_byte = std::atomic<std::uint8_t>;
+static_assert(sizeof(control_byte) == 1, "The control bytes of a group are compared as a contiguous array.");
+
+/// \brief The control bytes of a group of GroupSize consecutive slots.
+/// \details The bytes are loaded at once, so the masks can be computed with a few SSE2 instructions when available.
+///          Without synchronisation the loaded values can be outdated, so the control byte of a slot that matches
+///          must be loaded again (with acquire semantics) before inspecting the slot.
+class control_group
+{
+public:
+  explicit control_group(const control_byte* control)
+  {
+#ifdef MCRL2_OPEN_ADDRESSING_SET_SSE2
+    m_group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+    for (std::size_t i = 0; i < GroupSize; ++i)
+    {
+      m_group[i] = control[i].load(std::memory_order_relaxed);
+    }
+#endif
+  }
+
+  /// \returns A mask in which bit i is set iff the control byte of slot i is equal to value.
+  std::uint32_t match(std::uint8_t value) const
+  {
+#ifdef MCRL2_OPEN_ADDRESSING_SET_SSE2
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_group, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+    std::uint32_t result = 0;
+    for (std::size_t i = 0; i < GroupSize; ++i)
+    {
+      result |= static_cast<std::uint32_t>(m_group[i] == value) << i;
+    }
+    return result;
+#endif
+  }
+
+  /// \returns A mask in which bit i is set iff slot i stores an element.
+  std::uint32_t match_full() const
+  {
+#ifdef MCRL2_OPEN_ADDRESSING_SET_SSE2
+    return ~static_cast<std::uint32_t>(_mm_movemask_epi8(m_group)) & 0xFFFF;
+#else
+    std::uint32_t result = 0;
+    for (std::size_t i = 0; i < GroupSize; ++i)
+    {
+      result |= static_cast<std::uint32_t>(m_group[i] < ControlEmpty) << i;
+    }
+    return result;
+#endif
+  }
+
+private:
+#ifdef MCRL2_OPEN_ADDRESSING_SET_SSE2
+  __m128i m_group;
+#else
+  std::uint8_t m_group[GroupSize];
+#endif
+};
+
+/// \returns The index of the lowest bit that is set in a non-zero mask.
+inline std::size_t lowest_bit(std::uint32_t mask)
+{
+  assert(mask != 0);
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+  std::size_t result = 0;
+  while ((mask & 1) == 0)
+  {
+    mask >>= 1;
+    ++result;
+  }
+  return result;
+#endif
+}
+
+/// \returns The seven bits of the hash that are stored in the control byte of a slot.
+/// \details The lowest bits of the hash determine the slot at which probing starts, so the control byte is taken
+///          from the highest bits of the hash multiplied by a large odd constant, which depend on all bits of the hash.
+inline std::uint8_t control_hash(std::size_t hash)
+{
+  return static_cast<std::uint8_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 57);
+}
+
+} // namespace detail
+
+/// \brief A set with a subset of the interface of unordered_set that stores its elements in an open addressing table.
+/// \details Every element is allocated separately and is never moved, the table itself only stores a pointer to each
+///          element together with its hash. Next to the table there is a control byte for every slot that contains
+///          seven bits of the hash of the element, such that a lookup compares the control bytes of sixteen slots at
+///          once and only inspects the elements of which these bits match. Probing starts at the slot given by the
+///          lowest bits of the hash, as the bucket in unordered_set, and continues with windows of sixteen slots at
+///          triangular distances. Like unordered_set this class supports allocators with an allocate_args(args...)
+///          function to allocate elements of varying size.
+///
+///          When ThreadSafe is true emplace, find and count can be called concurrently, but erase, clear and
+///          (rehash_)if_needed require exclusive access. An insertion claims an empty slot with a compare-and-swap
+///          on its control byte, and concurrent lookups wait until the element in a claimed slot has been
+///          published. Because the table cannot grow concurrently, elements are put into a (locked) overflow table
+///          when the table is nearly full; these elements are moved into the table by the next rehash_if_needed.
+///          Resize enables automatically growing in emplace, which requires that ThreadSafe is false.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key>,
+         typename Allocator = std::allocator<Key>,
+         bool ThreadSafe = false,
+         bool Resize = true>
+class open_addressing_set
+{
+  static_assert (!(ThreadSafe && Resize), "ThreadSafe cannot be enabled together with automatic resizing.");
+
+private:
+  /// \brief A slot of the table, only valid when its control byte indicates that it stores an element.
+  struct slot
+  {
+    Key* key;
+    std::size_t hash;
+  };
+
+  using overflow_type = std::unordered_multimap<std::size_t, Key*>;
+
+public:
+  /// \brief An iterator over all elements in the table, followed by the elements in the overflow table.
+  class const_iterator
+  {
+  public:
+    using value_type = Key;
+    using reference = const Key&;
+    using pointer = const Key*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() = default;
+
+    const_iterator& operator++()
+    {
+      if (m_index < m_set->number_of_slots())
+      {
+        ++m_index;
+        goto_next_element();
+      }
+      else
+      {
+        ++m_overflow_it;
+        m_key = m_overflow_it != m_set->m_overflow.end() ? m_overflow_it->second : nullptr;
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator copy(*this);
+      ++(*this);
+      return copy;
+    }
+
+    reference operator*() const { return *m_key; }
+    pointer operator->() const { return m_key; }
+
+    bool operator==(const const_iterator& other) const
+    {
+      return m_index == other.m_index && m_key == other.m_key;
+    }
+
+    bool operator!=(const const_iterator& other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class open_addressing_set;
+
+    /// \brief Construct an iterator to the slot with the given index.
+    const_iterator(const open_addressing_set* set, std::size_t index) :
+      m_set(set), m_index(index), m_key(set->m_slots[index].key)
+    {}
+
+    /// \brief Construct an iterator to the given element of the overflow table.
+    const_iterator(const open_addressing_set* set, typename overflow_type::const_iterator it) :
+      m_set(set), m_index(set->number_of_slots()), m_overflow_it(it), m_key(it != set->m_overflow.end() ? it->second : nullptr)
+    {}
+
+    /// \brief Construct an iterator to the first element that is stored in or after the slot with the given index.
+    static const_iterator first_from(const open_addressing_set* set, std::size_t index)
+    {
+      const_iterator result;
+      result.m_set = set;
+      result.m_index = index;
+      result.goto_next_element();
+      return result;
+    }
+
+    /// \brief Moves the iterator to the first slot, starting at m_index, that stores an element, or to the overflow table.
+    void goto_next_element()
+    {
+      // The control bytes after the last slot never indicate an element.
+      while (m_index < m_set->number_of_slots())
+      {
+        const std::uint32_t full = detail::control_group(&m_set->m_control[m_index]).match_full();
+        if (full != 0)
+        {
+          m_index += detail::lowest_bit(full);
+          m_key = m_set->m_slots[m_index].key;
+          return;
+        }
+
+        m_index += detail::GroupSize;
+      }
+
+      m_index = m_set->number_of_slots();
+
+      m_overflow_it = m_set->m_overflow.begin();
+      m_key = m_overflow_it != m_set->m_overflow.end() ? m_overflow_it->second : nullptr;
+    }
+
+    const open_addressing_set* m_set = nullptr;
+    std::size_t m_index = 0; ///< The index of the slot, or the number of slots when the key is in the overflow table.
+    typename overflow_type::const_iterator m_overflow_it;
+    Key* m_key = nullptr; ///< A copy of the pointer to the key, which is nullptr for the end.
+  };
+
+  using key_type = Key;
+  using value_type = Key;
+  using hasher = Hash;
+  using key_equal = Equals;
+  using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = const_iterator;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  open_addressing_set() { rehash(0); }
+
+  /// \brief Constructs a set that can store at least number_of_elements without resizing.
+  explicit open_addressing_set(size_type number_of_elements,
+    const hasher& hash = hasher(),
+    const key_equal& equals = key_equal())
+    : m_hash(hash),
+      m_equals(equals)
+  {
+    reserve(number_of_elements);
+  }
+
+  open_addressing_set(const open_addressing_set& set);
+  open_addressing_set& operator=(const open_addressing_set& set);
+
+  open_addressing_set(open_addressing_set&& other) noexcept;
+  open_addressing_set& operator=(open_addressing_set&& other) noexcept;
+
+  ~open_addressing_set();
+
+  /// \returns A reference to the allocator of the elements.
+  const allocator_type& get_allocator() const noexcept { return m_allocator; }
+  allocator_type& get_allocator() noexcept { return m_allocator; }
+
+  /// \returns An iterator over all keys.
+  iterator begin() const { return const_iterator::first_from(this, 0); }
+  iterator end() const { return const_iterator(this, m_overflow.end()); }
+
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  /// \returns True iff the set is empty.
+  bool empty() const noexcept { return size() == 0; }
+
+  /// \returns The amount of elements stored in this set.
+  size_type size() const noexcept { return m_number_of_elements; }
+
+  /// \brief Removes all elements from the set.
+  /// \details Does not free the table itself.
+  void clear();
+
+  /// \brief Inserts an element Key(args...) into the set if it did not already exist.
+  /// \returns A pair of the iterator pointing to the element and a boolean that is true iff
+  ///          a new element was inserted (as opposed to it already existing in the set).
+  /// \threadsafe
+  template<typename ...Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  /// \brief Erases the element pointed to by the iterator.
+  /// \returns An iterator to the next key.
+  iterator erase(const_iterator it);
+
+  /// \brief Erases the given key_type(args...) from the set.
+  template<typename...Args>
+  void erase(const Args&... args);
+
+  /// \brief Counts the number of occurrences of the given key (1 when it exists and 0 otherwise).
+  /// \threadsafe
+  template<typename ...Args>
+  size_type count(const Args&... args) const { return find(args...) != end(); }
+
+  /// \brief Searches whether an object key_type(args...) occurs in the set.
+  /// \returns An iterator to the matching element or the end when this object does not exist.
+  /// \threadsafe
+  template<typename...Args>
+  const_iterator find(const Args&... args) const;
+
+  /// \returns The number of slots at which probing can start.
+  size_type bucket_count() const noexcept { return m_capacity; }
+
+  /// \returns The number of elements in the overflow table.
+  size_type overflow_size() const noexcept { return m_overflow.size(); }
+
+  /// \returns The number of slots that store an element or that were used by an element that has been erased.
+  size_type used_slots() const noexcept { return m_used_slots; }
+
+  float load_factor() const { return static_cast<float>(size()) / bucket_count(); }
+
+  /// \brief Rebuilds the table such that probing can start at least at number_of_buckets slots. The table is only
+  ///        rebuilt when it becomes larger or when there are erased or overflowing elements.
+  void rehash(size_type number_of_buckets);
+
+  /// \brief Ensures that the given number of elements can be stored without resizing.
+  void reserve(size_type count) { rehash(count + count / 3 + 1); }
+
+  hasher hash_function() const { return m_hash; }
+  key_equal key_eq() const { return m_equals; }
+
+  /// \returns The number of elements that can be present in the set before resizing.
+  /// \details Not standard.
+  size_type capacity() const noexcept { return maximum_used_slots(m_capacity); }
+
+  /// \brief Resizes or cleans up the table when it is too full, contains many erased elements or when elements were
+  ///        put into the overflow table.
+  /// \details Not standard.
+  void rehash_if_needed();
+
+private:
+  // Check for the existence of the is_transparent type.
+  template <typename... >
+  using void_t = void;
+
+  template <typename X, typename = void>
+  struct is_transparent : std::false_type { };
+
+  template <typename X>
+  struct is_transparent<X, void_t<typename X::is_transparent>>
+  : std::true_type { };
+
+  /// \brief True iff the hash and equals functions allow transparent lookup,
+  static constexpr bool allow_transparent = is_transparent<Hash>() && is_transparent<Equals>();
+
+  /// \brief The minimum number of slots at which probing can start, which is a multiple of the group size.
+  static constexpr size_type minimum_slots = 2 * detail::GroupSize;
+
+  /// \returns The number of slots, which includes the slots after the last slot at which probing can start such that
+  ///          every window of GroupSize slots fits.
+  size_type number_of_slots() const noexcept { return m_capacity == 0 ? 0 : m_capacity + detail::GroupSize - 1; }
+
+  /// \returns The number of used slots after which the table is resized, which is three quarters of the slots.
+  static constexpr size_type maximum_used_slots(size_type number_of_slots) { return number_of_slots - number_of_slots / 4; }
+
+  /// \returns The number of used slots after which new elements are put into the overflow table.
+  static constexpr size_type closing_used_slots(size_type number_of_slots) { return number_of_slots - number_of_slots / 16; }
+
+  /// \brief Inserts Key(args...) with the given hash if it does not exist yet.
+  template<typename ...Args>
+  std::pair<iterator, bool> emplace_impl(std::size_t hash, Args&&... args);
+
+  /// \brief Inserts Key(args...) into the overflow table if it does not exist yet.
+  template<typename ...Args>
+  std::pair<iterator, bool> emplace_overflow(std::size_t hash, Args&&... args);
+
+  /// \brief Searches for an element equal to args... with the given hash.
+  template<typename ...Args>
+  const_iterator find_impl(std::size_t hash, const Args&... args) const;
+
+  /// \brief Allocates and constructs a new element Key(args...).
+  template<typename ...Args>
+  Key* construct(Args&&... args);
+
+  /// \brief Destroys and deallocates the given element.
+  void destroy(Key* key);
+
+  /// \brief Changes the control byte of the slot with the given index from expected into desired.
+  /// \returns False when another thread has changed the control byte, in which case expected is updated.
+  bool claim(std::size_t index, std::uint8_t& expected, std::uint8_t desired);
+
+  /// \brief Waits until the slot with the given index is no longer being filled.
+  /// \returns The control byte of that slot.
+  std::uint8_t wait_until_published(std::size_t index) const;
+
+  /// \brief Replaces the table by an empty table with the given capacity and inserts all elements into it.
+  void rebuild(size_type capacity);
+
+  /// \brief Frees the table without destroying the elements, used when moving.
+  void reset() noexcept;
+
+  /// \brief The control bytes and slots, which are allocated in (huge) pages when the table is large.
+  using control_vector = std::vector<detail::control_byte, page_allocator<detail::control_byte>>;
+  using slot_vector = std::vector<slot, page_allocator<slot>>;
+  control_vector m_control;
+  slot_vector m_slots;
+
+  /// \brief The number of slots at which probing can start, a power of two that is at least minimum_slots.
+  size_type m_capacity = 0;
+
+  /// \brief Always equal to m_capacity - 1.
+  size_type m_mask = 0;
+
+  /// \brief The number of elements stored in this set, including the elements in the overflow table.
+  std::conditional_t<ThreadSafe, std::atomic<size_type>, size_type> m_number_of_elements = 0;
+
+  /// \brief The number of slots that are not empty.
+  std::conditional_t<ThreadSafe, std::atomic<size_type>, size_type> m_used_slots = 0;
+
+  /// \brief True iff new elements must be put into the overflow table.
+  std::conditional_t<ThreadSafe, std::atomic<bool>, bool> m_closed = false;
+
+  overflow_type m_overflow;
+  mutable std::mutex m_overflow_mutex;
+
+  hasher m_hash = hasher();
+  key_equal m_equals = key_equal();
+  allocator_type m_allocator;
+};
+
+/// \brief Prints the number of elements, slots and overflowing elements of an open addressing set.
+template<typename Key, typename Hash, typename Equals, typename Allocator, bool ThreadSafe, bool Resize>
+void print_performance_statistics(const open_addressing_set<Key, Hash, Equals, Allocator, ThreadSafe, Resize>& set)
+{
+  mCRL2log(mcrl2::log::info, "Performance") << "Table stores " << set.size() << " keys in " << set.bucket_count() << " slots, "
+                                            << set.used_slots() << " slots are used and " << set.overflow_size() << " keys overflow.\n";
+}
+
+} // namespace mcrl2::utilities
+
+#include "mcrl2/utilities/detail/open_addressing_set_implementation.h"
+
+#endif // MCRL2_UTILITIES_OPEN_ADDRESSING_SET_H
@@ -0,0 +1,221 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/page_allocator.h
+/// \brief Allocation of large memory regions directly from the operating system, optionally backed by huge pages
+///        and placed on specific NUMA nodes.
+
+#ifndef MCRL2_UTILITIES_PAGE_ALLOCATOR_H_
+#define MCRL2_UTILITIES_PAGE_ALLOCATOR_H_
+
+#include "mcrl2/utilities/noncopyable.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mcrl2::utilities
+{
+
+/// \brief Determines which pages back the memory regions allocated by allocate_pages.
+enum class huge_page_mode
+{
+  none,        ///< Only use the default page size.
+  transparent, ///< Advise the operating system to use transparent huge pages.
+  explicit_    ///< Use the huge pages reserved by the administrator, and transparent huge pages when none are available.
+};
+
+/// \brief Converts a string to a huge page mode, throws an mcrl2::runtime_error when it is not recognised.
+huge_page_mode parse_huge_page_mode(const std::string& text);
+
+std::ostream& operator<<(std::ostream& os, huge_page_mode mode);
+
+/// \brief Determines on which NUMA nodes the pages of a memory region are placed.
+enum class numa_placement
+{
+  local,      ///< On the node of the thread that allocates the region.
+  interleaved ///< Interleaved over all nodes, for regions that are shared by all threads.
+};
+
+/// \brief Sets the kind of pages used for subsequent allocations, the default is huge_page_mode::none.
+void set_huge_page_mode(huge_page_mode mode);
+huge_page_mode get_huge_page_mode();
+
+/// \brief Enables the placement of subsequent allocations on NUMA nodes, disabled by default.
+void set_numa_aware(bool enable);
+bool numa_aware();
+
+/// \returns True iff allocations must be served by allocate_pages, otherwise the default allocator is used.
+inline bool page_allocation_enabled()
+{
+  return get_huge_page_mode() != huge_page_mode::none || numa_aware();
+}
+
+/// \brief The size of a (transparent) huge page, regions are aligned to and a multiple of this size.
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+/// \brief Keeps track of the memory used by an allocator.
+class allocation_statistics : private noncopyable
+{
+public:
+  /// \brief Statistics that are also added to the given parent statistics, when provided.
+  explicit allocation_statistics(allocation_statistics* parent = nullptr)
+    : m_parent(parent)
+  {}
+
+  /// \brief Registers an allocation of the given number of bytes.
+  void allocate(std::size_t bytes);
+  void deallocate(std::size_t bytes);
+
+  /// \brief Registers a region obtained from the operating system.
+  void map(std::size_t bytes, bool huge_pages, bool numa);
+  void unmap(std::size_t bytes, bool huge_pages, bool numa);
+
+  std::size_t allocations() const { return m_allocations.load(std::memory_order_relaxed); }
+  std::size_t bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+  std::size_t peak_bytes() const { return m_peak_bytes.load(std::memory_order_relaxed); }
+  std::size_t mapped_bytes() const { return m_mapped_bytes.load(std::memory_order_relaxed); }
+  std::size_t huge_page_bytes() const { return m_huge_page_bytes.load(std::memory_order_relaxed); }
+  std::size_t numa_bytes() const { return m_numa_bytes.load(std::memory_order_relaxed); }
+
+  /// \brief Marks the memory budget as exceeded when more than the given number of bytes are allocated, see
+  ///        set_memory_budget.
+  void set_limit(std::size_t bytes) { m_limit.store(bytes, std::memory_order_relaxed); }
+
+  /// \returns A one line description of these statistics.
+  std::string message() const;
+
+private:
+  std::atomic<std::size_t> m_allocations = 0;   ///< The number of live allocations.
+  std::atomic<std::size_t> m_bytes = 0;         ///< The number of bytes in live allocations.
+  std::atomic<std::size_t> m_peak_bytes = 0;    ///< The maximum of m_bytes.
+  std::atomic<std::size_t> m_mapped_bytes = 0;  ///< The number of bytes obtained by allocate_pages.
+  std::atomic<std::size_t> m_huge_page_bytes = 0; ///< The part of m_mapped_bytes that uses huge pages.
+  std::atomic<std::size_t> m_numa_bytes = 0;    ///< The part of m_mapped_bytes placed on NUMA nodes.
+  std::atomic<std::size_t> m_limit = std::numeric_limits<std::size_t>::max(); ///< See set_limit.
+
+  allocation_statistics* m_parent;
+};
+
+/// \returns The statistics of the blocks allocated by the memory pools that are not accounted to another subsystem.
+allocation_statistics& block_allocation_statistics();
+
+/// \returns The statistics of the arrays allocated by all page_allocators, which store the buckets of hash tables.
+allocation_statistics& hash_table_allocation_statistics();
+
+/// \brief Obtains a region of at least size bytes from the operating system, aligned to huge_page_size. The pages
+///        follow the current huge page mode and are placed according to the placement when NUMA awareness is enabled.
+/// \throws std::bad_alloc when no memory is available.
+void* allocate_pages(std::size_t size, numa_placement placement, allocation_statistics& statistics);
+
+/// \brief Returns a region obtained by allocate_pages to the operating system.
+/// \returns False when the pointer was not obtained by allocate_pages, in which case nothing happens.
+bool deallocate_pages(void* pointer, allocation_statistics& statistics);
+
+/// \brief An allocator that obtains large arrays from allocate_pages, when enabled, and smaller ones from std::allocator.
+/// \details The pages of these arrays are interleaved over the NUMA nodes since hash tables are shared by all threads.
+template<typename T>
+class page_allocator
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <class U>
+  struct rebind
+  {
+    typedef page_allocator<U> other;
+  };
+
+  page_allocator() = default;
+
+  template<typename U>
+  page_allocator(const page_allocator<U>&) {}
+
+  T* allocate(size_type n)
+  {
+    hash_table_allocation_statistics().allocate(n * sizeof(T));
+    if (n * sizeof(T) >= huge_page_size && page_allocation_enabled())
+    {
+      return static_cast<T*>(allocate_pages(n * sizeof(T), numa_placement::interleaved, hash_table_allocation_statistics()));
+    }
+
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* pointer, size_type n)
+  {
+    hash_table_allocation_statistics().deallocate(n * sizeof(T));
+    if (n * sizeof(T) < huge_page_size || !deallocate_pages(pointer, hash_table_allocation_statistics()))
+    {
+      std::allocator<T>().deallocate(pointer, n);
+    }
+  }
+
+  template<typename U>
+  bool operator==(const page_allocator<U>&) const noexcept { return true; }
+
+  template<typename U>
+  bool operator!=(const page_allocator<U>&) const noexcept { return false; }
+};
+
+namespace detail
+{
+
+/// \returns The NUMA node of the processor that runs the calling thread, or zero when it cannot be determined.
+std::size_t current_numa_node();
+
+/// \brief Serves (small) allocations from chunks of huge_page_size bytes, obtained from allocate_pages, such that
+///        they can share huge pages. Chunks are placed on the NUMA node of the allocating thread.
+/// \details When page allocation is disabled at the moment of the allocation the default allocator is used instead.
+///          This class is not thread safe.
+class page_arena : private noncopyable
+{
+public:
+  /// \brief An arena of which the allocations are added to the given statistics.
+  explicit page_arena(allocation_statistics& parent = block_allocation_statistics())
+    : m_statistics(&parent)
+  {}
+
+  ~page_arena();
+
+  /// \returns Memory for size bytes aligned to (at least) the alignment of std::max_align_t.
+  void* allocate(std::size_t size);
+
+  /// \brief Frees the memory at pointer that was allocated for size bytes.
+  void deallocate(void* pointer, std::size_t size);
+
+  const allocation_statistics& statistics() const { return m_statistics; }
+
+private:
+  struct chunk
+  {
+    std::size_t offset = 0;    ///< The first unused byte in this chunk.
+    std::size_t live = 0;      ///< The number of allocations in this chunk.
+  };
+
+  /// \brief The chunks indexed by their address.
+  std::map<std::uintptr_t, chunk> m_chunks;
+
+  /// \brief The chunk from which allocations are served for every NUMA node, or zero.
+  std::vector<std::uintptr_t> m_current;
+
+  allocation_statistics m_statistics;
+};
+
+} // namespace detail
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_PAGE_ALLOCATOR_H_
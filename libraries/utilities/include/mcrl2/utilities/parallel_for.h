@@ -0,0 +1,91 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/parallel_for.h
+/// \brief Applies a function to a range of indices using a number of threads.
+
+#ifndef MCRL2_UTILITIES_PARALLEL_FOR_H
+#define MCRL2_UTILITIES_PARALLEL_FOR_H
+
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace mcrl2
+{
+
+namespace utilities
+{
+
+/// \brief Calls f(i, t) for every index 0 <= i < n, where t < number_of_threads is the index of the thread
+///        that handles i. Threads take the next index from a shared counter, so the calls for different indices
+///        may be done in any order and must be independent.
+/// \details If a call throws an exception, the remaining indices are skipped and the exception of the call with
+///          the smallest index is rethrown, which is the exception that a sequential loop throws. With one thread,
+///          or when the toolset is compiled without MCRL2_THREAD_SAFE, the calls are done in order on the calling
+///          thread. Other threads must initialise their own term pools, rewriters, etc. before using them.
+template <typename Function>
+void parallel_for(std::size_t n, std::size_t number_of_threads, Function f)
+{
+#ifndef MCRL2_THREAD_SAFE
+  number_of_threads = 1;
+#endif
+  if (number_of_threads <= 1 || n <= 1)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      f(i, 0);
+    }
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(n);
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool> failed(false);
+
+  auto work = [&](std::size_t thread_index)
+  {
+    for (std::size_t i = next++; i < n && !failed.load(); i = next++)
+    {
+      try
+      {
+        f(i, thread_index);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < number_of_threads && t < n; ++t)
+  {
+    threads.emplace_back(work, t);
+  }
+  work(0);
+  for (std::thread& t: threads)
+  {
+    t.join();
+  }
+
+  for (const std::exception_ptr& error: errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} // namespace utilities
+
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_PARALLEL_FOR_H
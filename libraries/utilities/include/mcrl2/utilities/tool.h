@@ -14,8 +14,12 @@
 
 #include "mcrl2/utilities/logger.h"
 
+#include "mcrl2/utilities/bitstream.h"
 #include "mcrl2/utilities/command_line_interface.h"
 #include "mcrl2/utilities/execution_timer.h"
+#include "mcrl2/utilities/instrumentation.h"
+#include "mcrl2/utilities/memory_accounting.h"
+#include "mcrl2/utilities/page_allocator.h"
 #include "mcrl2/utilities/platform.h"
 
 #ifdef MCRL2_PLATFORM_WINDOWS
@@ -62,6 +66,12 @@ class tool
     /// Determines whether timing output should be written
     bool m_timing_enabled;
 
+    /// The filename to which the trace must be written, a summary is written to standard error when it is empty
+    std::string m_trace_filename;
+
+    /// Determines whether the memory use per subsystem is written at the end of the run
+    bool m_memory_report = false;
+
     /// \brief Add options to an interface description.
     /// \param desc An interface description
     virtual void add_options(interface_description& desc)
@@ -69,6 +79,28 @@ class tool
       desc.add_option("timings", make_optional_argument<std::string>("FILE", ""),
                       "append timing measurements to FILE. Measurements are written to "
                       "standard error if no FILE is provided");
+      desc.add_option("trace", make_optional_argument<std::string>("FILE", ""),
+                      "record the time spent in the instrumented parts of the toolset, such as the rewriter, the "
+                      "explorer, the garbage collector and the solvers. A summary is written to standard error if no "
+                      "FILE is provided, otherwise all recorded events are written to FILE in the Chrome trace format");
+      desc.add_option("memory-report", make_optional_argument<std::string>("SEC", "0"),
+                      "write the memory used by the terms, hash tables, explorer, LTS, structure graphs and "
+                      "enumerators, and by the whole process, to standard error at the end of the run. A one line "
+                      "summary is also written every SEC seconds if SEC is provided");
+      desc.add_option("memory-budget", make_mandatory_argument("SIZE"),
+                      "abort when more than SIZE bytes of memory are used, where SIZE may have the suffix K, M, G or "
+                      "T. State space exploration and PBES instantiation stop and report the memory used per "
+                      "subsystem");
+      desc.add_option("huge-pages", make_optional_argument<std::string>("MODE", "transparent"),
+                      "back the blocks of terms and the hash tables with huge pages. MODE is 'transparent' (default) "
+                      "for transparent huge pages, 'explicit' for the huge pages reserved by the administrator, or "
+                      "'none' for the default page size");
+      desc.add_option("numa",
+                      "allocate blocks of terms on the NUMA node of the thread that needs them, and interleave "
+                      "the hash tables over all NUMA nodes");
+      desc.add_option("compress", make_optional_argument<std::string>("NUM", "1"),
+                      "compress binary output files in blocks, using NUM threads to compress blocks in parallel "
+                      "(default 1). Compressed files are recognised automatically when they are read");
     }
 
     /// \brief Parse non-standard options
@@ -81,6 +113,36 @@ class tool
         log::mcrl2_logger::set_report_time_info();
         m_timing_filename = parser.option_argument("timings");
       }
+      if (parser.options.count("trace") > 0)
+      {
+        m_trace_filename = parser.option_argument("trace");
+        enable_tracing(true);
+      }
+      if (parser.options.count("memory-report") > 0)
+      {
+        m_memory_report = true;
+        const double seconds = parser.option_argument_as<double>("memory-report");
+        if (seconds > 0)
+        {
+          set_memory_report_interval(std::chrono::milliseconds(static_cast<std::int64_t>(seconds * 1000)));
+        }
+      }
+      if (parser.options.count("memory-budget") > 0)
+      {
+        set_memory_budget(parse_memory_size(parser.option_argument("memory-budget")));
+      }
+      if (parser.options.count("huge-pages") > 0)
+      {
+        set_huge_page_mode(parse_huge_page_mode(parser.option_argument("huge-pages")));
+      }
+      if (parser.options.count("numa") > 0)
+      {
+        set_numa_aware(true);
+      }
+      if (parser.options.count("compress") > 0)
+      {
+        set_bitstream_compression(true, parser.option_argument_as<std::size_t>("compress"));
+      }
     }
 
     /// \brief Executed only if run would be executed and invoked before run.
@@ -224,6 +286,29 @@ class tool
             {
               timer().report();
             }
+
+            if (tracing_enabled())
+            {
+              write_trace(m_trace_filename);
+            }
+
+            if (m_memory_report)
+            {
+              set_memory_report_interval(std::chrono::milliseconds(0));
+              write_memory_report(std::cerr);
+            }
+            else if (log::mCRL2logEnabled(log::verbose))
+            {
+              std::ostringstream report;
+              write_memory_report(report);
+              mCRL2log(log::verbose) << report.str();
+            }
+
+            if (page_allocation_enabled())
+            {
+              mCRL2log(log::verbose) << "Blocks: " << block_allocation_statistics().message() << ".\n";
+              mCRL2log(log::verbose) << "Hash tables: " << hash_table_allocation_statistics().message() << ".\n";
+            }
           }
 
           // Either pre_run or run failed.
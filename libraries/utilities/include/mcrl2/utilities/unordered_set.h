@@ -11,6 +11,7 @@
 
 #include "mcrl2/utilities/block_allocator.h"
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/page_allocator.h"
 #include "mcrl2/utilities/detail/bucket_list.h"
 
 #include <cmath>
@@ -62,8 +63,9 @@ class unordered_set
 private:
   /// \brief Combine the bucket list and a lock that locks modifications to the bucket list.
   using bucket_type = detail::bucket_list<Key, Allocator>;
-  using bucket_iterator = typename std::vector<bucket_type>::iterator;
-  using const_bucket_iterator = typename std::vector<bucket_type>::const_iterator;
+  using bucket_vector = std::vector<bucket_type, page_allocator<bucket_type>>;
+  using bucket_iterator = typename bucket_vector::iterator;
+  using const_bucket_iterator = typename bucket_vector::const_iterator;
   using mutex_type = std::mutex;
 
   template<typename Key_, typename T, typename Hash_, typename KeyEqual, typename Allocator_, bool ThreadSafe_>
@@ -80,7 +82,7 @@ public:
     template<typename Key_, typename T, typename Hash_, typename KeyEqual, typename Allocator_, bool ThreadSafe_>
     friend class unordered_map;
 
-    using bucket_it = typename std::vector<Bucket>::const_iterator;
+    using bucket_it = typename std::vector<Bucket, page_allocator<Bucket>>::const_iterator;
     using key_it_type = typename Bucket::const_iterator;
 
   public:
@@ -369,7 +371,8 @@ private:
   /// \brief Always equal to m_buckets.size() - 1.
   size_type m_buckets_mask;
 
-  std::vector<bucket_type> m_buckets;
+  /// \brief The buckets, which are allocated in (huge) pages when the table is large.
+  bucket_vector m_buckets;
   std::vector<std::mutex> m_bucket_mutexes;
 
   float m_max_load_factor = 1.0f;
@@ -9,8 +9,10 @@
 
 #include "mcrl2/utilities/bitstream.h"
 
+#include "mcrl2/utilities/block_compression.h"
 #include "mcrl2/utilities/exception.h"
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/parallel_for.h"
 #include "mcrl2/utilities/unused.h"
 #include "mcrl2/utilities/power_of_two.h"
 #include "mcrl2/utilities/platform.h"
@@ -20,8 +22,57 @@
 #include <fcntl.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+
 using namespace mcrl2::utilities;
 
+/// \brief The bytes at the start of a compressed stream. The first byte differs from that of a binary aterm stream.
+static constexpr std::array<std::uint8_t, 5> compressed_magic = { 0xFF, 'M', 'C', 'Z', 0x01 };
+
+/// \brief The number of uncompressed bytes in a block, larger blocks compress better but need more memory.
+static constexpr std::size_t compressed_block_size = 1024 * 1024;
+
+static std::atomic<bool> g_compression(false);
+static std::atomic<std::size_t> g_compression_threads(1);
+
+void mcrl2::utilities::set_bitstream_compression(bool enable, std::size_t number_of_threads)
+{
+  g_compression = enable;
+  g_compression_threads = std::max<std::size_t>(number_of_threads, 1);
+}
+
+bool mcrl2::utilities::bitstream_compression()
+{
+  return g_compression;
+}
+
+/// \brief Writes a 32 bit integer in little endian.
+static void write_uint32(std::ostream& stream, std::uint32_t value)
+{
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    stream.put(static_cast<char>((value >> (8 * i)) & 255));
+  }
+}
+
+/// \brief Reads a 32 bit integer in little endian.
+static std::uint32_t read_uint32(std::istream& stream)
+{
+  std::uint32_t value = 0;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    int byte = stream.get();
+    if (stream.eof())
+    {
+      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+    }
+    value |= static_cast<std::uint32_t>(byte & 255) << (8 * i);
+  }
+  return value;
+}
+
 /// \brief Encodes an unsigned variable-length integer using the most significant bit (MSB) algorithm.
 ///        This function assumes that the value is stored as little endian.
 /// \param value The input value. Any standard integer type is allowed.
@@ -99,7 +150,13 @@ static void set_stream_binary(const std::string& name, FILE* handle)
 }
 
 obitstream::obitstream(std::ostream& stream)
-  : stream(stream)
+  : obitstream(stream, g_compression, g_compression_threads)
+{}
+
+obitstream::obitstream(std::ostream& stream, bool compress, std::size_t number_of_threads)
+  : stream(stream),
+    m_compress(compress),
+    m_number_of_threads(std::max<std::size_t>(number_of_threads, 1))
 {
   // Ensures that the given stream is changed to binary mode.
   if (stream.rdbuf() == std::cout.rdbuf())
@@ -110,6 +167,12 @@ obitstream::obitstream(std::ostream& stream)
   {
     set_stream_binary("cerr", stderr);
   }
+
+  if (m_compress)
+  {
+    stream.write(reinterpret_cast<const char*>(compressed_magic.data()), compressed_magic.size());
+    m_block.reserve(compressed_block_size);
+  }
 }
 
 void obitstream::write_bits(std::size_t value, unsigned int number_of_bits)
@@ -128,12 +191,7 @@ void obitstream::write_bits(std::size_t value, unsigned int number_of_bits)
     for (int32_t i = 7; i >= 0; --i)
     {
       // Write the 8 * i most significant bits and mask out the other values.
-      stream.put(static_cast<char>((write_value >> (8 * i)) & 255));
-
-      if (stream.fail())
-      {
-        throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
-      }
+      put(static_cast<std::uint8_t>((write_value >> (8 * i)) & 255));
     }
   }
 }
@@ -162,6 +220,28 @@ ibitstream::ibitstream(std::istream& stream)
   {
     set_stream_binary("cin", stdin);
   }
+
+  // Detect whether the stream is compressed, the bytes that were read otherwise are returned by get() first.
+  if (stream.peek() == compressed_magic[0])
+  {
+    for (std::uint8_t expected : compressed_magic)
+    {
+      int byte = stream.get();
+      if (stream.eof())
+      {
+        return;
+      }
+
+      m_block.push_back(static_cast<std::uint8_t>(byte));
+      if (byte != expected)
+      {
+        return;
+      }
+    }
+
+    m_compressed = true;
+    m_block.clear();
+  }
 }
 
 const char* ibitstream::read_string()
@@ -192,16 +272,7 @@ std::size_t ibitstream::read_bits(unsigned int number_of_bits)
   while (bits_in_buffer < number_of_bits)
   {
     // Read bytes until the buffer is sufficiently full.
-    int byte = stream.get();
-
-    if (stream.eof())
-    {
-      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
-    }
-    else if (stream.fail())
-    {
-      throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
-    }
+    std::uint8_t byte = get();
 
     // Shift the 8 bits to the first free (120 - bits_in_buffer) position in the buffer.
     read_buffer |= std::bitset<128>(static_cast<std::size_t>(byte)) << (56 + 64 - bits_in_buffer);
@@ -231,6 +302,20 @@ void obitstream::flush()
   write_bits(0, 64 - bits_in_buffer);
   assert(bits_in_buffer == 0);
 
+  if (m_compress)
+  {
+    // Write the remaining bytes followed by an empty frame that marks the end of the stream.
+    if (!m_block.empty())
+    {
+      m_pending_blocks.emplace_back(std::move(m_block));
+      m_block.clear();
+    }
+    write_blocks();
+
+    write_uint32(stream, 0);
+    write_uint32(stream, 0);
+  }
+
   stream.flush();
   if (stream.fail())
   {
@@ -247,6 +332,130 @@ void obitstream::write(const uint8_t* buffer, std::size_t size)
   }
 }
 
+void obitstream::put(std::uint8_t byte)
+{
+  if (!m_compress)
+  {
+    stream.put(static_cast<char>(byte));
+    if (stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+    }
+    return;
+  }
+
+  m_block.push_back(byte);
+  if (m_block.size() == compressed_block_size)
+  {
+    m_pending_blocks.emplace_back(std::move(m_block));
+    m_block = std::vector<std::uint8_t>();
+    m_block.reserve(compressed_block_size);
+
+    if (m_pending_blocks.size() == m_number_of_threads)
+    {
+      write_blocks();
+    }
+  }
+}
+
+void obitstream::write_blocks()
+{
+  m_compressed_blocks.resize(m_pending_blocks.size());
+  parallel_for(m_pending_blocks.size(), m_number_of_threads, [this](std::size_t i, std::size_t)
+    {
+      compress_block(m_pending_blocks[i].data(), m_pending_blocks[i].size(), m_compressed_blocks[i]);
+    });
+
+  // Every frame consists of the uncompressed size, followed by the stored size and whether the block was compressed.
+  for (std::size_t i = 0; i < m_pending_blocks.size(); ++i)
+  {
+    const std::vector<std::uint8_t>& block = m_pending_blocks[i];
+    const std::vector<std::uint8_t>& compressed = m_compressed_blocks[i];
+
+    // Blocks that do not compress are stored as is.
+    const bool is_compressed = compressed.size() < block.size();
+    const std::vector<std::uint8_t>& stored = is_compressed ? compressed : block;
+
+    write_uint32(stream, static_cast<std::uint32_t>(block.size()));
+    write_uint32(stream, static_cast<std::uint32_t>(stored.size() << 1 | (is_compressed ? 1 : 0)));
+    stream.write(reinterpret_cast<const char*>(stored.data()), stored.size());
+
+    if (stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+    }
+  }
+
+  m_pending_blocks.clear();
+}
+
+std::uint8_t ibitstream::get()
+{
+  if (m_block_position < m_block.size())
+  {
+    return m_block[m_block_position++];
+  }
+
+  if (m_compressed)
+  {
+    read_block();
+    return m_block[m_block_position++];
+  }
+
+  int byte = stream.get();
+  if (stream.eof())
+  {
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+  }
+  else if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
+  }
+
+  return static_cast<std::uint8_t>(byte);
+}
+
+void ibitstream::read_block()
+{
+  const std::size_t size = read_uint32(stream);
+  const std::uint32_t stored = read_uint32(stream);
+  const std::size_t stored_size = stored >> 1;
+
+  if (size == 0)
+  {
+    // The empty frame marks the end of the stream.
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+  }
+  else if (size > compressed_block_size || stored_size > size)
+  {
+    throw mcrl2::runtime_error("Failed to decompress a corrupt block from the input file/stream.");
+  }
+
+  m_block.resize(size);
+  m_block_position = 0;
+
+  std::vector<std::uint8_t>& buffer = (stored & 1) ? m_compressed_block : m_block;
+  buffer.resize(stored_size);
+  stream.read(reinterpret_cast<char*>(buffer.data()), stored_size);
+  if (stream.eof())
+  {
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+  }
+  else if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
+  }
+
+  if (stored & 1)
+  {
+    decompress_block(m_compressed_block.data(), stored_size, m_block.data(), size);
+  }
+  else if (stored_size != size)
+  {
+    throw mcrl2::runtime_error("Failed to decompress a corrupt block from the input file/stream.");
+  }
+}
+
 void ibitstream::read(std::size_t size, std::uint8_t* buffer)
 {
   for (std::size_t index = 0; index < size; ++index)
@@ -0,0 +1,219 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_compression.h"
+
+#include "mcrl2/utilities/exception.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mcrl2::utilities;
+
+/// \brief The minimum length of a match, shorter matches are stored as literals.
+static constexpr std::size_t minimum_match = 4;
+
+/// \brief The maximum distance of a match, such that the offset fits in two bytes.
+static constexpr std::size_t maximum_offset = 65535;
+
+/// \brief The number of bits of the hash table that stores the last position of every four bytes.
+static constexpr std::size_t hash_bits = 16;
+
+static inline std::uint32_t read_uint32(const std::uint8_t* pointer)
+{
+  std::uint32_t value;
+  std::memcpy(&value, pointer, sizeof(value));
+  return value;
+}
+
+static inline std::size_t hash_uint32(std::uint32_t value)
+{
+  return (value * 2654435761u) >> (32 - hash_bits);
+}
+
+/// \brief Writes the part of a length that does not fit in a token.
+static void write_length(std::vector<std::uint8_t>& output, std::size_t length)
+{
+  while (length >= 255)
+  {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<std::uint8_t>(length));
+}
+
+/// \brief Writes a token with the given literals followed by a match, the match is omitted when match_length is zero.
+static void write_sequence(std::vector<std::uint8_t>& output,
+  const std::uint8_t* literals,
+  std::size_t literal_length,
+  std::size_t offset,
+  std::size_t match_length)
+{
+  const std::size_t token_position = output.size();
+  output.push_back(0);
+
+  std::uint8_t token = static_cast<std::uint8_t>(std::min<std::size_t>(literal_length, 15) << 4);
+  if (literal_length >= 15)
+  {
+    write_length(output, literal_length - 15);
+  }
+  output.insert(output.end(), literals, literals + literal_length);
+
+  if (match_length > 0)
+  {
+    output.push_back(static_cast<std::uint8_t>(offset & 255));
+    output.push_back(static_cast<std::uint8_t>(offset >> 8));
+
+    const std::size_t length = match_length - minimum_match;
+    token |= static_cast<std::uint8_t>(std::min<std::size_t>(length, 15));
+    if (length >= 15)
+    {
+      write_length(output, length - 15);
+    }
+  }
+
+  output[token_position] = token;
+}
+
+void mcrl2::utilities::compress_block(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output)
+{
+  output.clear();
+  output.reserve(size + size / 255 + 16);
+
+  // For every hash of four bytes the last position at which they occurred. Candidates are always verified, so the
+  // initial positions do not matter.
+  std::vector<std::uint32_t> table(std::size_t(1) << hash_bits, 0);
+
+  std::size_t anchor = 0; // The first byte that has not been written.
+  std::size_t position = 0;
+  while (position + minimum_match <= size)
+  {
+    const std::uint32_t value = read_uint32(input + position);
+    std::uint32_t& entry = table[hash_uint32(value)];
+    std::size_t candidate = entry;
+    entry = static_cast<std::uint32_t>(position);
+
+    if (candidate < position && position - candidate <= maximum_offset && read_uint32(input + candidate) == value)
+    {
+      std::size_t length = minimum_match;
+      while (position + length < size && input[candidate + length] == input[position + length])
+      {
+        ++length;
+      }
+
+      // Also extend the match backwards into the pending literals.
+      while (position > anchor && candidate > 0 && input[position - 1] == input[candidate - 1])
+      {
+        --position;
+        --candidate;
+        ++length;
+      }
+
+      write_sequence(output, input + anchor, position - anchor, position - candidate, length);
+      position += length;
+      anchor = position;
+    }
+    else
+    {
+      // Skip faster through data that does not compress.
+      position += 1 + ((position - anchor) >> 6);
+    }
+  }
+
+  if (anchor < size)
+  {
+    write_sequence(output, input + anchor, size - anchor, 0, 0);
+  }
+}
+
+void mcrl2::utilities::decompress_block(const std::uint8_t* input, std::size_t size, std::uint8_t* output, std::size_t output_size)
+{
+  const std::uint8_t* input_end = input + size;
+  std::uint8_t* position = output;
+  std::uint8_t* output_end = output + output_size;
+
+  auto corrupt = []()
+  {
+    throw mcrl2::runtime_error("Failed to decompress a corrupt block from the input file/stream.");
+  };
+
+  auto read_length = [&](std::size_t length)
+  {
+    if (length == 15)
+    {
+      std::uint8_t byte;
+      do
+      {
+        if (input == input_end)
+        {
+          corrupt();
+        }
+        byte = *input++;
+        length += byte;
+      }
+      while (byte == 255);
+    }
+    return length;
+  };
+
+  while (position < output_end)
+  {
+    if (input == input_end)
+    {
+      corrupt();
+    }
+    const std::uint8_t token = *input++;
+
+    const std::size_t literal_length = read_length(token >> 4);
+    if (literal_length > static_cast<std::size_t>(input_end - input) || literal_length > static_cast<std::size_t>(output_end - position))
+    {
+      corrupt();
+    }
+    std::memcpy(position, input, literal_length);
+    position += literal_length;
+    input += literal_length;
+
+    if (position == output_end)
+    {
+      break;
+    }
+
+    if (input_end - input < 2)
+    {
+      corrupt();
+    }
+    const std::size_t offset = static_cast<std::size_t>(input[0]) | (static_cast<std::size_t>(input[1]) << 8);
+    input += 2;
+
+    const std::size_t match_length = read_length(token & 15) + minimum_match;
+    if (offset == 0 || offset > static_cast<std::size_t>(position - output) || match_length > static_cast<std::size_t>(output_end - position))
+    {
+      corrupt();
+    }
+
+    const std::uint8_t* match = position - offset;
+    if (offset >= match_length)
+    {
+      std::memcpy(position, match, match_length);
+    }
+    else
+    {
+      // The match overlaps with its own output, so it repeats the last offset bytes.
+      for (std::size_t index = 0; index < match_length; ++index)
+      {
+        position[index] = match[index];
+      }
+    }
+    position += match_length;
+  }
+
+  if (input != input_end)
+  {
+    corrupt();
+  }
+}
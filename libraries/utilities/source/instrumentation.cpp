@@ -0,0 +1,336 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/instrumentation.h"
+
+#include "mcrl2/utilities/exception.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+std::atomic<bool> mcrl2::utilities::detail::g_tracing_enabled(false);
+
+/// \brief The number of spans that every thread keeps, older spans are overwritten.
+static constexpr std::size_t trace_buffer_capacity = 1 << 16;
+
+namespace
+{
+
+struct trace_event
+{
+  const char* name;
+  std::uint64_t start;
+  std::uint64_t finish;
+};
+
+struct span_total
+{
+  std::size_t calls = 0;
+  std::uint64_t duration = 0;
+};
+
+/// \brief The spans and counters recorded by a single thread.
+struct trace_buffer
+{
+  explicit trace_buffer(std::size_t number)
+    : thread_number(number)
+  {}
+
+  std::size_t thread_number;
+  std::vector<trace_event> events; ///< A ring buffer, of which events[recorded % capacity] is the oldest span when full.
+  std::size_t recorded = 0;
+  std::unordered_map<const char*, span_total> totals;
+  std::vector<std::size_t> counters;
+
+  void clear()
+  {
+    events.clear();
+    recorded = 0;
+    totals.clear();
+    std::fill(counters.begin(), counters.end(), 0);
+  }
+};
+
+/// \brief The buffers of all threads, which are kept after a thread has finished.
+struct trace_registry
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<trace_buffer>> buffers;
+  std::vector<const char*> counter_names;
+  std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+trace_registry& registry()
+{
+  static trace_registry result;
+  return result;
+}
+
+trace_buffer& local_buffer()
+{
+  thread_local std::shared_ptr<trace_buffer> buffer = []()
+  {
+    trace_registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    r.buffers.push_back(std::make_shared<trace_buffer>(r.buffers.size()));
+    return r.buffers.back();
+  }();
+  return *buffer;
+}
+
+/// \brief Writes the string with the characters escaped that are not allowed in a JSON string.
+void write_json_string(std::ostream& out, const char* text)
+{
+  out << '"';
+  for (const char* c = text; *c != '\0'; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      out << '\\' << *c;
+    }
+    else if (static_cast<unsigned char>(*c) < 0x20)
+    {
+      out << ' ';
+    }
+    else
+    {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+/// \brief Sums the spans and counters of all threads, sorted by name.
+void collect_totals(std::map<std::string, span_total>& spans, std::map<std::string, std::size_t>& counters)
+{
+  trace_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  for (const char* name : r.counter_names)
+  {
+    counters[name] = 0;
+  }
+
+  for (const auto& buffer : r.buffers)
+  {
+    for (const auto& [name, total] : buffer->totals)
+    {
+      span_total& result = spans[name];
+      result.calls += total.calls;
+      result.duration += total.duration;
+    }
+
+    for (std::size_t id = 0; id < buffer->counters.size(); ++id)
+    {
+      counters[r.counter_names[id]] += buffer->counters[id];
+    }
+  }
+}
+
+} // namespace
+
+std::uint64_t mcrl2::utilities::detail::trace_clock()
+{
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - registry().epoch).count());
+}
+
+void mcrl2::utilities::detail::record_span(const char* name, std::uint64_t start, std::uint64_t finish)
+{
+  trace_buffer& buffer = local_buffer();
+
+  span_total& total = buffer.totals[name];
+  ++total.calls;
+  total.duration += finish - start;
+
+  if (buffer.events.size() < trace_buffer_capacity)
+  {
+    buffer.events.push_back(trace_event{name, start, finish});
+  }
+  else
+  {
+    buffer.events[buffer.recorded % trace_buffer_capacity] = trace_event{name, start, finish};
+  }
+  ++buffer.recorded;
+}
+
+void mcrl2::utilities::detail::add_to_counter(std::size_t id, std::size_t value)
+{
+  trace_buffer& buffer = local_buffer();
+  if (id >= buffer.counters.size())
+  {
+    buffer.counters.resize(id + 1, 0);
+  }
+  buffer.counters[id] += value;
+}
+
+void mcrl2::utilities::enable_tracing(bool enable)
+{
+  if (enable)
+  {
+    trace_registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    for (const auto& buffer : r.buffers)
+    {
+      buffer->clear();
+    }
+    r.epoch = std::chrono::steady_clock::now();
+  }
+
+  detail::g_tracing_enabled.store(enable);
+}
+
+trace_counter::trace_counter(const char* name)
+{
+  trace_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  m_id = r.counter_names.size();
+  r.counter_names.push_back(name);
+}
+
+std::size_t trace_counter::total() const
+{
+  trace_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  std::size_t result = 0;
+  for (const auto& buffer : r.buffers)
+  {
+    if (m_id < buffer->counters.size())
+    {
+      result += buffer->counters[m_id];
+    }
+  }
+  return result;
+}
+
+void mcrl2::utilities::write_trace_summary(std::ostream& out)
+{
+  std::map<std::string, span_total> spans;
+  std::map<std::string, std::size_t> counters;
+  collect_totals(spans, counters);
+
+  std::size_t width = 20;
+  for (const auto& [name, total] : spans)
+  {
+    width = std::max(width, name.size() + 2);
+  }
+  for (const auto& [name, total] : counters)
+  {
+    width = std::max(width, name.size() + 2);
+  }
+
+  std::ios::fmtflags oldflags = out.setf(std::ios::fixed, std::ios::floatfield);
+  std::streamsize oldprecision = out.precision(3);
+
+  out << std::left << std::setw(static_cast<int>(width)) << "span" << std::right
+      << std::setw(14) << "calls" << std::setw(14) << "total (s)" << std::setw(14) << "mean (us)" << "\n";
+  for (const auto& [name, total] : spans)
+  {
+    out << std::left << std::setw(static_cast<int>(width)) << name << std::right
+        << std::setw(14) << total.calls
+        << std::setw(14) << static_cast<double>(total.duration) / 1e9
+        << std::setw(14) << static_cast<double>(total.duration) / 1e3 / static_cast<double>(total.calls) << "\n";
+  }
+
+  out << std::left << std::setw(static_cast<int>(width)) << "counter" << std::right << std::setw(14) << "total" << "\n";
+  for (const auto& [name, total] : counters)
+  {
+    out << std::left << std::setw(static_cast<int>(width)) << name << std::right << std::setw(14) << total << "\n";
+  }
+
+  out.flags(oldflags);
+  out.precision(oldprecision);
+}
+
+void mcrl2::utilities::write_chrome_trace(std::ostream& out)
+{
+  trace_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+
+  std::ios::fmtflags oldflags = out.setf(std::ios::fixed, std::ios::floatfield);
+  std::streamsize oldprecision = out.precision(3);
+
+  // Timestamps and durations are given in microseconds.
+  out << "{\"traceEvents\":[\n";
+  bool first = true;
+  auto separator = [&]()
+  {
+    out << (first ? "" : ",\n");
+    first = false;
+  };
+
+  std::uint64_t end = 0;
+  std::vector<std::size_t> counters(r.counter_names.size(), 0);
+  for (const auto& buffer : r.buffers)
+  {
+    separator();
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_number
+        << ",\"args\":{\"name\":\"thread " << buffer->thread_number << "\"}}";
+
+    // Write the spans from the oldest to the most recent one.
+    const std::size_t size = buffer->events.size();
+    const std::size_t oldest = buffer->recorded > size ? buffer->recorded % size : 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      const trace_event& event = buffer->events[(oldest + i) % size];
+      separator();
+      out << "{\"name\":";
+      write_json_string(out, event.name);
+      out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_number
+          << ",\"ts\":" << static_cast<double>(event.start) / 1e3
+          << ",\"dur\":" << static_cast<double>(event.finish - event.start) / 1e3 << "}";
+      end = std::max(end, event.finish);
+    }
+
+    for (std::size_t id = 0; id < buffer->counters.size(); ++id)
+    {
+      counters[id] += buffer->counters[id];
+    }
+  }
+
+  // The counters are only known in total, so they are reported once at the end of the trace.
+  for (std::size_t id = 0; id < counters.size(); ++id)
+  {
+    separator();
+    out << "{\"name\":";
+    write_json_string(out, r.counter_names[id]);
+    out << ",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << static_cast<double>(end) / 1e3
+        << ",\"args\":{\"total\":" << counters[id] << "}}";
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  out.flags(oldflags);
+  out.precision(oldprecision);
+}
+
+void mcrl2::utilities::write_trace(const std::string& filename)
+{
+  if (filename.empty())
+  {
+    write_trace_summary(std::cerr);
+    return;
+  }
+
+  std::ofstream out(filename);
+  if (!out)
+  {
+    throw mcrl2::runtime_error("Could not open file " + filename + " to write the trace.");
+  }
+  write_chrome_trace(out);
+}
@@ -0,0 +1,336 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/memory_accounting.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <array>
+#include <cctype>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+  #include <sys/resource.h>
+  #include <unistd.h>
+#endif
+
+using namespace mcrl2::utilities;
+
+std::atomic<bool> mcrl2::utilities::detail::g_memory_budget_exceeded = false;
+
+namespace
+{
+
+/// \brief Checks the resident memory against the budget and writes the periodic reports in a background thread.
+class memory_monitor
+{
+public:
+  ~memory_monitor()
+  {
+    stop();
+  }
+
+  /// \brief Changes the budget or the report interval, where zero disables either, and restarts the thread.
+  void configure(std::size_t budget, std::chrono::milliseconds interval)
+  {
+    stop();
+    m_budget = budget;
+    m_interval = interval;
+    if (m_budget != 0 || m_interval.count() != 0)
+    {
+      m_stop = false;
+      m_thread = std::thread([this]() { run(); });
+    }
+  }
+
+  std::size_t budget() const { return m_budget; }
+  std::chrono::milliseconds interval() const { return m_interval; }
+
+  /// \returns A one line description of the memory in use by the subsystems and the process.
+  static std::string summary()
+  {
+    std::stringstream str;
+    for (std::size_t i = 0; i < number_of_memory_subsystems; ++i)
+    {
+      const memory_subsystem subsystem = static_cast<memory_subsystem>(i);
+      if (memory_statistics(subsystem).bytes() != 0)
+      {
+        str << to_string(subsystem) << " " << format_bytes(memory_statistics(subsystem).bytes()) << ", ";
+      }
+    }
+
+    str << "total " << format_bytes(memory_statistics().bytes());
+    if (resident_memory() != 0)
+    {
+      str << ", resident " << format_bytes(resident_memory());
+    }
+    return str.str();
+  }
+
+private:
+  void stop()
+  {
+    if (m_thread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+      }
+      m_condition.notify_all();
+      m_thread.join();
+    }
+  }
+
+  void run()
+  {
+    const std::chrono::milliseconds poll(100);
+    auto next_report = std::chrono::steady_clock::now() + m_interval;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+      std::chrono::steady_clock::time_point wake_up = next_report;
+      if (m_budget != 0 && (m_interval.count() == 0 || std::chrono::steady_clock::now() + poll < next_report))
+      {
+        wake_up = std::chrono::steady_clock::now() + poll;
+      }
+
+      if (m_condition.wait_until(lock, wake_up, [this]() { return m_stop; }))
+      {
+        break;
+      }
+
+      if (m_budget != 0 && resident_memory() > m_budget)
+      {
+        detail::g_memory_budget_exceeded.store(true, std::memory_order_relaxed);
+      }
+
+      if (m_interval.count() != 0 && std::chrono::steady_clock::now() >= next_report)
+      {
+        std::cerr << "memory: " << summary() << std::endl;
+        next_report += m_interval;
+      }
+    }
+  }
+
+  std::size_t m_budget = 0;
+  std::chrono::milliseconds m_interval{0};
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stop = false;
+};
+
+memory_monitor& monitor()
+{
+  static memory_monitor monitor;
+  return monitor;
+}
+
+} // namespace
+
+const char* mcrl2::utilities::to_string(memory_subsystem subsystem)
+{
+  switch (subsystem)
+  {
+    case memory_subsystem::terms: return "terms";
+    case memory_subsystem::blocks: return "blocks";
+    case memory_subsystem::hash_tables: return "hash tables";
+    case memory_subsystem::explorer: return "explorer";
+    case memory_subsystem::lts: return "lts";
+    case memory_subsystem::structure_graph: return "structure graph";
+    case memory_subsystem::enumerator: return "enumerator";
+  }
+
+  return "unknown";
+}
+
+allocation_statistics& mcrl2::utilities::memory_statistics()
+{
+  static allocation_statistics* statistics = new allocation_statistics();
+  return *statistics;
+}
+
+allocation_statistics& mcrl2::utilities::memory_statistics(memory_subsystem subsystem)
+{
+  // These are never destroyed, because global objects can free their memory during program termination.
+  static const std::array<allocation_statistics*, number_of_memory_subsystems> statistics = []()
+  {
+    std::array<allocation_statistics*, number_of_memory_subsystems> result;
+    for (allocation_statistics*& element : result)
+    {
+      element = new allocation_statistics(&memory_statistics());
+    }
+    return result;
+  }();
+
+  return *statistics[static_cast<std::size_t>(subsystem)];
+}
+
+std::size_t mcrl2::utilities::resident_memory()
+{
+#ifdef MCRL2_PLATFORM_LINUX
+  // The second field is the number of resident pages.
+  std::ifstream file("/proc/self/statm");
+  std::size_t size = 0;
+  std::size_t resident = 0;
+  if (file >> size >> resident)
+  {
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+
+  return 0;
+}
+
+std::size_t mcrl2::utilities::peak_resident_memory()
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef MCRL2_PLATFORM_MAC
+    // The maximum resident set size is reported in bytes on macOS and in kilobytes elsewhere.
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+
+  return 0;
+}
+
+std::string mcrl2::utilities::format_bytes(std::size_t bytes)
+{
+  std::stringstream str;
+  const char* units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+  double value = static_cast<double>(bytes);
+  std::size_t unit = 0;
+  while (value >= 1024.0 && unit + 1 < sizeof(units) / sizeof(units[0]))
+  {
+    value /= 1024.0;
+    ++unit;
+  }
+
+  str << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << value << " " << units[unit];
+  return str.str();
+}
+
+std::size_t mcrl2::utilities::parse_memory_size(const std::string& text)
+{
+  std::size_t end = 0;
+  double value = 0;
+  try
+  {
+    value = std::stod(text, &end);
+  }
+  catch (const std::exception&)
+  {
+    throw mcrl2::runtime_error("invalid memory size '" + text + "', expected a number with an optional suffix K, M, G or T");
+  }
+
+  std::string suffix = text.substr(end);
+  if (!suffix.empty() && std::toupper(suffix.back()) == 'B')
+  {
+    // Accept for example both 4G and 4GB.
+    suffix.pop_back();
+  }
+
+  double factor = 1.0;
+  if (suffix.size() == 1)
+  {
+    const std::string units = "KMGT";
+    std::size_t position = units.find(static_cast<char>(std::toupper(suffix[0])));
+    if (position == std::string::npos)
+    {
+      throw mcrl2::runtime_error("invalid memory size '" + text + "', expected a number with an optional suffix K, M, G or T");
+    }
+
+    for (std::size_t i = 0; i <= position; ++i)
+    {
+      factor *= 1024.0;
+    }
+  }
+  else if (!suffix.empty())
+  {
+    throw mcrl2::runtime_error("invalid memory size '" + text + "', expected a number with an optional suffix K, M, G or T");
+  }
+
+  if (value < 0 || value * factor >= static_cast<double>(std::numeric_limits<std::size_t>::max()))
+  {
+    throw mcrl2::runtime_error("invalid memory size '" + text + "'");
+  }
+  return static_cast<std::size_t>(value * factor);
+}
+
+void mcrl2::utilities::set_memory_budget(std::size_t bytes)
+{
+  detail::g_memory_budget_exceeded.store(false, std::memory_order_relaxed);
+  memory_statistics().set_limit(bytes == 0 ? std::numeric_limits<std::size_t>::max() : bytes);
+  monitor().configure(bytes, monitor().interval());
+}
+
+std::size_t mcrl2::utilities::memory_budget()
+{
+  return monitor().budget();
+}
+
+void mcrl2::utilities::check_memory_budget()
+{
+  if (memory_budget_exceeded())
+  {
+    throw mcrl2::runtime_error("the memory budget of " + format_bytes(memory_budget()) + " has been exceeded; "
+                               + memory_monitor::summary() + ".");
+  }
+}
+
+void mcrl2::utilities::write_memory_report(std::ostream& out)
+{
+  const int width = 20;
+  out << std::left << std::setw(width) << "memory" << std::right << std::setw(14) << "allocations"
+      << std::setw(14) << "in use" << std::setw(14) << "peak" << "\n";
+
+  auto write_row = [&](const std::string& name, const allocation_statistics& statistics)
+  {
+    out << std::left << std::setw(width) << name << std::right << std::setw(14) << statistics.allocations()
+        << std::setw(14) << format_bytes(statistics.bytes()) << std::setw(14) << format_bytes(statistics.peak_bytes()) << "\n";
+  };
+
+  for (std::size_t i = 0; i < number_of_memory_subsystems; ++i)
+  {
+    const memory_subsystem subsystem = static_cast<memory_subsystem>(i);
+    write_row(to_string(subsystem), memory_statistics(subsystem));
+  }
+  write_row("total", memory_statistics());
+
+  if (peak_resident_memory() != 0)
+  {
+    out << std::left << std::setw(width) << "resident" << std::right << std::setw(14) << ""
+        << std::setw(14) << (resident_memory() != 0 ? format_bytes(resident_memory()) : "")
+        << std::setw(14) << format_bytes(peak_resident_memory()) << "\n";
+  }
+  if (memory_budget() != 0)
+  {
+    out << std::left << std::setw(width) << "budget" << std::right << std::setw(14) << ""
+        << std::setw(14) << format_bytes(memory_budget()) << "\n";
+  }
+}
+
+void mcrl2::utilities::set_memory_report_interval(std::chrono::milliseconds interval)
+{
+  monitor().configure(monitor().budget(), interval);
+}
@@ -0,0 +1,461 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/page_allocator.h"
+#include "mcrl2/utilities/memory_accounting.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/platform.h"
+#include "mcrl2/utilities/unused.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef MCRL2_PLATFORM_WINDOWS
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+#endif
+
+#ifdef MCRL2_PLATFORM_LINUX
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+using namespace mcrl2::utilities;
+
+namespace
+{
+
+std::atomic<huge_page_mode> g_huge_page_mode = huge_page_mode::none;
+std::atomic<bool> g_numa_aware = false;
+
+/// \brief The properties of a region returned by allocate_pages.
+struct region
+{
+  std::size_t length;
+  bool huge_pages;
+  bool numa;
+};
+
+/// \brief All regions returned by allocate_pages, these are few as they are large.
+/// \details These are never destroyed, because global objects can free their regions during program termination.
+std::mutex& regions_mutex()
+{
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+std::unordered_map<void*, region>& regions()
+{
+  static std::unordered_map<void*, region>* regions = new std::unordered_map<void*, region>();
+  return *regions;
+}
+
+#ifdef MCRL2_PLATFORM_LINUX
+
+// The memory policies of mbind(2), defined here to avoid a dependency on libnuma.
+constexpr int MPOL_PREFERRED_ = 1;
+constexpr int MPOL_INTERLEAVE_ = 3;
+
+constexpr std::size_t bits_per_mask = 8 * sizeof(unsigned long);
+
+/// \returns A node mask with the online NUMA nodes, which is empty when there is only a single node.
+const std::vector<unsigned long>& online_numa_nodes()
+{
+  static const std::vector<unsigned long> nodes = []()
+  {
+    // The file contains a list of ranges, for example 0-1,4.
+    std::vector<unsigned long> mask;
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string ranges;
+    std::size_t number_of_nodes = 0;
+    if (file >> ranges)
+    {
+      std::stringstream stream(ranges);
+      std::string range;
+      while (std::getline(stream, range, ','))
+      {
+        std::size_t separator = range.find('-');
+        std::size_t first = std::stoul(range.substr(0, separator));
+        std::size_t last = separator == std::string::npos ? first : std::stoul(range.substr(separator + 1));
+        for (std::size_t node = first; node <= last; ++node)
+        {
+          mask.resize(std::max(mask.size(), node / bits_per_mask + 1), 0);
+          mask[node / bits_per_mask] |= 1ul << (node % bits_per_mask);
+          ++number_of_nodes;
+        }
+      }
+    }
+
+    return number_of_nodes > 1 ? mask : std::vector<unsigned long>();
+  }();
+
+  return nodes;
+}
+
+/// \brief Sets the NUMA policy of the given (untouched) region.
+/// \returns True iff the policy was applied.
+bool bind_pages(void* pointer, std::size_t length, numa_placement placement)
+{
+  const std::vector<unsigned long>& nodes = online_numa_nodes();
+  if (nodes.empty())
+  {
+    return false;
+  }
+
+  std::vector<unsigned long> mask(nodes.size(), 0);
+  int policy = MPOL_INTERLEAVE_;
+  if (placement == numa_placement::interleaved)
+  {
+    mask = nodes;
+  }
+  else
+  {
+    std::size_t node = detail::current_numa_node();
+    if (node / bits_per_mask >= mask.size())
+    {
+      return false;
+    }
+
+    mask[node / bits_per_mask] |= 1ul << (node % bits_per_mask);
+    policy = MPOL_PREFERRED_;
+  }
+
+  return syscall(SYS_mbind, pointer, length, policy, mask.data(), mask.size() * bits_per_mask + 1, 0) == 0;
+}
+
+#endif // MCRL2_PLATFORM_LINUX
+
+} // namespace
+
+huge_page_mode mcrl2::utilities::parse_huge_page_mode(const std::string& text)
+{
+  if (text == "none")
+  {
+    return huge_page_mode::none;
+  }
+  else if (text == "transparent")
+  {
+    return huge_page_mode::transparent;
+  }
+  else if (text == "explicit")
+  {
+    return huge_page_mode::explicit_;
+  }
+
+  throw mcrl2::runtime_error("unknown huge page mode '" + text + "', expected none, transparent or explicit");
+}
+
+std::ostream& mcrl2::utilities::operator<<(std::ostream& os, huge_page_mode mode)
+{
+  switch (mode)
+  {
+    case huge_page_mode::none: return os << "none";
+    case huge_page_mode::transparent: return os << "transparent";
+    case huge_page_mode::explicit_: return os << "explicit";
+  }
+
+  return os;
+}
+
+void mcrl2::utilities::set_huge_page_mode(huge_page_mode mode)
+{
+  g_huge_page_mode.store(mode, std::memory_order_relaxed);
+}
+
+huge_page_mode mcrl2::utilities::get_huge_page_mode()
+{
+  return g_huge_page_mode.load(std::memory_order_relaxed);
+}
+
+void mcrl2::utilities::set_numa_aware(bool enable)
+{
+  g_numa_aware.store(enable, std::memory_order_relaxed);
+}
+
+bool mcrl2::utilities::numa_aware()
+{
+  return g_numa_aware.load(std::memory_order_relaxed);
+}
+
+void allocation_statistics::allocate(std::size_t bytes)
+{
+  m_allocations.fetch_add(1, std::memory_order_relaxed);
+  std::size_t current = m_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+  std::size_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+  while (current > peak && !m_peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+  {}
+
+  if (current > m_limit.load(std::memory_order_relaxed))
+  {
+    detail::g_memory_budget_exceeded.store(true, std::memory_order_relaxed);
+  }
+
+  if (m_parent != nullptr)
+  {
+    m_parent->allocate(bytes);
+  }
+}
+
+void allocation_statistics::deallocate(std::size_t bytes)
+{
+  m_allocations.fetch_sub(1, std::memory_order_relaxed);
+  m_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+
+  if (m_parent != nullptr)
+  {
+    m_parent->deallocate(bytes);
+  }
+}
+
+void allocation_statistics::map(std::size_t bytes, bool huge_pages, bool numa)
+{
+  m_mapped_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  m_huge_page_bytes.fetch_add(huge_pages ? bytes : 0, std::memory_order_relaxed);
+  m_numa_bytes.fetch_add(numa ? bytes : 0, std::memory_order_relaxed);
+
+  if (m_parent != nullptr)
+  {
+    m_parent->map(bytes, huge_pages, numa);
+  }
+}
+
+void allocation_statistics::unmap(std::size_t bytes, bool huge_pages, bool numa)
+{
+  m_mapped_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  m_huge_page_bytes.fetch_sub(huge_pages ? bytes : 0, std::memory_order_relaxed);
+  m_numa_bytes.fetch_sub(numa ? bytes : 0, std::memory_order_relaxed);
+
+  if (m_parent != nullptr)
+  {
+    m_parent->unmap(bytes, huge_pages, numa);
+  }
+}
+
+std::string allocation_statistics::message() const
+{
+  std::stringstream str;
+  str << allocations() << " allocations of " << format_bytes(bytes()) << " (peak " << format_bytes(peak_bytes()) << "), "
+      << format_bytes(mapped_bytes()) << " in pages of which " << format_bytes(huge_page_bytes()) << " huge pages and "
+      << format_bytes(numa_bytes()) << " NUMA placed";
+  return str.str();
+}
+
+allocation_statistics& mcrl2::utilities::block_allocation_statistics()
+{
+  return memory_statistics(memory_subsystem::blocks);
+}
+
+allocation_statistics& mcrl2::utilities::hash_table_allocation_statistics()
+{
+  return memory_statistics(memory_subsystem::hash_tables);
+}
+
+void* mcrl2::utilities::allocate_pages(std::size_t size, numa_placement placement, allocation_statistics& statistics)
+{
+  const std::size_t length = (std::max<std::size_t>(size, 1) + huge_page_size - 1) / huge_page_size * huge_page_size;
+  const huge_page_mode mode = get_huge_page_mode();
+
+  void* pointer = nullptr;
+  bool huge_pages = false;
+  bool numa = false;
+
+#ifdef MCRL2_PLATFORM_WINDOWS
+  // Large pages require a privilege that is normally not granted, so only the default pages are used.
+  mcrl2_unused(mode, placement);
+  pointer = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+#else
+#ifdef MAP_HUGETLB
+  if (mode == huge_page_mode::explicit_)
+  {
+    pointer = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (pointer == MAP_FAILED)
+    {
+      // No reserved huge pages are available.
+      pointer = nullptr;
+    }
+    else
+    {
+      huge_pages = true;
+    }
+  }
+#endif
+
+  if (pointer == nullptr)
+  {
+    // Map an additional huge page such that the region can be aligned to a huge page.
+    void* mapping = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(mapping);
+    const std::uintptr_t aligned = (begin + huge_page_size - 1) & ~(huge_page_size - 1);
+    if (aligned != begin)
+    {
+      munmap(mapping, aligned - begin);
+    }
+    munmap(reinterpret_cast<void*>(aligned + length), huge_page_size - (aligned - begin));
+    pointer = reinterpret_cast<void*>(aligned);
+
+#ifdef MADV_HUGEPAGE
+    if (mode != huge_page_mode::none)
+    {
+      huge_pages = madvise(pointer, length, MADV_HUGEPAGE) == 0;
+    }
+#endif
+  }
+
+#ifdef MCRL2_PLATFORM_LINUX
+  if (numa_aware())
+  {
+    // The policy must be set before the pages are touched.
+    numa = bind_pages(pointer, length, placement);
+  }
+#else
+  mcrl2_unused(placement);
+#endif
+#endif // MCRL2_PLATFORM_WINDOWS
+
+  {
+    std::lock_guard<std::mutex> guard(regions_mutex());
+    regions().emplace(pointer, region{length, huge_pages, numa});
+  }
+
+  statistics.map(length, huge_pages, numa);
+  return pointer;
+}
+
+bool mcrl2::utilities::deallocate_pages(void* pointer, allocation_statistics& statistics)
+{
+  region info;
+  {
+    std::lock_guard<std::mutex> guard(regions_mutex());
+    auto it = regions().find(pointer);
+    if (it == regions().end())
+    {
+      return false;
+    }
+
+    info = it->second;
+    regions().erase(it);
+  }
+
+#ifdef MCRL2_PLATFORM_WINDOWS
+  VirtualFree(pointer, 0, MEM_RELEASE);
+#else
+  munmap(pointer, info.length);
+#endif
+
+  statistics.unmap(info.length, info.huge_pages, info.numa);
+  return true;
+}
+
+std::size_t mcrl2::utilities::detail::current_numa_node()
+{
+#if defined(MCRL2_PLATFORM_LINUX) && defined(SYS_getcpu)
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+  {
+    return node;
+  }
+#endif
+
+  return 0;
+}
+
+detail::page_arena::~page_arena()
+{
+  for (const auto& [address, chunk] : m_chunks)
+  {
+    deallocate_pages(reinterpret_cast<void*>(address), m_statistics);
+  }
+}
+
+void* detail::page_arena::allocate(std::size_t size)
+{
+  // Align the allocations within a chunk to cache lines.
+  size = (size + 63) & ~static_cast<std::size_t>(63);
+  m_statistics.allocate(size);
+
+  if (!page_allocation_enabled())
+  {
+    return ::operator new(size);
+  }
+
+  if (size > huge_page_size / 2)
+  {
+    return allocate_pages(size, numa_placement::local, m_statistics);
+  }
+
+  const std::size_t node = numa_aware() ? current_numa_node() : 0;
+  if (node >= m_current.size())
+  {
+    m_current.resize(node + 1, 0);
+  }
+
+  auto it = m_chunks.find(m_current[node]);
+  if (it == m_chunks.end() || it->second.offset + size > huge_page_size)
+  {
+    // The chunk is full and stays allocated until all its allocations are freed.
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(allocate_pages(huge_page_size, numa_placement::local, m_statistics));
+    it = m_chunks.emplace(address, chunk()).first;
+    m_current[node] = address;
+  }
+
+  chunk& current = it->second;
+  void* result = reinterpret_cast<void*>(it->first + current.offset);
+  current.offset += size;
+  ++current.live;
+  return result;
+}
+
+void detail::page_arena::deallocate(void* pointer, std::size_t size)
+{
+  size = (size + 63) & ~static_cast<std::size_t>(63);
+  m_statistics.deallocate(size);
+
+  // Find the chunk that could contain this pointer.
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+  auto it = m_chunks.upper_bound(address);
+  if (it != m_chunks.begin() && address < (--it)->first + huge_page_size)
+  {
+    chunk& current = it->second;
+    if (--current.live == 0)
+    {
+      if (std::find(m_current.begin(), m_current.end(), it->first) != m_current.end())
+      {
+        // Allocations can be served from the start of the chunk again.
+        current.offset = 0;
+      }
+      else
+      {
+        deallocate_pages(reinterpret_cast<void*>(it->first), m_statistics);
+        m_chunks.erase(it);
+      }
+    }
+
+    return;
+  }
+
+  if (size <= huge_page_size / 2 || !deallocate_pages(pointer, m_statistics))
+  {
+    ::operator delete(pointer);
+  }
+}
@@ -8,10 +8,14 @@
 //
 
 #include "mcrl2/utilities/bitstream.h"
+#include "mcrl2/utilities/block_compression.h"
+#include "mcrl2/utilities/exception.h"
 
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
 
+#include <random>
+
 using namespace mcrl2::utilities;
 
 BOOST_AUTO_TEST_CASE(fixed_sequence_test)
@@ -43,3 +47,127 @@ BOOST_AUTO_TEST_CASE(fixed_sequence_test)
   BOOST_CHECK_EQUAL(strcmp(output.read_string(), "function_symbol"), 0);
   BOOST_CHECK_EQUAL(output.read_integer(), 5);
 }
+
+BOOST_AUTO_TEST_CASE(block_compression_test)
+{
+  std::mt19937 generator(42);
+
+  // Random data, a repeated byte, a short repeating pattern and data with a small alphabet.
+  for (std::size_t kind = 0; kind < 4; ++kind)
+  {
+    for (std::size_t size : { 0, 1, 4, 15, 16, 300, 70000, 1024 * 1024 })
+    {
+      std::vector<std::uint8_t> input(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        switch (kind)
+        {
+          case 0: input[i] = static_cast<std::uint8_t>(generator()); break;
+          case 1: input[i] = 7; break;
+          case 2: input[i] = static_cast<std::uint8_t>(i % 13); break;
+          default: input[i] = static_cast<std::uint8_t>(generator() % 4); break;
+        }
+      }
+
+      std::vector<std::uint8_t> compressed;
+      compress_block(input.data(), input.size(), compressed);
+
+      std::vector<std::uint8_t> output(size);
+      decompress_block(compressed.data(), compressed.size(), output.data(), output.size());
+      BOOST_CHECK(input == output);
+
+      if (kind == 1 && size >= 70000)
+      {
+        BOOST_CHECK(compressed.size() < size / 100);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(corrupt_block_test)
+{
+  std::vector<std::uint8_t> input(1000, 3);
+  std::vector<std::uint8_t> compressed;
+  compress_block(input.data(), input.size(), compressed);
+
+  std::vector<std::uint8_t> output(input.size());
+  BOOST_CHECK_THROW(decompress_block(compressed.data(), compressed.size() - 1, output.data(), output.size()), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(decompress_block(compressed.data(), compressed.size(), output.data(), output.size() - 1), mcrl2::runtime_error);
+}
+
+/// \brief Writes a number of values that spans multiple blocks and checks that they are read back.
+static void compressed_sequence_test(std::size_t number_of_threads)
+{
+  std::stringstream stream;
+  const std::size_t number_of_values = 1000000;
+
+  {
+    obitstream output(stream, true, number_of_threads);
+    for (std::size_t i = 0; i < number_of_values; ++i)
+    {
+      output.write_integer(i * i);
+      output.write_bits(i % 8, 3);
+    }
+    output.write_string("last");
+  }
+
+  // The compressed stream is recognised automatically.
+  ibitstream input(stream);
+  for (std::size_t i = 0; i < number_of_values; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(input.read_integer(), i * i);
+    BOOST_REQUIRE_EQUAL(input.read_bits(3), i % 8);
+  }
+  BOOST_CHECK_EQUAL(strcmp(input.read_string(), "last"), 0);
+
+  // The end of the compressed stream is detected after the (at most eight) bytes that align the last bits.
+  BOOST_CHECK_THROW(
+    for (std::size_t i = 0; i < 9; ++i) { input.read_bits(8); },
+    mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_sequence_single_thread_test)
+{
+  compressed_sequence_test(1);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_sequence_parallel_test)
+{
+  compressed_sequence_test(4);
+}
+
+BOOST_AUTO_TEST_CASE(default_compression_test)
+{
+  std::stringstream stream;
+
+  set_bitstream_compression(true, 2);
+  {
+    obitstream output(stream);
+    output.write_string("compressed");
+  }
+  set_bitstream_compression(false);
+
+  BOOST_CHECK_EQUAL(stream.str()[0], '\xFF');
+
+  ibitstream input(stream);
+  BOOST_CHECK_EQUAL(strcmp(input.read_string(), "compressed"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(uncompressed_magic_prefix_test)
+{
+  // An uncompressed stream that starts like a compressed one is read correctly.
+  std::stringstream stream;
+  {
+    obitstream output(stream, false);
+    output.write_bits(0xFF, 8);
+    output.write_bits('M', 8);
+    output.write_bits('C', 8);
+    output.write_integer(12345);
+  }
+
+  ibitstream input(stream);
+  BOOST_CHECK_EQUAL(input.read_bits(8), 0xFF);
+  BOOST_CHECK_EQUAL(input.read_bits(8), 'M');
+  BOOST_CHECK_EQUAL(input.read_bits(8), 'C');
+  BOOST_CHECK_EQUAL(input.read_integer(), 12345);
+}
@@ -0,0 +1,124 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/concurrent_indexed_set.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <string>
+#include <thread>
+
+using namespace mcrl2::utilities;
+
+BOOST_AUTO_TEST_CASE(basic_test_concurrent_indexed_set)
+{
+  concurrent_indexed_set<std::string> set(1, 4);
+  BOOST_CHECK(set.empty());
+
+  BOOST_CHECK(set.insert("a") == std::make_pair(std::size_t(0), true));
+  BOOST_CHECK(set.insert("b") == std::make_pair(std::size_t(1), true));
+  BOOST_CHECK(set.insert("a") == std::make_pair(std::size_t(0), false));
+  BOOST_CHECK_EQUAL(set.size(), 2u);
+
+  BOOST_CHECK_EQUAL(set.index("b"), 1u);
+  BOOST_CHECK_EQUAL(set.index("c"), concurrent_indexed_set<std::string>::npos);
+  BOOST_CHECK_EQUAL(set.at(0), "a");
+  BOOST_CHECK_EQUAL(set[1], "b");
+  BOOST_CHECK_THROW(set.at(2), std::out_of_range);
+
+  std::vector<std::string> keys(set.begin(), set.end());
+  BOOST_CHECK(keys == std::vector<std::string>({"a", "b"}));
+
+  set.clear();
+  BOOST_CHECK(set.empty());
+  BOOST_CHECK_EQUAL(set.index("a"), concurrent_indexed_set<std::string>::npos);
+  BOOST_CHECK_EQUAL(set.insert("c").first, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_resize)
+{
+  // Keys remain at the same address while the hash table is resized and new segments are allocated.
+  concurrent_indexed_set<std::size_t> set;
+  const std::size_t* first = &set[set.insert(42).first];
+
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    set.insert(i * 7);
+  }
+
+  BOOST_CHECK_EQUAL(first, &set[0]);
+  BOOST_CHECK_EQUAL(set.size(), 100000u);
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    BOOST_CHECK_EQUAL(set[set.index(i * 7)], i * 7);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_insert)
+{
+  // All threads insert the same keys in a different order, every key obtains exactly one index and the indices have no holes.
+  const std::size_t number_of_threads = 4;
+  const std::size_t number_of_keys = 50000;
+  concurrent_indexed_set<std::size_t> set(number_of_threads, 16);
+
+  std::vector<std::vector<std::size_t>> indices(number_of_threads, std::vector<std::size_t>(number_of_keys));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([&, t]()
+      {
+        for (std::size_t i = 0; i < number_of_keys; ++i)
+        {
+          const std::size_t key = (t % 2 == 0) ? i : number_of_keys - 1 - i;
+          indices[t][key] = set.insert(key, t).first;
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(set.size(), number_of_keys);
+  std::vector<bool> used(number_of_keys, false);
+  for (std::size_t key = 0; key < number_of_keys; ++key)
+  {
+    const std::size_t index = indices[0][key];
+    BOOST_REQUIRE(index < number_of_keys);
+    BOOST_CHECK(!used[index]);
+    used[index] = true;
+    BOOST_CHECK_EQUAL(set[index], key);
+
+    for (std::size_t t = 1; t < number_of_threads; ++t)
+    {
+      BOOST_CHECK_EQUAL(indices[t][key], index);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_insert_batch)
+{
+  concurrent_indexed_set<std::size_t> set(4);
+  set.insert(3);
+
+  std::vector<std::size_t> keys;
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    keys.push_back(i % 5000);
+  }
+
+  std::vector<std::size_t> indices = set.insert_batch(keys, 4);
+  BOOST_CHECK_EQUAL(set.size(), 5000u);
+  BOOST_CHECK_EQUAL(indices[3], 0u);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(set[indices[i]], keys[i]);
+  }
+}
@@ -38,3 +38,21 @@ BOOST_AUTO_TEST_CASE(test_function_cache)
   }
 
 }
+
+BOOST_AUTO_TEST_CASE(test_fifo_cache)
+{
+  fifo_cache<int, int> cache(4);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    auto result = cache.emplace(i, i*i);
+    BOOST_CHECK(result.second);
+    BOOST_CHECK_EQUAL(result.first->second, i*i);
+    BOOST_CHECK(!cache.emplace(i, 0).second);
+  }
+
+  // Only the most recently inserted elements are kept.
+  BOOST_CHECK(cache.find(0) == cache.end());
+  BOOST_CHECK(cache.find(99) != cache.end());
+  BOOST_CHECK_EQUAL(cache.find(99)->second, 99*99);
+}
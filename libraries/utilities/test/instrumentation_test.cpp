@@ -0,0 +1,76 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/instrumentation.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+static const trace_counter test_counter("test counter");
+
+BOOST_AUTO_TEST_CASE(test_disabled)
+{
+  enable_tracing(false);
+  {
+    trace_span span("disabled span");
+    ++test_counter;
+  }
+
+  std::ostringstream out;
+  write_trace_summary(out);
+  BOOST_CHECK(out.str().find("disabled span") == std::string::npos);
+  BOOST_CHECK_EQUAL(test_counter.total(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  enable_tracing(true);
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([]()
+      {
+        // More spans than fit in the ring buffer of a thread.
+        for (std::size_t i = 0; i < 100000; ++i)
+        {
+          trace_span span("inner \"span\"");
+          test_counter.add(2);
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(test_counter.total(), 800000u);
+
+  std::ostringstream summary;
+  write_trace_summary(summary);
+  BOOST_CHECK(summary.str().find("400000") != std::string::npos);
+  BOOST_CHECK(summary.str().find("800000") != std::string::npos);
+
+  std::ostringstream trace;
+  write_chrome_trace(trace);
+  const std::string json = trace.str();
+  BOOST_CHECK(json.rfind("{\"traceEvents\":[", 0) == 0);
+  BOOST_CHECK(json.find("\"name\":\"inner \\\"span\\\"\",\"ph\":\"X\"") != std::string::npos);
+  BOOST_CHECK(json.find("\"name\":\"test counter\",\"ph\":\"C\"") != std::string::npos);
+
+  // Enabling tracing again discards the recorded spans and counters.
+  enable_tracing(true);
+  BOOST_CHECK_EQUAL(test_counter.total(), 0u);
+  enable_tracing(false);
+}
@@ -0,0 +1,89 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_allocator.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/memory_accounting.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <deque>
+#include <sstream>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+BOOST_AUTO_TEST_CASE(test_parse_memory_size)
+{
+  BOOST_CHECK_EQUAL(parse_memory_size("1000"), 1000u);
+  BOOST_CHECK_EQUAL(parse_memory_size("4K"), 4096u);
+  BOOST_CHECK_EQUAL(parse_memory_size("2m"), 2u * 1024 * 1024);
+  BOOST_CHECK_EQUAL(parse_memory_size("1.5GB"), 3u * 512 * 1024 * 1024);
+  BOOST_CHECK_THROW(parse_memory_size("many"), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(parse_memory_size("4X"), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(parse_memory_size("-1"), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_accounting_allocator)
+{
+  allocation_statistics& statistics = memory_statistics(memory_subsystem::explorer);
+  const std::size_t bytes = statistics.bytes();
+  const std::size_t total = memory_statistics().bytes();
+  {
+    std::vector<int, accounting_allocator<int, memory_subsystem::explorer>> numbers(1000, 1);
+    BOOST_CHECK_EQUAL(statistics.bytes(), bytes + 1000 * sizeof(int));
+    BOOST_CHECK_EQUAL(memory_statistics().bytes(), total + 1000 * sizeof(int));
+
+    // Containers that allocate other types rebind the allocator to the same subsystem.
+    std::deque<double, accounting_allocator<double, memory_subsystem::explorer>> queue(1000, 1.0);
+    BOOST_CHECK(statistics.bytes() >= bytes + 1000 * sizeof(int) + 1000 * sizeof(double));
+  }
+  BOOST_CHECK_EQUAL(statistics.bytes(), bytes);
+  BOOST_CHECK_EQUAL(memory_statistics().bytes(), total);
+}
+
+BOOST_AUTO_TEST_CASE(test_block_allocator_subsystem)
+{
+  const std::size_t bytes = memory_statistics(memory_subsystem::terms).bytes();
+  {
+    block_allocator<std::size_t, 1024, false, memory_subsystem::terms> allocator;
+    std::size_t* element = allocator.allocate(1);
+    BOOST_CHECK(memory_statistics(memory_subsystem::terms).bytes() >= bytes + 1024 * sizeof(std::size_t));
+    allocator.deallocate(element, 1);
+  }
+  BOOST_CHECK_EQUAL(memory_statistics(memory_subsystem::terms).bytes(), bytes);
+}
+
+BOOST_AUTO_TEST_CASE(test_memory_budget)
+{
+  set_memory_budget(memory_statistics().bytes() + 1024 * 1024);
+  BOOST_CHECK(!memory_budget_exceeded());
+  BOOST_CHECK_NO_THROW(check_memory_budget());
+
+  {
+    accounted_memory memory(memory_subsystem::lts);
+    memory.update(1024);
+    BOOST_CHECK(!memory_budget_exceeded());
+
+    memory.update(2 * 1024 * 1024);
+    BOOST_CHECK(memory_budget_exceeded());
+    BOOST_CHECK_THROW(check_memory_budget(), mcrl2::runtime_error);
+
+    std::ostringstream report;
+    write_memory_report(report);
+    BOOST_CHECK(report.str().find("lts") != std::string::npos);
+    BOOST_CHECK(report.str().find("budget") != std::string::npos);
+  }
+  BOOST_CHECK_EQUAL(memory_statistics(memory_subsystem::lts).bytes(), 0u);
+
+  // Removing the budget also clears the exceeded flag.
+  set_memory_budget(0);
+  BOOST_CHECK(!memory_budget_exceeded());
+  BOOST_CHECK_EQUAL(memory_budget(), 0u);
+}
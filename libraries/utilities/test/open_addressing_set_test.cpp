@@ -0,0 +1,203 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/open_addressing_set.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <random>
+#include <thread>
+#include <unordered_set>
+
+using namespace mcrl2::utilities;
+
+template<typename T>
+open_addressing_set<T> construct(std::initializer_list<T> list)
+{
+  open_addressing_set<T> set;
+
+  for (auto& element : list)
+  {
+    set.emplace(element);
+  }
+
+  return set;
+}
+
+BOOST_AUTO_TEST_CASE(test_small)
+{
+  // Test with inserting 5, 3, 2, 5 expected { 2,3,5 }
+  open_addressing_set<int> set = construct({5,3,2,5});
+
+  BOOST_CHECK(set.find(5) != set.end());
+  BOOST_CHECK(set.find(2) != set.end());
+  BOOST_CHECK(set.find(3) != set.end());
+  BOOST_CHECK(set.find(4) == set.end());
+
+  BOOST_CHECK(set.count(5) != 0);
+  BOOST_CHECK(set.count(4) == 0);
+
+  BOOST_CHECK(set.size() == 3);
+  BOOST_CHECK(!set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_large)
+{
+  // Test inserting and erasing a large number of elements (tests resize behaviour and erased slots).
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(1,10000);
+
+  open_addressing_set<int> test;
+
+  // Here, we assume that the standard library implementation is correct.
+  std::unordered_set<int> correct;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    int value = dist(rng);
+    if (i % 3 == 0)
+    {
+      test.erase(value);
+      correct.erase(value);
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(test.emplace(value).second, correct.emplace(value).second);
+    }
+  }
+
+  for (int value : correct)
+  {
+    BOOST_CHECK(test.find(value) != test.end());
+  }
+
+  BOOST_CHECK_EQUAL(test.size(), correct.size());
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(test.begin(), test.end())), correct.size());
+
+  for (int value : test)
+  {
+    BOOST_CHECK(correct.find(value) != correct.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_erase_iterate)
+{
+  // Erase all even elements while iterating.
+  open_addressing_set<int> set;
+  for (int i = 0; i < 1000; ++i)
+  {
+    set.emplace(i);
+  }
+
+  for (auto it = set.begin(); it != set.end(); )
+  {
+    it = (*it % 2 == 0) ? set.erase(it) : std::next(it);
+  }
+
+  BOOST_CHECK_EQUAL(set.size(), 500u);
+  for (int i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK_EQUAL(set.count(i), static_cast<std::size_t>(i % 2));
+  }
+
+  // Cleaning up the erased slots keeps the remaining elements.
+  set.rehash(0);
+  BOOST_CHECK_EQUAL(set.used_slots(), 500u);
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(set.begin(), set.end())), 500u);
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_move)
+{
+  open_addressing_set<int> set = construct({5,3,2,5});
+
+  open_addressing_set<int> copy(set);
+  set.clear();
+  BOOST_CHECK(set.empty());
+
+  BOOST_CHECK(copy.find(5) != copy.end());
+  BOOST_CHECK(copy.find(2) != copy.end());
+  BOOST_CHECK(copy.find(3) != copy.end());
+
+  open_addressing_set<int> moved = std::move(copy);
+  BOOST_CHECK_EQUAL(moved.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+  open_addressing_set<int> set(0);
+
+  BOOST_CHECK(set.empty());
+  BOOST_CHECK(set.size() == 0);
+  BOOST_CHECK(set.begin() == set.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_overflow)
+{
+  // Without automatic resizing the elements that do not fit are stored in the overflow table.
+  open_addressing_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, false> set(10);
+  for (int i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(set.emplace(i).second);
+    BOOST_CHECK(!set.emplace(i).second);
+  }
+
+  BOOST_CHECK_EQUAL(set.size(), 1000u);
+  BOOST_CHECK(set.overflow_size() > 0);
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(set.begin(), set.end())), 1000u);
+
+  // The overflowing elements are moved into the table.
+  set.rehash_if_needed();
+  BOOST_CHECK_EQUAL(set.overflow_size(), 0u);
+  for (int i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(set.find(i) != set.end());
+  }
+}
+
+#ifdef MCRL2_THREAD_SAFE
+BOOST_AUTO_TEST_CASE(test_concurrent_emplace)
+{
+  // Insert overlapping ranges concurrently into a table that is too small, every element must be inserted once.
+  using set_type = open_addressing_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, true, false>;
+  set_type set(1000);
+
+  constexpr int number_of_threads = 4;
+  constexpr int number_of_elements = 20000;
+  constexpr int multipliers[number_of_threads] = {1, 3, 7, 9};
+  std::vector<std::size_t> inserted(number_of_threads, 0);
+  std::vector<std::size_t> wrong(number_of_threads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (int i = 0; i < number_of_elements; ++i)
+      {
+        // Every thread inserts the same elements in a different order.
+        int value = (i * multipliers[t]) % number_of_elements;
+        auto [it, added] = set.emplace(value);
+        wrong[t] += *it != value;
+        inserted[t] += added;
+      }
+    });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(wrong[0] + wrong[1] + wrong[2] + wrong[3], 0u);
+  BOOST_CHECK_EQUAL(inserted[0] + inserted[1] + inserted[2] + inserted[3], static_cast<std::size_t>(number_of_elements));
+  BOOST_CHECK_EQUAL(set.size(), static_cast<std::size_t>(number_of_elements));
+
+  set.rehash_if_needed();
+  BOOST_CHECK_EQUAL(set.overflow_size(), 0u);
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(std::distance(set.begin(), set.end())), static_cast<std::size_t>(number_of_elements));
+}
+#endif
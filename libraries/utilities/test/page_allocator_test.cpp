@@ -0,0 +1,150 @@
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_allocator.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/page_allocator.h"
+#include "mcrl2/utilities/unordered_set.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstring>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+/// \brief Enables the given page settings for the duration of a test case.
+struct page_settings
+{
+  page_settings(huge_page_mode mode, bool numa)
+  {
+    set_huge_page_mode(mode);
+    set_numa_aware(numa);
+  }
+
+  ~page_settings()
+  {
+    set_huge_page_mode(huge_page_mode::none);
+    set_numa_aware(false);
+  }
+};
+
+BOOST_AUTO_TEST_CASE(test_parse_huge_page_mode)
+{
+  BOOST_CHECK(parse_huge_page_mode("none") == huge_page_mode::none);
+  BOOST_CHECK(parse_huge_page_mode("transparent") == huge_page_mode::transparent);
+  BOOST_CHECK(parse_huge_page_mode("explicit") == huge_page_mode::explicit_);
+  BOOST_CHECK_THROW(parse_huge_page_mode("large"), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_allocate_pages)
+{
+  for (huge_page_mode mode : { huge_page_mode::none, huge_page_mode::transparent, huge_page_mode::explicit_ })
+  {
+    page_settings settings(mode, true);
+
+    allocation_statistics statistics;
+    void* pointer = allocate_pages(3 * huge_page_size + 1, numa_placement::interleaved, statistics);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(pointer) % 4096, 0u);
+    BOOST_CHECK_EQUAL(statistics.mapped_bytes(), 4 * huge_page_size);
+
+    // The whole region must be writable.
+    std::memset(pointer, 1, 3 * huge_page_size + 1);
+
+    int local = 0;
+    BOOST_CHECK(!deallocate_pages(&local, statistics));
+    BOOST_CHECK(deallocate_pages(pointer, statistics));
+    BOOST_CHECK_EQUAL(statistics.mapped_bytes(), 0u);
+    BOOST_CHECK_EQUAL(statistics.huge_page_bytes(), 0u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_memory_pool)
+{
+  page_settings settings(huge_page_mode::transparent, true);
+
+  // Blocks of 128 KiB, so that multiple blocks share a chunk.
+  block_allocator<std::size_t, 16384> allocator;
+
+  std::vector<std::size_t*> elements;
+  for (std::size_t i = 0; i < 7 * 16384; ++i)
+  {
+    std::size_t* element = allocator.allocate(1);
+    *element = i;
+    elements.push_back(element);
+  }
+
+  for (std::size_t i = 0; i < elements.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(*elements[i], i);
+  }
+
+  BOOST_CHECK_EQUAL(allocator.statistics().allocations(), 7u);
+  BOOST_CHECK(allocator.statistics().mapped_bytes() >= huge_page_size);
+
+  // All blocks are freed again, which also returns the chunks.
+  for (std::size_t* element : elements)
+  {
+    allocator.deallocate(element, 1);
+  }
+
+  BOOST_CHECK_EQUAL(allocator.consolidate(), 7u);
+  BOOST_CHECK_EQUAL(allocator.statistics().allocations(), 0u);
+  BOOST_CHECK(allocator.statistics().mapped_bytes() <= huge_page_size);
+}
+
+BOOST_AUTO_TEST_CASE(test_switch_at_runtime)
+{
+  // Blocks allocated before and after enabling huge pages are freed correctly.
+  block_allocator<std::size_t, 1024> allocator;
+  std::vector<std::size_t*> elements;
+  for (std::size_t i = 0; i < 4096; ++i)
+  {
+    elements.push_back(allocator.allocate(1));
+  }
+
+  {
+    page_settings settings(huge_page_mode::transparent, false);
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+      elements.push_back(allocator.allocate(1));
+    }
+  }
+
+  for (std::size_t* element : elements)
+  {
+    allocator.deallocate(element, 1);
+  }
+
+  BOOST_CHECK_EQUAL(allocator.consolidate(), 8u);
+  BOOST_CHECK_EQUAL(allocator.statistics().bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_table)
+{
+  page_settings settings(huge_page_mode::transparent, true);
+
+  // The buckets of a large table are allocated in pages.
+  std::size_t mapped = hash_table_allocation_statistics().mapped_bytes();
+  {
+    unordered_set<std::size_t> set;
+    for (std::size_t i = 0; i < 1000000; ++i)
+    {
+      set.emplace(i);
+    }
+
+    BOOST_CHECK(hash_table_allocation_statistics().mapped_bytes() > mapped);
+    for (std::size_t i = 0; i < 1000000; ++i)
+    {
+      BOOST_CHECK(set.find(i) != set.end());
+    }
+  }
+
+  BOOST_CHECK_EQUAL(hash_table_allocation_statistics().mapped_bytes(), mapped);
+}
@@ -89,19 +89,23 @@ public:
     {
       return find_result->second;
     }
-    bool result = std::any_of(equation().summands().cbegin(), equation().summands().cend(), [&](const pbes_system::detail::ppg_summand& summ)
+    // The satisfiability of the transition conditions of all summands is checked in one batch
+    std::vector<std::pair<variable_list, data_expression>> queries;
+    for(const pbes_system::detail::ppg_summand& summ: equation().summands())
+    {
+      if(summ.new_state().name() == other.m_var.name())
       {
-        return summ.new_state().name() == other.m_var.name() &&
-          m_dm.is_satisfiable(m_var.parameters() + summ.quantification_domain(),
-            m_dm.rewr(sort_bool::and_(
-              make_application(m_char_func, m_var.parameters()),
-              sort_bool::and_(
-                summ.condition(),
-                make_application(other.m_char_func, summ.new_state().parameters())
-              )
-            ))
-          );
-      });
+        queries.emplace_back(m_var.parameters() + summ.quantification_domain(),
+          m_dm.rewr(sort_bool::and_(
+            make_application(m_char_func, m_var.parameters()),
+            sort_bool::and_(
+              summ.condition(),
+              make_application(other.m_char_func, summ.new_state().parameters())
+            )
+          )));
+      }
+    }
+    bool result = m_dm.is_any_satisfiable(queries);
     m_cache->insert_transition(*this, other, result);
     return result;
   }
@@ -64,7 +64,47 @@ struct data_manipulators
     catch(const smt::translation_error&)
     {}
 
-    // The SMT solver failed, so we fallback to the rewriter
+    return is_satisfiable_by_rewriting(vars, expr);
+  }
+
+  /// \brief Returns true if the expression of at least one of the queries is satisfiable, where each query consists
+  ///        of the free variables and the expression. All queries are sent to the SMT solver in one batch.
+  bool is_any_satisfiable(const std::vector<std::pair<variable_list, data_expression>>& queries) const
+  {
+    if(queries.empty())
+    {
+      return false;
+    }
+
+    std::vector<smt::answer> answers;
+    try
+    {
+      answers = smt_solver->solve_all(queries);
+    }
+    catch(const smt::translation_error&)
+    {
+      // Some query cannot be translated, so every query is considered separately
+      return std::any_of(queries.begin(), queries.end(), [this](const auto& q){ return is_satisfiable(q.first, q.second); });
+    }
+
+    if(std::find(answers.begin(), answers.end(), smt::answer::SAT) != answers.end())
+    {
+      return true;
+    }
+    for(std::size_t i = 0; i < queries.size(); ++i)
+    {
+      if(answers[i] == smt::answer::UNKNOWN && is_satisfiable_by_rewriting(queries[i].first, queries[i].second))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+protected:
+  // Fallback for when the SMT solver fails
+  bool is_satisfiable_by_rewriting(const variable_list& vars, const data_expression& expr) const
+  {
     data_expression is_sat = make_abstraction(exists_binder(), vars, expr);
     is_sat = rewr(one_point_rule_rewrite(quantifiers_inside_rewrite(is_sat)));
     if(contains_reals)
@@ -12,6 +12,7 @@
 #include "mcrl2/lps/io.h"
 #include "mcrl2/lps/confluence_checker.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/data/prover_tool.h"
 
@@ -27,6 +28,7 @@ using namespace mcrl2::log;
 
 using mcrl2::data::tools::rewriter_tool;
 using mcrl2::data::tools::prover_tool;
+using mcrl2::utilities::tools::parallel_tool;
 
 /// \mainpage lpsconfcheck
 /// \section section_introduction Introduction
@@ -38,11 +40,11 @@ using mcrl2::data::tools::prover_tool;
 /// \brief tau-summands of an LPS are confluent. The tau-actions of all confluent tau-summands are
 /// \brief renamed to ctau
 
-class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
+class lpsconfcheck_tool : public parallel_tool< prover_tool< rewriter_tool<input_output_tool> > >
 {
   protected:
 
-    typedef prover_tool< rewriter_tool<input_output_tool> > super;
+    typedef parallel_tool< prover_tool< rewriter_tool<input_output_tool> > > super;
 
     /// \brief The name of a file containing an invariant that is used to check confluence.
     /// \brief If this string is 0, the constant true is used as invariant.
@@ -212,6 +214,7 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
       mCRL2log(verbose) << "  input file:         " << m_input_filename << std::endl;
       mCRL2log(verbose) << "  output file:        " << m_output_filename << std::endl;
       mCRL2log(verbose) << "  data rewriter:      " << m_rewrite_strategy << std::endl;
+      mCRL2log(verbose) << "  threads:            " << number_of_threads() << std::endl;
 
       stochastic_specification spec;
       load_lps(spec, input_filename());
@@ -232,13 +235,16 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
         instream.close();
       }
 
-      if (check_invariant(spec))
+      // The caches of the provers are shared by the invariant checker and the confluence checker.
+      std::shared_ptr<data::detail::BDD_Prover_Cache> prover_cache = std::make_shared<data::detail::BDD_Prover_Cache>(prover_cache_size());
+
+      if (check_invariant(spec, prover_cache))
       {
         Confluence_Checker<stochastic_specification> v_confluence_checker(
           spec, rewrite_strategy(),
           m_time_limit, m_path_eliminator, solver_type(),
           m_apply_induction, m_check_all, m_no_sums, m_conditions,
-          m_counter_example, m_generate_invariants, m_dot_file_name);
+          m_counter_example, m_generate_invariants, m_dot_file_name, number_of_threads(), prover_cache);
 
         v_confluence_checker.check_confluence_and_mark(m_invariant, m_summand_number);
         save_lps(spec, output_filename());
@@ -253,13 +259,13 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
     /// m_invariant_filename differs from 0.
     /// \return true, if the invariant holds or no invariant is specified.
     ///         false, if the invariant does not hold.
-    bool check_invariant(stochastic_specification const& spec) const
+    bool check_invariant(stochastic_specification const& spec, const std::shared_ptr<data::detail::BDD_Prover_Cache>& prover_cache) const
     {
       if (!m_invariant_filename.empty())
       {
         if (!m_no_check)
         {
-          Invariant_Checker<stochastic_specification> v_invariant_checker(spec, rewrite_strategy(), m_time_limit, m_path_eliminator, solver_type(), false, false, false, m_dot_file_name);
+          Invariant_Checker<stochastic_specification> v_invariant_checker(spec, rewrite_strategy(), m_time_limit, m_path_eliminator, solver_type(), false, false, false, m_dot_file_name, prover_cache);
 
           return v_invariant_checker.check_invariant(m_invariant);
         }
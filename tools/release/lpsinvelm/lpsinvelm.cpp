@@ -186,7 +186,8 @@ class lpsinvelm_tool : public prover_tool< rewriter_tool<input_output_tool> >
                             m_counter_example,
                             m_path_eliminator,
                             m_apply_induction,
-                            m_time_limit);
+                            m_time_limit,
+                            prover_cache_size());
     }
 };
 
@@ -8,6 +8,7 @@
 /// \brief Tool for rewriting a linear process specification.
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/lps/lps_rewriter_tool.h"
 #include "mcrl2/lps/tools.h"
@@ -16,13 +17,14 @@ using namespace mcrl2;
 using namespace mcrl2::log;
 using namespace mcrl2::utilities;
 using mcrl2::utilities::tools::input_output_tool;
+using mcrl2::utilities::tools::parallel_tool;
 using mcrl2::data::tools::rewriter_tool;
 using lps::tools::lps_rewriter_tool;
 
-class lps_rewriter : public lps_rewriter_tool<rewriter_tool< input_output_tool > >
+class lps_rewriter : public parallel_tool<lps_rewriter_tool<rewriter_tool< input_output_tool > > >
 {
   protected:
-    typedef lps_rewriter_tool<rewriter_tool< input_output_tool > > super;
+    typedef parallel_tool<lps_rewriter_tool<rewriter_tool< input_output_tool > > > super;
 
   public:
     lps_rewriter()
@@ -44,12 +46,14 @@ class lps_rewriter : public lps_rewriter_tool<rewriter_tool< input_output_tool >
       mCRL2log(verbose) << "  input file:         " << m_input_filename << std::endl;
       mCRL2log(verbose) << "  output file:        " << m_output_filename << std::endl;
       mCRL2log(verbose) << "  lps rewriter:       " << m_lps_rewriter_type << std::endl;
+      mCRL2log(verbose) << "  threads:            " << number_of_threads() << std::endl;
 
 
       lps::lpsrewr(input_filename(),
                    output_filename(),
                    rewrite_strategy(),
-                   rewriter_type()
+                   rewriter_type(),
+                   number_of_threads()
                  );
       return true;
     }
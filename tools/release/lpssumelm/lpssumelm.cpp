@@ -11,6 +11,7 @@
 #include "mcrl2/lps/tools.h"
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 using namespace mcrl2;
 using namespace mcrl2::utilities;
@@ -18,11 +19,11 @@ using namespace mcrl2::utilities::tools;
 using namespace mcrl2::core;
 using namespace mcrl2::log;
 
-class sumelm_tool: public input_output_tool
+class sumelm_tool: public parallel_tool<input_output_tool>
 {
   protected:
 
-    typedef input_output_tool super;
+    typedef parallel_tool<input_output_tool> super;
     bool m_decluster;
 
     void add_options(interface_description& desc)
@@ -54,7 +55,7 @@ class sumelm_tool: public input_output_tool
     ///applies sum elimination to it and writes the result to output_file.
     bool run()
     {
-      mcrl2::lps::lpssumelm(m_input_filename, m_output_filename, m_decluster);
+      mcrl2::lps::lpssumelm(m_input_filename, m_output_filename, m_decluster, number_of_threads());
       return true;
     }
 
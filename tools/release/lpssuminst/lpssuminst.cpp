@@ -11,6 +11,7 @@
 #include "mcrl2/lps/tools.h"
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 
 using namespace mcrl2::utilities;
@@ -18,11 +19,11 @@ using namespace mcrl2::utilities::tools;
 
 using mcrl2::data::tools::rewriter_tool;
 
-class suminst_tool: public rewriter_tool<input_output_tool>
+class suminst_tool: public parallel_tool<rewriter_tool<input_output_tool>>
 {
   protected:
 
-    typedef rewriter_tool<input_output_tool> super;
+    typedef parallel_tool<rewriter_tool<input_output_tool>> super;
 
     bool m_tau_summands_only;
     bool m_finite_sorts_only;
@@ -78,7 +79,8 @@ class suminst_tool: public rewriter_tool<input_output_tool>
                              rewrite_strategy(),
                              m_sorts_string,
                              m_finite_sorts_only,
-                             m_tau_summands_only);
+                             m_tau_summands_only,
+                             number_of_threads());
       return true;
     }
 };
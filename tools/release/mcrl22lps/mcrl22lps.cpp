@@ -16,17 +16,19 @@
 #include "mcrl2/lps/io.h"
 #include "mcrl2/lps/linearise.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 
 // #include "gc.h"  Required for ad hoc garbage collection. This is possible with ATcollect,
 // useful to find garbage collection problems.
 
 using mcrl2::utilities::tools::input_output_tool;
+using mcrl2::utilities::tools::parallel_tool;
 using mcrl2::data::tools::rewriter_tool;
 
-class mcrl22lps_tool : public rewriter_tool< input_output_tool >
+class mcrl22lps_tool : public parallel_tool< rewriter_tool< input_output_tool > >
 {
-    typedef rewriter_tool< input_output_tool > super;
+    typedef parallel_tool< rewriter_tool< input_output_tool > > super;
 
   private:
     mcrl2::lps::t_lin_options m_linearisation_options;
@@ -179,7 +181,7 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
       {
         //parse specification from stdin
         mCRL2log(mcrl2::log::verbose) << "Reading input from stdin..." << std::endl;
-        spec = mcrl2::process::parse_process_specification(std::cin);
+        spec = mcrl2::process::parse_process_specification(std::cin, number_of_threads());
       }
       else
       {
@@ -191,7 +193,7 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
         {
           throw mcrl2::runtime_error("Cannot open input file: " + input_filename() + ".");
         }
-        spec = mcrl2::process::parse_process_specification(instream);
+        spec = mcrl2::process::parse_process_specification(instream, number_of_threads());
         instream.close();
       }
       //report on well-formedness (if needed)
@@ -217,7 +219,9 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
 
 
       //store the result
+      timer().start("linearisation");
       mcrl2::lps::stochastic_specification linear_spec(mcrl2::lps::linearise(spec, m_linearisation_options));
+      timer().finish("linearisation");
       mCRL2log(mcrl2::log::verbose) << "Writing LPS to "
                                     << (output_filename().empty() ? "stdout"
                                                                   : "file " + output_filename())
@@ -16,6 +16,7 @@
 #include "mcrl2/bes/pg_parse.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/pbes/detail/bes_equation_limit.h"
+#include "mcrl2/pbes/pg_binary_io.h"
 #include "mcrl2/pg/pbespgsolve.h"
 #include "mcrl2/utilities/input_tool.h"
 
@@ -64,6 +65,22 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
                              'l');
     }
 
+    std::set<utilities::file_format> available_input_formats() const
+    {
+      std::set<utilities::file_format> result = super::available_input_formats();
+      result.insert(pbes_system::pg_format_binary());
+      return result;
+    }
+
+    utilities::file_format default_input_format() const
+    {
+      if (pbes_system::pg_format_binary().matches(input_filename()))
+      {
+        return pbes_system::pg_format_binary();
+      }
+      return super::default_input_format();
+    }
+
     void parse_options(const command_line_parser& parser)
     {
       super::parse_options(parser);
@@ -87,7 +104,8 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
         "pbespgsolve",
         "Maks Verver and Wieger Wesselink; Michael Weber",
         "Solve a (P)BES or parity game using a parity game solver",
-        "Reads a file containing a (P)BES or a max-parity game in PGSolver format. "
+        "Reads a file containing a (P)BES, a max-parity game in PGSolver format, "
+        "or a parity game in binary format (as written by pbessolve --export-pg). "
         "A PBES input is first instantiated to a BES; from which a parity game "
         "can be obtained. A parity game solver is then used to solve this parity game. "
         "The solution of the first vertex, which also defines the solution of initial equation of the (P)BES, is printed to standard output. "
@@ -121,6 +139,21 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
 
         value = algorithm.run(pg, 0);
       }
+      else if (pbes_input_format() == pbes_system::pg_format_binary())
+      {
+        if (input_filename().empty())
+        {
+          throw mcrl2::runtime_error("A parity game in binary format cannot be read from standard input.");
+        }
+        pbespgsolve_algorithm algorithm(timer(), m_options);
+        ParityGame pg;
+        verti goal_vertex;
+        timer().start("load");
+        pg.read_binary(input_filename(), &goal_vertex);
+        timer().finish("load");
+
+        value = algorithm.run(pg, goal_vertex);
+      }
       else
       {
         pbes p;
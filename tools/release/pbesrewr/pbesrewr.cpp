@@ -10,6 +10,7 @@
 
 #include "mcrl2/pbes/tools.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/bes/pbes_rewriter_tool.h"
 #include "mcrl2/bes/pbes_input_tool.h"
@@ -25,10 +26,10 @@ using bes::tools::pbes_rewriter_tool;
 using data::tools::rewriter_tool;
 using utilities::tools::input_output_tool;
 
-class pbes_rewriter : public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool<rewriter_tool<input_output_tool> > > >
+class pbes_rewriter : public parallel_tool<pbes_input_tool<pbes_output_tool<pbes_rewriter_tool<rewriter_tool<input_output_tool> > > > >
 {
   protected:
-    typedef pbes_input_tool<pbes_output_tool<pbes_rewriter_tool<rewriter_tool<input_output_tool> > > > super;
+    typedef parallel_tool<pbes_input_tool<pbes_output_tool<pbes_rewriter_tool<rewriter_tool<input_output_tool> > > > > super;
 
     /// \brief Returns the types of rewriters that are available for this tool.
     std::set<pbes_system::pbes_rewriter_type> available_rewriters() const override
@@ -58,13 +59,15 @@ class pbes_rewriter : public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool
       mCRL2log(verbose) << "  input file:         " << m_input_filename << std::endl;
       mCRL2log(verbose) << "  output file:        " << m_output_filename << std::endl;
       mCRL2log(verbose) << "  pbes rewriter:      " << m_pbes_rewriter_type << std::endl;
+      mCRL2log(verbose) << "  threads:            " << number_of_threads() << std::endl;
 
       pbes_system::pbesrewr(input_filename(),
                             output_filename(),
                             pbes_input_format(),
                             pbes_output_format(),
                             rewrite_strategy(),
-                            rewriter_type()
+                            rewriter_type(),
+                            number_of_threads()
                            );
       return true;
     }
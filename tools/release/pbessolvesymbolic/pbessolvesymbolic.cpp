@@ -137,6 +137,8 @@ class pbessolvesymbolic_tool: public rewriter_tool<input_output_tool>
   protected:
     pbes_system::symbolic_reachability_options options;
 
+    std::string resume_file; // a checkpoint from which the exploration is continued
+
     // Lace options
     std::size_t lace_n_workers = 1;
     std::size_t lace_dqsize = 1024*1024*4; // set large default
@@ -165,10 +167,18 @@ class pbessolvesymbolic_tool: public rewriter_tool<input_output_tool>
       desc.add_option("reorder", utilities::make_optional_argument("ORDER", "none"),
                       "'none' (default) no variable reordering\n"
                       "'random' variables are put in a random order\n"
+                      "'cuthill-mckee' variables are ordered by the Cuthill-McKee algorithm on the read/write dependencies\n"
+                      "'sloan' variables are ordered by Sloan's profile reduction algorithm on the read/write dependencies\n"
+                      "'force' variables are ordered by the FORCE heuristic on the read/write dependencies\n"
+                      "'auto' the order among 'none', 'cuthill-mckee', 'sloan' and 'force' with the smallest LDDs after the first iterations is chosen\n"
                       "'a user defined permutation e.g. '1 3 2 0 4'"
       );
       desc.add_option("info", "print read/write information of the summands");
       desc.add_option("max-iterations", utilities::make_optional_argument("NUM", "0"), "limit number of breadth-first iterations to NUM");
+      desc.add_option("checkpoint", utilities::make_optional_argument("FILE", ""), "save the state of the exploration (visited states, learned transitions and data indices) to FILE when the exploration stops, such that it can be continued with --resume");
+      desc.add_option("checkpoint-interval", utilities::make_optional_argument("NUM", "0"), "also save the checkpoint after every NUM breadth-first iterations (default 0, i.e. only at the end)");
+      desc.add_option("resume", utilities::make_optional_argument("FILE", ""), "continue the exploration from the checkpoint in FILE, which must have been created for the same input and options; --max-iterations then limits the total number of iterations");
+      desc.add_option("reorder-iterations", utilities::make_optional_argument("NUM", "5"), "the number of breadth-first iterations that is used to evaluate the candidates of --reorder=auto (default 5)");
       desc.add_option("print-nodesize", "print the number of LDD nodes in addition to the number of elements represented as 'elements[nodes]'");
       desc.add_option("saturation", "reduce the amount of breadth-first iterations by applying the transition groups until fixed point");
       desc.add_option("solve-strategy",
@@ -280,6 +290,16 @@ class pbessolvesymbolic_tool: public rewriter_tool<input_output_tool>
       {
         options.max_iterations = parser.option_argument_as<std::size_t>("max-iterations");
       }
+      options.checkpoint_file = parser.option_argument("checkpoint");
+      if (parser.has_option("checkpoint-interval"))
+      {
+        options.checkpoint_interval = parser.option_argument_as<std::size_t>("checkpoint-interval");
+      }
+      resume_file = parser.option_argument("resume");
+      if (parser.has_option("reorder-iterations"))
+      {
+        options.reorder_iterations = parser.option_argument_as<std::size_t>("reorder-iterations");
+      }
     }
 
   public:
@@ -304,6 +324,13 @@ class pbessolvesymbolic_tool: public rewriter_tool<input_output_tool>
       }
       else
       {
+        if (!resume_file.empty())
+        {
+          symbolic::exploration_checkpoint checkpoint;
+          symbolic::load_exploration_checkpoint(resume_file, checkpoint);
+          reach.load_checkpoint(checkpoint);
+        }
+
         timer().start("instantiation");
         ldd V = reach.run();
         timer().finish("instantiation");
@@ -360,6 +387,11 @@ class pbessolvesymbolic_tool: public rewriter_tool<input_output_tool>
 
       else
       {
+        if (options.variable_order == "auto")
+        {
+          options.variable_order = symbolic::select_variable_order<pbes_system::pbesreach_algorithm>(pbesspec, options);
+        }
+
         if (options.solve_strategy == 0)
         {
           pbes_system::pbesreach_algorithm reach(pbesspec, options);